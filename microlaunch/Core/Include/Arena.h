@@ -0,0 +1,44 @@
+#ifndef H_ARENA
+#define H_ARENA
+
+#include <stddef.h>
+
+//Advance declaration
+struct sDescription;
+
+/**
+ * @brief struct sArena keeps one slot per vector, allocated once for the largest configuration of the sweep
+ */
+typedef struct sArena
+{
+	unsigned nbVectors;		/**< @brief Number of slots */
+	void **bases;			/**< @brief Pointers returned by the allocation library */
+	char **starts;			/**< @brief Page aligned start of each slot */
+	size_t *capacities;		/**< @brief Usable size of each slot, from its start */
+} SArena;
+
+/**
+ * @brief Allocates and prefaults a slot per vector with the allocation library, big enough for every vector size, stride and alignment of the sweep
+ * @param desc the SDescription of the run (the allocation library has to be initialized)
+ * @return the arena, NULL if there is no vector or an allocation failed
+ */
+SArena *Arena_create (struct sDescription *desc);
+
+/**
+ * @brief Gives the view of a vector for an alignment
+ * @param arena the arena
+ * @param no the vector number
+ * @param alignment the offset of the vector from the start of a page
+ * @param size the size of the vector, in octets
+ * @return the vector, inside the slot of the vector
+ */
+void *Arena_getView (SArena *arena, unsigned no, int alignment, size_t size);
+
+/**
+ * @brief Gives the slots back to the allocation library and frees the arena
+ * @param arena the arena (can be NULL)
+ * @param desc the SDescription of the run
+ */
+void Arena_destroy (SArena *arena, struct sDescription *desc);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef H_AUDIT
+#define H_AUDIT
+
+#include <stdint.h>
+
+/* Events counted inside the measurement window by --audit */
+enum AuditEvents { AUDIT_CONTEXT_SWITCHES = 0, AUDIT_PAGE_FAULTS, AUDIT_SYSCALLS, AUDIT_NB_EVENTS };
+
+/* Number of empty windows measured to find the cost of the audit itself */
+#define AUDIT_CALIBRATION_RUNS 8
+
+/**
+ * @brief struct sAudit holds the perf software events counting what happens inside the measurement window
+ */
+typedef struct sAudit
+{
+	int fds[AUDIT_NB_EVENTS];			/**< @brief perf file descriptor of each event (-1 if the event is not available) */
+	int leader;							/**< @brief perf file descriptor of the group leader, read for the whole group */
+	int position[AUDIT_NB_EVENTS];		/**< @brief Position of each event in a group read (-1 if the event is not available) */
+	unsigned nbOpened;					/**< @brief Number of events in the group */
+	uint64_t start[AUDIT_NB_EVENTS];	/**< @brief Value of each event at the start of the window */
+	uint64_t baseline[AUDIT_NB_EVENTS];	/**< @brief Count of an empty window, which is the audit itself (the read of the group) */
+} SAudit;
+
+/**
+ * @brief Opens the audit events on the calling process
+ * @return the audit, NULL if no event can be counted (the unavailable ones are reported as -1)
+ */
+SAudit *Audit_create (void);
+
+/**
+ * @brief Measures the baseline removed from each window: the least count over AUDIT_CALIBRATION_RUNS windows around a function
+ * @param audit the audit
+ * @param window what the measurement window holds besides the measured code, NULL for the read of the group only
+ * @param data the argument of the function
+ */
+void Audit_calibrate (SAudit *audit, void (*window) (void *), void *data);
+
+/**
+ * @brief Closes the audit events
+ * @param audit the audit (can be NULL)
+ */
+void Audit_destroy (SAudit *audit);
+
+/**
+ * @brief Reads the events at the start of the measurement window
+ * @param audit the audit
+ */
+void Audit_start (SAudit *audit);
+
+/**
+ * @brief Reads the events at the end of the measurement window
+ * @param audit the audit
+ * @param counts filled with the count of each event inside the window, AUDIT_NB_EVENTS values (-1 if the event is not available)
+ */
+void Audit_stop (SAudit *audit, double *counts);
+
+/**
+ * @brief Gives the CSV column name of an audit event
+ * @param event the event (see AuditEvents)
+ * @return the column name
+ */
+const char *Audit_getEventName (unsigned event);
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef H_BARRIER
+#define H_BARRIER
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/* Cycles between the release decision and the release itself in spin mode:
+	long enough for every spinning process to see the deadline before it is reached */
+#define BARRIER_SPIN_DELAY 100000
+
+/* Milliseconds between two checks of the benchmark processes while the father waits on the futex */
+#define BARRIER_CHECK_PERIOD 100
+
+/**
+ * @brief Synchronisation used between the benchmark processes and the father
+ */
+typedef enum eBarrierMode
+{
+	BARRIER_FUTEX = 0,	/**< @brief Shared counters, sleeping on futexes */
+	BARRIER_SPIN,		/**< @brief Shared counters, the processes spin until a common TSC deadline */
+	BARRIER_PIPE		/**< @brief One pipe write and read per process and direction */
+} EBarrierMode;
+
+/**
+ * @brief Release time of a process, as seen by itself
+ */
+typedef struct sBarrierSlot
+{
+	volatile uint64_t release;		/**< @brief TSC value read when leaving the barrier */
+	volatile uint32_t generation;	/**< @brief Generation the release value belongs to */
+	pid_t pid;						/**< @brief The benchmark process (0 if unknown) */
+	uint32_t padding[12];			/**< @brief One cache line per process */
+} SBarrierSlot;
+
+/**
+ * @brief struct sBarrier lives in a shared anonymous mapping, created by the father before the benchmark processes
+ */
+typedef struct sBarrier
+{
+	volatile uint32_t arrived;		/**< @brief Number of processes waiting in the current generation (futex word) */
+	uint32_t padding1[15];
+	volatile uint32_t generation;	/**< @brief Incremented by the father to release the processes (futex word) */
+	uint32_t padding2[1];
+	volatile uint64_t deadline;		/**< @brief Release TSC value in spin mode */
+	volatile uint32_t aborted;		/**< @brief Set by the father once a benchmark process died, the others leave */
+	uint32_t padding3[11];
+	int mode;						/**< @brief The EBarrierMode */
+	unsigned nbProcess;				/**< @brief Number of benchmark processes */
+	uint32_t padding4[14];
+	SBarrierSlot slots[];			/**< @brief One slot per benchmark process */
+} SBarrier;
+
+/**
+ * @brief Creates the barrier, to be called before the benchmark processes are forked
+ * @param mode the EBarrierMode (no shared memory is needed for BARRIER_PIPE)
+ * @param nbProcess the number of benchmark processes
+ * @return the barrier, NULL in pipe mode
+ */
+SBarrier *Barrier_create (int mode, unsigned nbProcess);
+
+/**
+ * @brief Releases the barrier
+ * @param barrier the barrier (can be NULL)
+ */
+void Barrier_destroy (SBarrier *barrier);
+
+/**
+ * @brief Records a benchmark process, for the father to notice if it dies before arriving
+ * @param barrier the barrier (can be NULL)
+ * @param processId the id of the benchmark process
+ * @param pid the benchmark process
+ */
+void Barrier_setProcess (SBarrier *barrier, unsigned processId, pid_t pid);
+
+/**
+ * @brief Benchmark process side: waits for every process to arrive and for the father to release them, exits if the barrier is aborted
+ * @param barrier the barrier
+ * @param processId the id of the calling benchmark process
+ */
+void Barrier_child (SBarrier *barrier, unsigned processId);
+
+/**
+ * @brief Father side: waits for every process to arrive, then releases them; aborts the barrier and exits if one of them died
+ * @param barrier the barrier
+ */
+void Barrier_father (SBarrier *barrier);
+
+/**
+ * @brief Computes the start skew of the last generation the calling process went through
+ * @param barrier the barrier (can be NULL)
+ * @param processId the id of the calling benchmark process
+ * @return the difference between the latest and the earliest release, in cycles (-1 if unknown or aborted)
+ */
+double Barrier_getStartSkew (SBarrier *barrier, unsigned processId);
+
+#endif
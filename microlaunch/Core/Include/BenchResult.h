@@ -0,0 +1,54 @@
+#ifndef H_BENCHRESULT
+#define H_BENCHRESULT
+
+#include <stdint.h>
+
+/**
+ * @brief struct sBenchResult contains the results of a benchmark program run
+ */
+typedef struct sBenchResult 
+{
+	double *time;            /**< @brief Time spent by the benchmark program */
+    uint64_t *iterations;    /**< @brief Number of iterations */
+    double initialTime;		/**< @brief Result of the start call */
+    double finalTime;		/**< @brief Result of the stop call */
+    unsigned nbCounters;	/**< @brief Number of counters exported by the evaluation library (0 if none) */
+    double **counters;		/**< @brief Value of each exported counter, per meta-repetition */
+    unsigned nbSamples;		/**< @brief Number of meta-repetitions actually stored (lower than the allocated one in adaptive mode) */
+    double precision;		/**< @brief Relative precision reached by the stored meta-repetitions (-1 if unknown) */
+    double *startSkew;		/**< @brief Start skew between the benchmark processes, in cycles, per meta-repetition (-1 if unknown) */
+    double *fusedTime;		/**< @brief Cycles of the repetition loop timed by the fused driver, per meta-repetition (-1 if unknown) */
+    unsigned nbAuditEvents;	/**< @brief Number of events counted in the measurement window (0 if not audited) */
+    double **audit;			/**< @brief Count of each audited event in the measurement window, per meta-repetition (-1 if unknown) */
+} BenchResult;
+
+/**
+ * @brief Allocates a BenchResult
+ * @param meta_repet the number of meta-repetitions to be stored
+ * @return the allocated BenchResult, every value set to 0
+ */
+BenchResult *BenchResult_create (unsigned meta_repet);
+
+/**
+ * @brief Releases a BenchResult and its counters
+ * @param br the BenchResult we wish to free
+ */
+void BenchResult_destroy (BenchResult *br);
+
+/**
+ * @brief Allocates the counter tables of a BenchResult
+ * @param br the BenchResult we wish to use
+ * @param nbCounters the number of counters exported by the evaluation library
+ * @param meta_repet the number of meta-repetitions to be stored
+ */
+void BenchResult_createCounters (BenchResult *br, unsigned nbCounters, unsigned meta_repet);
+
+/**
+ * @brief Allocates the audit tables of a BenchResult
+ * @param br the BenchResult we wish to use
+ * @param nbEvents the number of audited events
+ * @param meta_repet the number of meta-repetitions to be stored
+ */
+void BenchResult_createAudit (BenchResult *br, unsigned nbEvents, unsigned meta_repet);
+
+#endif
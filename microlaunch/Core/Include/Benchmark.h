@@ -7,6 +7,7 @@
 
 //Advance declaration
 struct sDescription;
+struct sResultSink;
 
 /**
  * @brief the kernel function pointeur type, need for the associative table nbflux => kernel to use
@@ -33,6 +34,16 @@ int getExperimentNumber ( struct sDescription *desc );
  */
 int Benchmark_Wrapper (struct sDescription *desc, int currentExecRepet);
 
+/**
+ * @brief Launch the 2D benchmark of every kernel in turn, the libraries and arrays being set up once
+ * @param desc the struct sDescription we wish to use
+ * @param currentExecRepet the current --executerepetition iteration
+ * @param libraries the compiled library of each kernel
+ * @param nbKernels the number of kernels
+ * @return returns EXIT_SUCCESS/EXIT_FAILURE depending on the status of the execution
+ */
+int Benchmark_Batch (struct sDescription *desc, int currentExecRepet, char **libraries, unsigned nbKernels);
+
 /**
  * @brief Does the filename contain .cfg or not
  * @param s the string representing the filename
@@ -48,14 +59,15 @@ int containsCFG(char *s);
 void Benchmark_next(struct sDescription *desc,int *systemState);
 
 /**
- * @brief initializes the CSV
+ * @brief Defines the columns of the results
  * @param desc the description we wish to use
- * @param stream the file descriptor inside which we want to write
+ * @param sink the result sink of the output file
  * */
-void Benchmark_initCsv (struct sDescription *desc, FILE *stream);
+void Benchmark_initCsv (struct sDescription *desc, struct sResultSink *sink);
 
 /**
- * @brief print in a csv file all results we wish to expoit
+ * @brief Adds to the result sink a row with all results we wish to expoit
+ * @param desc the description we wish to use
  * @param res the results we wish to print
  * @param nbEvalLibs the number of evaluation librairies to be written
  * @param currentMetaRepet the ID of the current meta-repetition to be written
@@ -63,11 +75,88 @@ void Benchmark_initCsv (struct sDescription *desc, FILE *stream);
  * @param nb_offsets the number of vectors used in the program
  * @param nb_resumes the number of times the program was "--resume"d
  * @param currun the id of the current run
- * @param stream the file descriptor pointer we wish to use
+ * @param sink the result sink of the output file
  * @param problem if problem != 0, the current computation process have had some trouble
  * */
-void Benchmark_printCsv(BenchResult **res, unsigned nbEvalLibs, unsigned currentMetaRepet, int* offsets,
-			unsigned nb_offsets, int nb_resumes, int currun, FILE *stream, int problem);
+void Benchmark_printCsv(struct sDescription *desc, BenchResult **res, unsigned nbEvalLibs, unsigned currentMetaRepet, int* offsets,
+			unsigned nb_offsets, int nb_resumes, int currun, struct sResultSink *sink, int problem);
+
+/**
+ * @brief Defines the evaluation library columns (one column per counter for the libraries exporting several ones)
+ *  followed, in adaptive mode, by the number of samples and the achieved precision
+ * @param desc the description we wish to use
+ * @param sink the result sink of the output file
+ */
+void Benchmark_initCsvEvaluationColumns (struct sDescription *desc, struct sResultSink *sink);
+
+/**
+ * @brief Gives the evaluation library columns of a meta-repetition
+ * @param desc the description we wish to use
+ * @param res the results we wish to print
+ * @param nbEvalLibs the number of evaluation librairies to be written
+ * @param currentMetaRepet the ID of the current meta-repetition to be written
+ * @param sink the result sink of the output file
+ */
+void Benchmark_printCsvEvaluationColumns (struct sDescription *desc, BenchResult **res, unsigned nbEvalLibs, unsigned currentMetaRepet, struct sResultSink *sink);
+
+/**
+ * @brief Updates the number of samples and the precision of the results after a meta-repetition
+ * @param res the results we wish to update
+ * @param desc the description we wish to use
+ * @param nbSamples the number of meta-repetitions stored so far
+ * @return 1 if the adaptive mode is enabled and the requested precision is reached, 0 else
+ */
+int Benchmark_updatePrecision (BenchResult **res, struct sDescription *desc, unsigned nbSamples);
+
+/**
+ * @brief Creates the statistics file next to the output CSV file (Benchmark_createOutputFile must have been called)
+ * @param desc the description of the program
+ * @return the file descriptor we are going to use
+ */
+FILE *Benchmark_createStatisticsFile (struct sDescription *desc);
+
+/**
+ * @brief Writes the header of the statistics file
+ * @param desc the description we wish to use
+ * @param stream the file descriptor inside which we want to write
+ */
+void Benchmark_initStatisticsCsv (struct sDescription *desc, FILE *stream);
+
+/**
+ * @brief Writes the summary of every evaluation column of a run in the statistics file
+ * @param desc the description we wish to use
+ * @param res the results we wish to summarize
+ * @param run the name of the run ("Overhead (raw)": one measure of the empty loop, neither corrected nor normalized; or "Result")
+ * @param offsets the array of alignments of the configuration (NULL in exec mode)
+ * @param nb_offsets the number of vectors used in the program
+ * @param currun the id of the current run
+ * @param stream the file descriptor pointer we wish to use
+ */
+void Benchmark_printStatisticsCsv (struct sDescription *desc, BenchResult **res, const char *run, int *offsets, unsigned nb_offsets, int currun, FILE *stream);
+
+/**
+ * @brief Loads the optional functions of an evaluation library (counters and calibrated read cost)
+ * @param desc the description we wish to use
+ * @param dl the handle of the evaluation library
+ * @param idX the evaluation library index
+ */
+void Benchmark_loadEvaluationOptionalFunctions (struct sDescription *desc, void *dl, unsigned idX);
+
+/**
+ * @brief Stores the counters of every evaluation library for the last measure
+ * @param res the results we wish to fill
+ * @param desc the description we wish to use
+ * @param idX the ID of the current meta-repetition
+ */
+void Benchmark_storeEvaluationCounters (BenchResult **res, struct sDescription *desc, unsigned idX);
+
+/**
+ * @brief Stores the start skew between the benchmark processes for the last measure (shared barrier only)
+ * @param res the results we wish to fill
+ * @param desc the description we wish to use
+ * @param idX the ID of the current meta-repetition
+ */
+void Benchmark_storeStartSkew (BenchResult **res, struct sDescription *desc, unsigned idX);
 
 /**
  * @brief Allocate the dummy array
@@ -76,13 +165,21 @@ void Benchmark_printCsv(BenchResult **res, unsigned nbEvalLibs, unsigned current
 void Benchmark_makeDummyArray (struct sDescription *desc);
 
 /**
- * @brief Creates and open the output CSV file we want to write into for both kernel and exec mode
+ * @brief Creates the result sink of the output file (CSV, or binary with --binary-output) for both kernel and exec mode
  * @param desc the description of the program
  * @param currentExecRepet the current execute-repetition of the program
  * @param currentVectorSize the current vector size of the arrays (ignored in Exec mode)
- * @return the file descriptor we are going to use
+ * @return the result sink we are going to use (NULL if the file cannot be opened)
+ */
+struct sResultSink *Benchmark_createOutputFile (struct sDescription *desc, int currentExecRepet, int currentVectorSize);
+
+/**
+ * @brief Father side of the sweep mode: merges the parts written by the workers in one output file ordered by run id, and one statistics file
+ * @param desc the description of the program
+ * @param currentExecRepet the current execute-repetition of the program
+ * @return 0 on success, -1 otherwise (the parts are kept)
  */
-FILE *Benchmark_createOutputFile (struct sDescription *desc, int currentExecRepet, int currentVectorSize);
+int Benchmark_mergeSweep (struct sDescription *desc, int currentExecRepet);
 
 #endif
 
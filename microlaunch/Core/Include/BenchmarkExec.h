@@ -3,7 +3,9 @@
 
 #include <stdio.h>
 #include "Defines.h"
+#include "ChildStats.h"
 #include "Description.h"
+#include "ResultSink.h"
 
 /**
  * @brief Benchmark launching executable
@@ -13,20 +15,45 @@
 int Benchmark_Exec ( struct sDescription *desc, int currentExecRepet );
 
 /**
- * @brief Initializes the output CSV file (if any)
+ * @brief Handles the output of a child process about to execute the benchmarked program
  * @param desc The SDescription describing the program
- * @param stream The file descriptor pointing to the output CSV file
+ * @param overhead whether or not the current execution is overhead computation
+ * @param isPrintingProcess whether or not the current process has to print something
  */
-void BenchmarkExec_initCsv (SDescription *desc, FILE *stream);
+void BenchmarkExec_prepareChildOutput (SDescription *desc, int overhead, int isPrintingProcess);
 
 /**
- * @brief Prints data into the output CSV file
+ * @brief Executes the benchmarked program in the current process with the user arguments (does not return)
+ * @param desc The SDescription describing the program
+ * @param fileName the executable to launch
+ */
+void BenchmarkExec_executeChild (SDescription *desc, char *fileName);
+
+/**
+ * @brief Checks that a benchmarked program ended normally (exits microlaunch else)
+ * @param status the status given by waitpid (or wait4)
+ * @return the exit status of the program
+ */
+int BenchmarkExec_checkChildStatus (int status);
+
+/**
+ * @brief Defines the columns of the output file (if any)
+ * @param desc The SDescription describing the program
+ * @param stats What is measured on the executed program itself (can be NULL)
+ * @param sink The result sink of the output file
+ */
+void BenchmarkExec_initCsv (SDescription *desc, SChildStats *stats, SResultSink *sink);
+
+/**
+ * @brief Adds a row to the output file
+ * @param desc The SDescription describing the program
  * @param res The table of results describing the execution
+ * @param stats What is measured on the executed program itself (can be NULL)
  * @param nbEvalLibs The number of evaluation librairies to be written
  * @param currentMetaRepet the id of the current meta-repetition to be written
- * @param stream the file descriptor pointing to the output CSV file
+ * @param sink the result sink of the output file
  * @param problem Whether or not a problem occured during this meta-repetition
  */
-void BenchmarkExec_printCsv (BenchResult **res, unsigned nbEvalLibs, unsigned currentMetaRepet, FILE *stream, int problem);
+void BenchmarkExec_printCsv (SDescription *desc, BenchResult **res, SChildStats *stats, unsigned nbEvalLibs, unsigned currentMetaRepet, SResultSink *sink, int problem);
 
 #endif
@@ -0,0 +1,88 @@
+#ifndef H_CHILDSTATS
+#define H_CHILDSTATS
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/resource.h>
+
+/* Resource usage columns reported by --rusage */
+enum ChildStatsRusage { RUSAGE_MINOR_FAULTS = 0, RUSAGE_MAJOR_FAULTS, RUSAGE_VOLUNTARY_SWITCHES, RUSAGE_INVOLUNTARY_SWITCHES, RUSAGE_MAX_RSS, RUSAGE_NB_COLUMNS };
+
+//Advance declaration
+struct sDescription;
+struct sResultSink;
+
+/**
+ * @brief struct sChildStats holds what is measured on the executed program itself rather than from microlaunch
+ */
+typedef struct sChildStats
+{
+	unsigned nbEvents;		/**< @brief Number of perf events */
+	char **eventNames;		/**< @brief Name of each event */
+	char *eventList;		/**< @brief Storage of the event names */
+	int *fds;				/**< @brief perf file descriptor of each event (-1 when not attached) */
+	double *baseline;		/**< @brief Value of each event at the last measure (fork server) */
+	int rusage;				/**< @brief Whether or not the resource usage is reported */
+	unsigned nbColumns;		/**< @brief Number of CSV columns: events then resource usage */
+	double *current;		/**< @brief Values of the last measure, per column */
+	double **values;		/**< @brief Stored values, per column and meta-repetition */
+} SChildStats;
+
+/**
+ * @brief Creates the child statistics asked by the user
+ * @param desc the SDescription of this execution
+ * @param meta_repet the number of meta-repetitions to be stored
+ * @return the child statistics, NULL if none is asked
+ */
+SChildStats *ChildStats_create (struct sDescription *desc, unsigned meta_repet);
+
+/**
+ * @brief Releases the child statistics
+ * @param stats the child statistics (can be NULL)
+ */
+void ChildStats_destroy (SChildStats *stats);
+
+/**
+ * @brief Whether or not the executed program has to wait for the events to be attached before its exec
+ * @param stats the child statistics (can be NULL)
+ */
+int ChildStats_hasEvents (SChildStats *stats);
+
+/**
+ * @brief Opens the perf events on a process and its future threads and children
+ * @param stats the child statistics (can be NULL)
+ * @param pid the process to follow
+ * @param enableOnExec whether the counting starts at the next exec of the process (else, right away)
+ */
+void ChildStats_attach (SChildStats *stats, pid_t pid, int enableOnExec);
+
+/**
+ * @brief Reads the events (difference since the last measure) and the resource usage of the ended program
+ * @param stats the child statistics (can be NULL)
+ * @param usage the resource usage given by wait4
+ */
+void ChildStats_measure (SChildStats *stats, struct rusage *usage);
+
+/**
+ * @brief Stores the last measure
+ * @param stats the child statistics (can be NULL)
+ * @param idX the current meta-repetition
+ */
+void ChildStats_store (SChildStats *stats, unsigned idX);
+
+/**
+ * @brief Defines the columns of the child statistics
+ * @param stats the child statistics (can be NULL)
+ * @param sink the result sink of the output file
+ */
+void ChildStats_initCsv (SChildStats *stats, struct sResultSink *sink);
+
+/**
+ * @brief Gives the values of a meta-repetition
+ * @param stats the child statistics (can be NULL)
+ * @param idX the meta-repetition
+ * @param sink the result sink of the output file
+ */
+void ChildStats_printCsv (SChildStats *stats, unsigned idX, struct sResultSink *sink);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef H_COMPILECACHE
+#define H_COMPILECACHE
+
+#include <stddef.h>
+
+/* Directory of the cache, relative to MLDIR */
+#define COMPILECACHE_DIR "cache"
+
+/* Compiler used for the kernel and executable sources */
+#define COMPILECACHE_COMPILER "gcc"
+
+/**
+ * @brief Gives the cache entry of a compilation, the key is a hash of the source contents, the compiler, the flags and the OpenMP path
+ * @param source the compiled file
+ * @param flags the compilation flags (everything but the file names)
+ * @param ompPath the OpenMP library path (can be NULL)
+ * @param suffix the suffix of the entry name (e.g. ".so")
+ * @param path filled with the entry path
+ * @param size the size of path
+ * @return 1 if the entry already exists, 0 if it has to be compiled, -1 if the cache cannot be used
+ */
+int CompileCache_lookup (const char *source, const char *flags, const char *ompPath, const char *suffix, char *path, size_t size);
+
+/**
+ * @brief Creates the temporary file an entry is compiled in, next to the entry so that it can be published atomically
+ * @param path the entry path
+ * @param tmp filled with the temporary file name
+ * @param size the size of tmp
+ * @return 0 on success, -1 otherwise
+ */
+int CompileCache_createTemporary (const char *path, char *tmp, size_t size);
+
+/**
+ * @brief Publishes a compiled entry, concurrent launches compiling the same entry are harmless
+ * @param tmp the temporary file the entry was compiled in (removed on failure)
+ * @param path the entry path
+ * @return 0 on success, -1 otherwise
+ */
+int CompileCache_commit (const char *tmp, const char *path);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef H_COMPILEPIPELINE
+#define H_COMPILEPIPELINE
+
+#include <sys/types.h>
+
+/* Niceness of the compiler processes, so that they yield to the benchmark when they share its processors */
+#define COMPILEPIPELINE_NICE 10
+
+//Advance declaration
+struct sDescription;
+
+/**
+ * @brief States of a kernel in the compilation pipeline
+ */
+typedef enum eCompilePipelineState
+{
+	COMPILEPIPELINE_WAITING = 0,	/**< @brief Not queued yet */
+	COMPILEPIPELINE_QUEUED,			/**< @brief Queued or being compiled */
+	COMPILEPIPELINE_READY,			/**< @brief In the compilation cache */
+	COMPILEPIPELINE_FAILED			/**< @brief The compilation failed, the kernel is compiled again in series to report the error */
+} ECompilePipelineState;
+
+/**
+ * @brief struct sCompilePipeline is a pool of compiler processes filling the compilation cache with the next kernels
+ */
+typedef struct sCompilePipeline
+{
+	unsigned nbWorkers;		/**< @brief Number of compiler processes */
+	pid_t *workers;			/**< @brief The compiler processes */
+	int queue[2];			/**< @brief Pipe of the kernel ids to be compiled */
+	int done[2];			/**< @brief Pipe of the compiled kernel ids and their status */
+	unsigned nbKernels;		/**< @brief Number of kernels of the run */
+	unsigned depth;			/**< @brief Maximum number of kernels compiled ahead of the measured one */
+	unsigned next;			/**< @brief Next kernel to be queued */
+	unsigned char *states;	/**< @brief State of each kernel (see ECompilePipelineState) */
+} SCompilePipeline;
+
+/**
+ * @brief Starts the compiler processes on the available processors the benchmark processes are not pinned on
+ * @param desc the SDescription of the run (the thread pinning has to be exported)
+ * @return the pipeline, NULL if the kernels are compiled in series (no --compile-jobs, a single kernel or no compilation cache)
+ */
+SCompilePipeline *CompilePipeline_create (struct sDescription *desc);
+
+/**
+ * @brief Waits until a kernel is in the compilation cache and queues the next ones
+ * @param pipeline the pipeline (can be NULL)
+ * @param kernelId the kernel about to be measured
+ */
+void CompilePipeline_wait (SCompilePipeline *pipeline, unsigned kernelId);
+
+/**
+ * @brief Stops the compiler processes and releases the pipeline
+ * @param pipeline the pipeline (can be NULL)
+ */
+void CompilePipeline_destroy (SCompilePipeline *pipeline);
+
+#endif
@@ -17,22 +17,7 @@
 
 #define ALIGNEMENT ALIGNED      
 
-/**
- * @todo Move this to a separate .h
- */
-#include <stdint.h>
-
-
-/**
- * @brief struct sBenchResult contains the results of a benchmark program run
- */
-typedef struct sBenchResult 
-{
-	double *time;            /**< @brief Time spent by the benchmark program */
-    uint64_t *iterations;    /**< @brief Number of iterations */
-    double initialTime;		/**< @brief Result of the start call */
-    double finalTime;		/**< @brief Result of the stop call */
-} BenchResult;
+#include "BenchResult.h"
 
 #define STRBUF_MAXLEN 512
 
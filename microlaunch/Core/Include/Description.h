@@ -32,6 +32,17 @@
 #define DEFAULT_RESUMING_VALUE -10
 #define DEFAULT_RESUME_NB -10
 #define DEFAULT_RESUME_ID -10
+#define DEFAULT_MIN_META_REPETITION -10
+#define DEFAULT_ADAPTIVE_PRECISION -10
+#define DEFAULT_ADAPTIVE_CRITERION -10
+#define DEFAULT_AUTO_REPETITION_TARGET -10
+#define DEFAULT_BARRIER_MODE -10
+#define DEFAULT_FLUSH_STRATEGY -10
+#define DEFAULT_FLUSH_LEVEL -10
+#define DEFAULT_PIN_POLICY -10
+#define DEFAULT_COMPILE_AHEAD -10
+#define DEFAULT_ALIGNMENT_SAMPLES -10
+#define DEFAULT_VECTOR_POINTS -10
 
 struct sDescription; /* See verificationFctInit typedef */
 
@@ -46,6 +57,14 @@ typedef double (*evaluationFct) (void *evalData);
 // be taken into account when measuring the overhead.
 typedef unsigned int evaluationFlag;
 
+// Define the type for the optional counter functions, used by libraries exporting several values per measure
+typedef unsigned (*evaluationCounterNbFct) (void *evalData);
+typedef const char *(*evaluationCounterNameFct) (void *evalData, unsigned idX);
+typedef double (*evaluationCounterValueFct) (void *evalData, unsigned idX);
+
+// Define the type for the optional calibrated read cost function (counter 0 stands for the main value)
+typedef double (*evaluationReadCostFct) (void *evalData, unsigned idX);
+
 // Deinf the type for the veryfing functions
 typedef void *(*verificationFctInit) (struct sDescription *desc);
 typedef void (*verificationFctDisplay) (void *context, FILE *fp);
@@ -60,6 +79,9 @@ typedef void (*personalized_malloc_destroy_t)();
 // Define the type of program we want to launch : source file, assembly file, library file or executable filename
 typedef enum { UNKNOWN_FILE, SOURCE_FILE, ASSEMBLY_FILE, LIBRARY_FILE, OBJECT_FILE, EXECUTABLE_FILE } Source_type;
 
+// Define the clock used to calibrate the number of repetitions
+typedef enum { AUTO_REPETITION_NS, AUTO_REPETITION_CYCLES } AutoRepetition_unit;
+
 /**
  * @brief struct sResumeValues define the key resume values we have to store temporarily
  */
@@ -70,6 +92,8 @@ typedef struct sResumeValues
 	int current_vector_size;	/**< @brief Current vector size executed in the program */
 	int current_execute_repet;	/**< @brief Current execute repetition executed in the program */
 	int curruns;				/**< @brief Current number of runs executed in the program */
+	int current_sample;			/**< @brief Position of the next configuration in the sampler list (sampled alignments only) */
+	int current_size_step;		/**< @brief Position of the current vector size in the stepping list (geometric and adaptive stepping only) */
 } SResumeValues;
 
 /**
@@ -83,6 +107,11 @@ typedef struct sDescription
     int startVectorSize;    /**< @brief Define the start vector size */
     int endVectorSize;      /**< @brief Define the end vector size */
     int vectorSizeStep;     /**< @brief Define the vector size step */
+    int vectorStepping;     /**< @brief Define how the vector sizes are chosen (see ESteppingMode) */
+    double vectorRatio;     /**< @brief Define the ratio between two consecutive sizes of the geometric stepping */
+    int vectorPoints;       /**< @brief Define the number of vector sizes measured by the adaptive stepping */
+    double vectorThreshold; /**< @brief Define the relative difference between consecutive sizes bisected by the adaptive stepping */
+    struct sStepping *stepping;	/**< @brief The vector size stepping of the current kernel (NULL in linear mode) */
     int vectorElementSize;	/**< @brief Define the vector element size in octets (float, double or event customed) */
     unsigned long *vectorSizes;	/**< @brief Define vector customed sizes */
     int isNbSizesDefined; /**< @brief Define whether or not customed sizes are defined */
@@ -91,7 +120,12 @@ typedef struct sDescription
     int iterationCount;		/**< @brief Define the number of iteration the user want to do */
 
     int repetition;         /**< @brief Define the repetition value */
-    int metaRepetition;     /**< @brief Define the meta-repetition value */
+    int metaRepetition;     /**< @brief Define the meta-repetition value (the maximum one in adaptive mode) */
+    int minMetaRepetition;  /**< @brief Define the minimum number of meta-repetitions in adaptive mode */
+    double adaptivePrecision;	/**< @brief Define the relative precision to reach in adaptive mode (0 disables it) */
+    int adaptiveCriterion;	/**< @brief Define the precision criterion used in adaptive mode (see EAdaptiveCriterion) */
+    double autoRepetitionTarget;	/**< @brief Define the duration each measure should span when calibrating the repetitions (0 disables it) */
+    AutoRepetition_unit autoRepetitionUnit;	/**< @brief Define the unit of autoRepetitionTarget */
     int maxStride;             /**< @brief Define the stride of the experiment */
     int pageSize;           /**< @brief Define the page size */
     char *baseName;         /**< @brief Define the base name of the experiment */
@@ -99,12 +133,17 @@ typedef struct sDescription
     int nbPagesForCollision; /**< @brief Define the number of pages for a collision */
 
 	int vectorSpacing;       /**< @brief spacing between vectors in octet*/
+	int arena;               /**< @brief Defines whether or not the vectors are views in slots allocated once for the whole sweep */
 	int nbprocess;         	/**< @brief number of benchmark process to launch*/
     unsigned long *pinning;	/**< @brief Define the pinning values */
 	int nbProcessorsAvailable;	/**< @brief number of processors available on the machine */
     int dummySize;          /**< @brief Define the dummy size */
     double *dummyArrayAligned; /**< @brief Give the dummy array (aligned version) */
     double *dummyArrayNonAligned; /**< @brief Give the dummy array (non aligned version) */
+    int flushStrategy;      /**< @brief Defines how the caches are flushed (see EFlushStrategy) */
+    int flushLevel;         /**< @brief Defines the cache level the evict strategy targets (see EFlushLevel) */
+    int flushVerify;        /**< @brief Defines whether or not the flushes are verified with a probe */
+    struct sFlush *flush;   /**< @brief The flush of the current kernel or executable */
     char *configFileName;			/**< @brief filename of the .cfg config file containing default options */
     int summary;	/**@brief Whether or not we want a summary of the execution files at the end of the program */
 
@@ -124,9 +163,24 @@ typedef struct sDescription
 
 	int *tubeSF;         /**< @brief the pipe from the sons to the father to make the sync*/
 	int *tubeFS;		   /**< @brief the pipe from the fathe to the sons to make the sync*/
+	int barrierMode;		/**< @brief Synchronisation used between the processes and the father (see EBarrierMode) */
+	struct sBarrier *barrier;	/**< @brief The shared barrier (NULL in pipe mode) */
 	char *ompPath;		/**< @brief customed path to OMP library */
+	int compileCache;	/**< @brief Defines whether or not the compiled kernels and executables are kept in the compilation cache */
+	int compileJobs;	/**< @brief Number of compiler processes compiling the next kernels during the measurements (0: compile in series) */
+	int compileAhead;	/**< @brief Maximum number of kernels compiled ahead of the measured one */
+	int batch;			/**< @brief Defines whether or not the benchmark processes stay alive for the whole kernel list */
 	char *outputPath;	/**< @brief customed path to output files storing */
 	int suppressOutput;	/**< @brief defines whether or not the output of the input executable is displayed or not */
+	int binaryOutput;	/**< @brief defines whether or not the results are written in the binary format instead of CSV */
+	int sweep;			/**< @brief Defines whether or not the size and alignment points are spread on independent workers */
+	int sweepIsolation;	/**< @brief Processors the sweep workers are pinned on (see ESweepIsolation) */
+	struct sSweep *sweepQueue;	/**< @brief The shared queue of the sweep points (NULL if not in sweep mode) */
+	int alignmentSampling;	/**< @brief How the alignment configurations are chosen (see ESamplerMode) */
+	int alignmentSamples;	/**< @brief Number of alignment configurations measured per vector size when sampling */
+	unsigned long alignmentSeed;	/**< @brief Seed of the alignment sampling */
+	double alignmentThreshold;	/**< @brief Relative deviation from the neighbours refined by the adaptive sampling */
+	struct sSampler *sampler;	/**< @brief The alignment sampler of the current kernel (NULL if every configuration is measured) */
 	char *outputFileStream;	/**< @brief defines the output filestream to be used for the executable output */
 
     int **vectorDescriptor;    				    /**< @brief Vector description */
@@ -145,6 +199,10 @@ typedef struct sDescription
     int executeRepet;	/**< @brief Define the number of ML executions the user wants */
 
     void *kernelFunction;   /**< @brief Kernel function */
+    void *driverFunction;   /**< @brief Repetition loop linked in the kernel library (NULL if the kernel is called through its wrapper) */
+    int fusedDriver;        /**< @brief Defines whether or not a driver holding the repetition loop is linked in the compiled kernel library */
+    int auditMode;          /**< @brief Defines whether or not the context switches, page faults and syscalls of the measurement window are counted */
+    struct sAudit *audit;   /**< @brief The audit events of the benchmark process (NULL if not audited) */
     void *kernelInitFunction;	/**< @brief Kernel initialization function */
 
     char **evaluationLibraryName;    /**< @brief Evaluation library name */
@@ -154,6 +212,10 @@ typedef struct sDescription
     evaluationFct *evaluationStart;  /**< @brief Evaluation start function */
     evaluationFct *evaluationStop;   /**< @brief Evaluation stop function */
     evaluationFlag **evaluationOverheadFlags;	/**< @brief Is the library overhead measured? */
+    evaluationCounterNbFct *evaluationCounterNb;	/**< @brief Evaluation counter number function (optional) */
+    evaluationCounterNameFct *evaluationCounterName;	/**< @brief Evaluation counter name function (optional) */
+    evaluationCounterValueFct *evaluationCounterValue;	/**< @brief Evaluation counter value function (optional) */
+    evaluationReadCostFct *evaluationReadCost;	/**< @brief Evaluation calibrated read cost function (optional) */
     unsigned nbEvalLibs;	/**< @brief Defines the number of evaluation librairies used in the program */
     int evalStack;			/**< @brief Defines whether or not the evaluation librairies have to be used as a stack or not */
     Source_type sourceType;	/**< @brief Defines the input source type (object, assembly, C, dyn library or stand-alone exec program) */
@@ -174,6 +236,12 @@ typedef struct sDescription
     int number_of_resumes;	/**< @brief Number of times the experiment has been resumed */
     int resumeId;			/**< @brief Id of resuming job */
     int threadPin;			/**< @brief Defines whether or not we have to pin threads in exec mode (only) */
+    int pinPolicy;			/**< @brief Defines the order the threads are pinned in (see ETopologyPinPolicy) */
+    char *pinList;			/**< @brief The processors the threads are pinned on with the list policy (can be NULL) */
+    int forkServer;			/**< @brief Defines whether or not the exec mode forks the samples from a target stopped before main */
+    int roi;				/**< @brief Defines whether or not the exec mode measures the region of interest marked in the target */
+    char *childEvents;		/**< @brief Comma separated perf events counted on the executed program (exec mode, can be NULL) */
+    int rusage;				/**< @brief Defines whether or not the resource usage of the executed program is reported (exec mode) */
     int allProcessOutput;	/**< @brief Defines whether or not every process has to deal with evaluation library */
     int allPrintOut;	    /**< @brief Defines whether or not every child should be printing out */
     int isPrintingProcess;	/**< @brief Defines whether or not the process has to deal with print stuff */
@@ -296,6 +364,83 @@ void Description_setVectorSizeStep (SDescription *desc, int value);
  */
 int Description_getVectorSizeStep (SDescription *desc);
 
+/**
+ * @brief Return how the vector sizes are chosen
+ * @param desc struct sDescription that is used
+ * @return returns the stepping mode (see ESteppingMode)
+ */
+int Description_getVectorStepping (SDescription *desc);
+
+/**
+ * @brief Set how the vector sizes are chosen
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (see ESteppingMode)
+ */
+void Description_setVectorStepping (SDescription *desc, int value);
+
+/**
+ * @brief Parses the vector size stepping mode given by the user
+ * @param desc the SDescription we wish to use
+ * @param value the mode name ("linear", "geometric" or "adaptive")
+ */
+void Description_parseVectorStepping (SDescription *desc, const char *value);
+
+/**
+ * @brief Return the ratio between two consecutive sizes of the geometric stepping
+ * @param desc struct sDescription that is used
+ * @return returns the ratio
+ */
+double Description_getVectorRatio (SDescription *desc);
+
+/**
+ * @brief Set the ratio between two consecutive sizes of the geometric stepping
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set
+ */
+void Description_setVectorRatio (SDescription *desc, double value);
+
+/**
+ * @brief Return the number of vector sizes measured by the adaptive stepping
+ * @param desc struct sDescription that is used
+ * @return returns the number of sizes (DEFAULT_VECTOR_POINTS: twice the geometric progression)
+ */
+int Description_getVectorPoints (SDescription *desc);
+
+/**
+ * @brief Set the number of vector sizes measured by the adaptive stepping
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set
+ */
+void Description_setVectorPoints (SDescription *desc, int value);
+
+/**
+ * @brief Return the relative difference between consecutive sizes bisected by the adaptive stepping
+ * @param desc struct sDescription that is used
+ * @return returns the threshold
+ */
+double Description_getVectorThreshold (SDescription *desc);
+
+/**
+ * @brief Set the relative difference between consecutive sizes bisected by the adaptive stepping
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set
+ */
+void Description_setVectorThreshold (SDescription *desc, double value);
+
+/**
+ * @brief Return the vector size stepping of the current kernel
+ * @param desc struct sDescription that is used
+ * @return returns the stepping (NULL in linear mode)
+ */
+struct sStepping *Description_getStepping (SDescription *desc);
+
+/**
+ * @brief Set the vector size stepping of the current kernel
+ * @param desc the SDescription we wish to use
+ * @param value the stepping (can be NULL)
+ */
+void Description_setStepping (SDescription *desc, struct sStepping *value);
+
 /**
  * @brief Set the number experiments we want to make
  * @param desc the SDescription we wish to use
@@ -348,6 +493,72 @@ void Description_setOmpPath (SDescription *desc, const char* value);
  */
 char* Description_getOmpPath (SDescription *desc);
 
+/**
+ * @brief Enables the compilation cache: the compiled sources are kept under MLDIR and reused while unchanged
+ * @param desc the description we wish to use
+ */
+void Description_compileCacheEnable (SDescription *desc);
+
+/**
+ * @brief Disables the compilation cache: the sources are compiled in temporary files at each launch
+ * @param desc the description we wish to use
+ */
+void Description_compileCacheDisable (SDescription *desc);
+
+/**
+ * @brief Check if the compilation cache is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the compiled sources are kept in the compilation cache
+ */
+int Description_isCompileCacheEnabled (SDescription *desc);
+
+/**
+ * @brief Get the number of compiler processes compiling the next kernels during the measurements
+ * @param desc struct sDescription that is used
+ * @return returns the number of compiler processes (0 if the kernels are compiled in series)
+ */
+int Description_getCompileJobs (SDescription *desc);
+
+/**
+ * @brief Set the number of compiler processes compiling the next kernels during the measurements
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (0 to compile the kernels in series)
+ */
+void Description_setCompileJobs (SDescription *desc, int value);
+
+/**
+ * @brief Get the maximum number of kernels compiled ahead of the measured one
+ * @param desc struct sDescription that is used
+ * @return returns the depth of the compilation queue
+ */
+int Description_getCompileAhead (SDescription *desc);
+
+/**
+ * @brief Set the maximum number of kernels compiled ahead of the measured one
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set
+ */
+void Description_setCompileAhead (SDescription *desc, int value);
+
+/**
+ * @brief Enables the batch mode: the benchmark processes loop over the kernel list, keeping the libraries and arrays
+ * @param desc the description we wish to use
+ */
+void Description_batchEnable (SDescription *desc);
+
+/**
+ * @brief Disables the batch mode: the benchmark processes are launched again for each kernel
+ * @param desc the description we wish to use
+ */
+void Description_batchDisable (SDescription *desc);
+
+/**
+ * @brief Check if the batch mode is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the benchmark processes stay alive for the whole kernel list
+ */
+int Description_isBatchEnabled (SDescription *desc);
+
 /**
  * @brief Get the path to the output files storage
  * @return returns it
@@ -427,6 +638,25 @@ int Description_getVectorSpacing(SDescription *desc);
  */
 void Description_setVectorSpacing(SDescription *desc, int value);
 
+/**
+ * @brief Enables the vector arena: the vectors are allocated once for the largest configuration and reused
+ * @param desc the description we wish to use
+ */
+void Description_arenaEnable (SDescription *desc);
+
+/**
+ * @brief Disables the vector arena: the vectors are allocated for each configuration
+ * @param desc the description we wish to use
+ */
+void Description_arenaDisable (SDescription *desc);
+
+/**
+ * @brief Check if the vector arena is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the vectors are views in slots allocated once for the whole sweep
+ */
+int Description_isArenaEnabled (SDescription *desc);
+
 /**
  * @brief Get the number of benchmark process variable
  * @param desc the SDescription we wish to use
@@ -485,6 +715,81 @@ double *Description_getDummyArrayAligned (SDescription *desc);
  */
 void Description_setDummyArray (SDescription *desc, double* aligned, double* non_aligned);
 
+/**
+ * @brief Get the flush strategy
+ * @param desc struct sDescription that is used
+ * @return returns the strategy (see EFlushStrategy)
+ */
+int Description_getFlushStrategy (SDescription *desc);
+
+/**
+ * @brief Set the flush strategy
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (see EFlushStrategy)
+ */
+void Description_setFlushStrategy (SDescription *desc, int value);
+
+/**
+ * @brief Parses the flush strategy given by the user
+ * @param desc the SDescription we wish to use
+ * @param value the strategy name ("read", "clflush", "clwb", "evict" or "none")
+ */
+void Description_parseFlushStrategy (SDescription *desc, const char *value);
+
+/**
+ * @brief Get the cache level targeted by the flush
+ * @param desc struct sDescription that is used
+ * @return returns the level (see EFlushLevel)
+ */
+int Description_getFlushLevel (SDescription *desc);
+
+/**
+ * @brief Set the cache level targeted by the flush
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (see EFlushLevel)
+ */
+void Description_setFlushLevel (SDescription *desc, int value);
+
+/**
+ * @brief Parses the cache level given by the user
+ * @param desc the SDescription we wish to use
+ * @param value the level name ("l1", "l2", "llc" or "mem")
+ */
+void Description_parseFlushLevel (SDescription *desc, const char *value);
+
+/**
+ * @brief Enables the verification of the flushes
+ * @param desc the description we wish to use
+ */
+void Description_flushVerifyEnable (SDescription *desc);
+
+/**
+ * @brief Disables the verification of the flushes
+ * @param desc the description we wish to use
+ */
+void Description_flushVerifyDisable (SDescription *desc);
+
+/**
+ * @brief Check if the verification of the flushes is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the residual hits are probed after each flush
+ */
+int Description_isFlushVerifyEnabled (SDescription *desc);
+
+/**
+ * @brief Get the flush of the current kernel or executable
+ * @param desc struct sDescription that is used
+ * @return returns the flush (can be NULL)
+ */
+struct sFlush *Description_getFlush (SDescription *desc);
+
+/**
+ * @brief Set the flush of the current kernel or executable, the previous one is destroyed
+ * @param desc the SDescription we wish to use
+ * @param value the flush
+ */
+void Description_setFlush (SDescription *desc, struct sFlush *value);
+
 /**
  * @brief Get the repetition variable
  * @param desc struct sDescription that is used
@@ -513,6 +818,104 @@ int Description_getMetaRepetition (SDescription *desc);
  */
 void Description_setMetaRepetition (SDescription *desc, int value);
 
+/**
+ * @brief Get the minimum meta repetition variable (adaptive mode)
+ * @param desc struct sDescription that is used
+ * @return returns the minimum meta repetition
+ */
+int Description_getMinMetaRepetition (SDescription *desc);
+
+/**
+ * @brief Set the minimum meta repetition variable (adaptive mode)
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set
+ */
+void Description_setMinMetaRepetition (SDescription *desc, int value);
+
+/**
+ * @brief Get the relative precision to reach before stopping the meta-repetitions
+ * @param desc struct sDescription that is used
+ * @return returns the precision, 0 if the adaptive mode is disabled
+ */
+double Description_getAdaptivePrecision (SDescription *desc);
+
+/**
+ * @brief Set the relative precision to reach before stopping the meta-repetitions
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (0 disables the adaptive mode)
+ */
+void Description_setAdaptivePrecision (SDescription *desc, double value);
+
+/**
+ * @brief Get the precision criterion used in adaptive mode
+ * @param desc struct sDescription that is used
+ * @return returns the criterion (see EAdaptiveCriterion)
+ */
+int Description_getAdaptiveCriterion (SDescription *desc);
+
+/**
+ * @brief Set the precision criterion used in adaptive mode
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (see EAdaptiveCriterion)
+ */
+void Description_setAdaptiveCriterion (SDescription *desc, int value);
+
+/**
+ * @brief Parses the precision criterion given by the user
+ * @param desc the SDescription we wish to use
+ * @param value the criterion name ("ci" or "mad")
+ */
+void Description_parseAdaptiveCriterion (SDescription *desc, const char *value);
+
+/**
+ * @brief Whether or not the meta-repetitions stop once a precision target is reached
+ * @param desc struct sDescription that is used
+ * @return 1 if the adaptive mode is enabled, 0 else
+ */
+int Description_isAdaptiveModeEnabled (SDescription *desc);
+
+/**
+ * @brief Get the duration each measure should span when calibrating the repetitions
+ * @param desc struct sDescription that is used
+ * @return returns the target (see Description_getAutoRepetitionUnit), 0 if the calibration is disabled
+ */
+double Description_getAutoRepetitionTarget (SDescription *desc);
+
+/**
+ * @brief Set the duration each measure should span when calibrating the repetitions
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (0 disables the calibration)
+ */
+void Description_setAutoRepetitionTarget (SDescription *desc, double value);
+
+/**
+ * @brief Get the unit of the repetition calibration target
+ * @param desc struct sDescription that is used
+ * @return returns the unit
+ */
+AutoRepetition_unit Description_getAutoRepetitionUnit (SDescription *desc);
+
+/**
+ * @brief Set the unit of the repetition calibration target
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set
+ */
+void Description_setAutoRepetitionUnit (SDescription *desc, AutoRepetition_unit value);
+
+/**
+ * @brief Parses the repetition calibration target given by the user (e.g. "1ms", "500us", "2000000cycles")
+ * @param desc the SDescription we wish to use
+ * @param value the target, a number followed by ns, us, ms or cycles (cycles if omitted)
+ */
+void Description_parseAutoRepetition (SDescription *desc, const char *value);
+
+/**
+ * @brief Whether or not the number of repetitions is calibrated before each measure
+ * @param desc struct sDescription that is used
+ * @return 1 if the calibration is enabled, 0 else
+ */
+int Description_isAutoRepetitionEnabled (SDescription *desc);
+
 /**
  * @brief Get the page size variable
  * @param desc struct sDescription that is used
@@ -715,6 +1118,41 @@ int *Description_getTubeFS (SDescription *desc);
  */
 void Description_setTubeFS (SDescription *desc, int* value);
 
+/**
+ * @brief Return the synchronisation used between the processes and the father
+ * @param desc struct sDescription that is used
+ * @return returns the mode (see EBarrierMode)
+ */
+int Description_getBarrierMode (SDescription *desc);
+
+/**
+ * @brief Set the synchronisation used between the processes and the father
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (see EBarrierMode)
+ */
+void Description_setBarrierMode (SDescription *desc, int value);
+
+/**
+ * @brief Parses the synchronisation given by the user
+ * @param desc the SDescription we wish to use
+ * @param value the mode name ("futex", "spin" or "pipe")
+ */
+void Description_parseBarrierMode (SDescription *desc, const char *value);
+
+/**
+ * @brief Return the shared barrier
+ * @param desc struct sDescription that is used
+ * @return returns the barrier (NULL in pipe mode)
+ */
+struct sBarrier *Description_getBarrier (SDescription *desc);
+
+/**
+ * @brief Set the shared barrier
+ * @param desc the SDescription we wish to use
+ * @param value the barrier created by the father
+ */
+void Description_setBarrier (SDescription *desc, struct sBarrier *value);
+
 /**
  * @brief Return the Log output
  * @param desc struct sDescription that is used
@@ -769,6 +1207,222 @@ void Description_setKernelFunction (SDescription *desc, void *fct);
  * @return the kernel function pointer
  */
 void* Description_getKernelFunction (SDescription *desc);
+
+/**
+ * @brief Set the driver function linked in the kernel library
+ * @param desc the SDescription we wish to use
+ * @param fct the driver function (NULL to call the kernel through its wrapper)
+ */
+void Description_setDriverFunction (SDescription *desc, void *fct);
+
+/**
+ * @brief Get the driver function linked in the kernel library
+ * @param desc the SDescription we wish to use
+ * @return the driver function pointer (NULL if the kernel is called through its wrapper)
+ */
+void* Description_getDriverFunction (SDescription *desc);
+
+/**
+ * @brief Enables the fused driver: the repetition loop and the timer reads are compiled in the kernel library
+ * @param desc the description we wish to use
+ */
+void Description_fusedDriverEnable (SDescription *desc);
+
+/**
+ * @brief Disables the fused driver: the kernel is called through its wrapper at each repetition
+ * @param desc the description we wish to use
+ */
+void Description_fusedDriverDisable (SDescription *desc);
+
+/**
+ * @brief Check if the fused driver is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the repetition loop is compiled in the kernel library
+ */
+int Description_isFusedDriverEnabled (SDescription *desc);
+
+/**
+ * @brief Enables the audit: the context switches, page faults and syscalls of the measurement window are reported
+ * @param desc the description we wish to use
+ */
+void Description_auditEnable (SDescription *desc);
+
+/**
+ * @brief Disables the audit
+ * @param desc the description we wish to use
+ */
+void Description_auditDisable (SDescription *desc);
+
+/**
+ * @brief Check if the audit is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the measurement window is audited
+ */
+int Description_isAuditEnabled (SDescription *desc);
+
+/**
+ * @brief Return the audit events of the benchmark process
+ * @param desc struct sDescription that is used
+ * @return returns the audit (NULL if not audited)
+ */
+struct sAudit *Description_getAudit (SDescription *desc);
+
+/**
+ * @brief Set the audit events of the benchmark process
+ * @param desc the SDescription we wish to use
+ * @param value the audit opened by the benchmark process
+ */
+void Description_setAudit (SDescription *desc, struct sAudit *value);
+
+/**
+ * @brief Enables the binary output: the results are written in the binary columnar format (see ResultSink.h)
+ * @param desc the description we wish to use
+ */
+void Description_binaryOutputEnable (SDescription *desc);
+
+/**
+ * @brief Disables the binary output: the results are written as CSV
+ * @param desc the description we wish to use
+ */
+void Description_binaryOutputDisable (SDescription *desc);
+
+/**
+ * @brief Check if the binary output is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the results are written in the binary format
+ */
+int Description_isBinaryOutputEnabled (SDescription *desc);
+
+/**
+ * @brief Enables the sweep mode: each benchmark process measures the points it takes from a shared queue
+ * @param desc the description we wish to use
+ */
+void Description_sweepEnable (SDescription *desc);
+
+/**
+ * @brief Disables the sweep mode: every benchmark process measures every point together
+ * @param desc the description we wish to use
+ */
+void Description_sweepDisable (SDescription *desc);
+
+/**
+ * @brief Check if the sweep mode is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the points are spread on the benchmark processes
+ */
+int Description_isSweepEnabled (SDescription *desc);
+
+/**
+ * @brief Return the processors the sweep workers are pinned on
+ * @param desc struct sDescription that is used
+ * @return returns the isolation (see ESweepIsolation)
+ */
+int Description_getSweepIsolation (SDescription *desc);
+
+/**
+ * @brief Set the processors the sweep workers are pinned on
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (see ESweepIsolation)
+ */
+void Description_setSweepIsolation (SDescription *desc, int value);
+
+/**
+ * @brief Parses the isolation given by the user and enables the sweep mode
+ * @param desc the SDescription we wish to use
+ * @param value the isolation name ("cpu", "core" or "l2")
+ */
+void Description_parseSweepIsolation (SDescription *desc, const char *value);
+
+/**
+ * @brief Return the shared queue of the sweep points
+ * @param desc struct sDescription that is used
+ * @return returns the queue (NULL if not in sweep mode)
+ */
+struct sSweep *Description_getSweep (SDescription *desc);
+
+/**
+ * @brief Set the shared queue of the sweep points
+ * @param desc the SDescription we wish to use
+ * @param value the queue (can be NULL)
+ */
+void Description_setSweep (SDescription *desc, struct sSweep *value);
+
+/**
+ * @brief Return how the alignment configurations are chosen
+ * @param desc struct sDescription that is used
+ * @return returns the sampling mode (see ESamplerMode)
+ */
+int Description_getAlignmentSampling (SDescription *desc);
+
+/**
+ * @brief Set how the alignment configurations are chosen
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (see ESamplerMode)
+ */
+void Description_setAlignmentSampling (SDescription *desc, int value);
+
+/**
+ * @brief Parses the alignment sampling mode given by the user
+ * @param desc the SDescription we wish to use
+ * @param value the mode name ("full", "random", "lhs" or "adaptive")
+ */
+void Description_parseAlignmentSampling (SDescription *desc, const char *value);
+
+/**
+ * @brief Return the number of alignment configurations measured per vector size when sampling
+ * @param desc struct sDescription that is used
+ * @return returns the number of configurations (DEFAULT_ALIGNMENT_SAMPLES: a share of the full product)
+ */
+int Description_getAlignmentSamples (SDescription *desc);
+
+/**
+ * @brief Set the number of alignment configurations measured per vector size when sampling
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set
+ */
+void Description_setAlignmentSamples (SDescription *desc, int value);
+
+/**
+ * @brief Return the seed of the alignment sampling
+ * @param desc struct sDescription that is used
+ * @return returns the seed
+ */
+unsigned long Description_getAlignmentSeed (SDescription *desc);
+
+/**
+ * @brief Set the seed of the alignment sampling
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set
+ */
+void Description_setAlignmentSeed (SDescription *desc, unsigned long value);
+
+/**
+ * @brief Return the relative deviation from the neighbours refined by the adaptive sampling
+ * @param desc struct sDescription that is used
+ * @return returns the threshold
+ */
+double Description_getAlignmentThreshold (SDescription *desc);
+
+/**
+ * @brief Set the relative deviation from the neighbours refined by the adaptive sampling
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set
+ */
+void Description_setAlignmentThreshold (SDescription *desc, double value);
+
+/**
+ * @brief Return the alignment sampler of the current kernel
+ * @param desc struct sDescription that is used
+ * @return returns the sampler (NULL if every configuration is measured)
+ */
+struct sSampler *Description_getSampler (SDescription *desc);
+
+/**
+ * @brief Set the alignment sampler of the current kernel
+ * @param desc the SDescription we wish to use
+ * @param value the sampler (can be NULL)
+ */
+void Description_setSampler (SDescription *desc, struct sSampler *value);
 /**
  * @brief Set evaluation initialization function
  * @param fct the kernel function we wish to use
@@ -855,6 +1509,58 @@ void Description_setEvaluationLibraryOverheadFlag (SDescription *desc, evaluatio
  */
 evaluationFlag Description_getEvaluationLibraryOverheadFlag (SDescription *desc, unsigned idX);
 
+/**
+ * @brief Sets the functions of an evaluation library exporting several counters
+ * @param desc the description we wish to use
+ * @param nbFct the function returning the number of counters (can be NULL)
+ * @param nameFct the function returning the name of a counter (can be NULL)
+ * @param valueFct the function returning the value of a counter for the last measure (can be NULL)
+ * @param idX the library index
+ */
+void Description_setEvaluationCounterFunctions (SDescription *desc, evaluationCounterNbFct nbFct, evaluationCounterNameFct nameFct, evaluationCounterValueFct valueFct, unsigned idX);
+
+/**
+ * @brief Gets the number of counters exported by an evaluation library
+ * @param desc the description we wish to use
+ * @param idX the library index
+ * @return the number of counters, 0 if the library does not export any (or is not initialized in this process)
+ */
+unsigned Description_getEvaluationNbCounters (SDescription *desc, unsigned idX);
+
+/**
+ * @brief Gets the name of a counter exported by an evaluation library
+ * @param desc the description we wish to use
+ * @param idX the library index
+ * @param counter the counter index
+ * @return the name of the counter
+ */
+const char *Description_getEvaluationCounterName (SDescription *desc, unsigned idX, unsigned counter);
+
+/**
+ * @brief Gets the counter value function of an evaluation library
+ * @param desc the description we wish to use
+ * @param idX the library index
+ * @return the counter value function pointer (can be NULL)
+ */
+evaluationCounterValueFct Description_getEvaluationCounterValueFunction (SDescription *desc, unsigned idX);
+
+/**
+ * @brief Sets the calibrated read cost function of an evaluation library
+ * @param desc the description we wish to use
+ * @param fct the read cost function (can be NULL)
+ * @param idX the library index
+ */
+void Description_setEvaluationReadCostFunction (SDescription *desc, evaluationReadCostFct fct, unsigned idX);
+
+/**
+ * @brief Gets the calibrated cost of an empty start/stop window of an evaluation library
+ * @param desc the description we wish to use
+ * @param idX the library index
+ * @param counter the counter index (0 for the main value)
+ * @return the read cost, 0 if the library does not export it (or is not initialized in this process)
+ */
+double Description_getEvaluationReadCost (SDescription *desc, unsigned idX, unsigned counter);
+
 /**
  * @brief Sets the type of source file 
  * @param desc the description we wish to use
@@ -1132,6 +1838,112 @@ void Description_pinThreadDisable (SDescription *desc);
  */
 int Description_isThreadPinningEnabled (SDescription *desc);
 
+/**
+ * @brief Get the thread pinning policy
+ * @param desc struct sDescription that is used
+ * @return returns the policy (see ETopologyPinPolicy)
+ */
+int Description_getPinPolicy (SDescription *desc);
+
+/**
+ * @brief Set the thread pinning policy
+ * @param desc the SDescription we wish to use
+ * @param value the value we wish to set (see ETopologyPinPolicy)
+ */
+void Description_setPinPolicy (SDescription *desc, int value);
+
+/**
+ * @brief Parses the thread pinning policy given by the user
+ * @param desc the SDescription we wish to use
+ * @param value the policy name ("linear", "compact", "scatter", "physical" or "socket") or a processor list ("0,2,4-7")
+ */
+void Description_parsePinPolicy (SDescription *desc, const char *value);
+
+/**
+ * @brief Get the processors the threads are pinned on with the list policy
+ * @param desc struct sDescription that is used
+ * @return returns the processor list (can be NULL)
+ */
+char *Description_getPinList (SDescription *desc);
+
+/**
+ * @brief Set the processors the threads are pinned on with the list policy
+ * @param desc the SDescription we wish to use
+ * @param value the processor list (can be NULL)
+ */
+void Description_setPinList (SDescription *desc, const char *value);
+
+/**
+ * @brief Enables the fork-server mode in Executable mode
+ * @param desc the description we wish to use
+ */
+void Description_forkServerEnable (SDescription *desc);
+
+/**
+ * @brief Disables the fork-server mode in Executable mode
+ * @param desc the description we wish to use
+ */
+void Description_forkServerDisable (SDescription *desc);
+
+/**
+ * @brief Check if the fork-server mode is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the fork-server mode is enabled
+ */
+int Description_isForkServerEnabled (SDescription *desc);
+
+/**
+ * @brief Enables the region of interest mode in Executable mode
+ * @param desc the description we wish to use
+ */
+void Description_roiEnable (SDescription *desc);
+
+/**
+ * @brief Disables the region of interest mode in Executable mode
+ * @param desc the description we wish to use
+ */
+void Description_roiDisable (SDescription *desc);
+
+/**
+ * @brief Check if the region of interest mode is enabled or not
+ * @param desc the description we wish to use
+ * @return Whether or not the evaluation libraries are driven by the ml_roi_begin/ml_roi_end markers of the target
+ */
+int Description_isRoiEnabled (SDescription *desc);
+
+/**
+ * @brief Sets the perf events counted on the executed program
+ * @param desc the description we wish to use
+ * @param value the comma separated event list (can be NULL)
+ */
+void Description_setChildEvents (SDescription *desc, char *value);
+
+/**
+ * @brief Gets the perf events counted on the executed program
+ * @param desc the description we wish to use
+ * @return the comma separated event list (can be NULL)
+ */
+char *Description_getChildEvents (SDescription *desc);
+
+/**
+ * @brief Enables the report of the resource usage of the executed program
+ * @param desc the description we wish to use
+ */
+void Description_rusageEnable (SDescription *desc);
+
+/**
+ * @brief Disables the report of the resource usage of the executed program
+ * @param desc the description we wish to use
+ */
+void Description_rusageDisable (SDescription *desc);
+
+/**
+ * @brief Check if the resource usage of the executed program is reported or not
+ * @param desc the description we wish to use
+ * @return Whether or not the resource usage is reported
+ */
+int Description_isRusageEnabled (SDescription *desc);
+
 /**
  * @brief Enables the "all processes are going to make an output file" mode
  * @param desc the description we wish to use
@@ -0,0 +1,36 @@
+#ifndef H_DRIVER
+#define H_DRIVER
+
+#include <stddef.h>
+
+/* Symbol of the generated driver in the kernel library */
+#define DRIVER_FUNCTION_NAME "microlaunch_driver"
+
+/* Version of the generated code, part of the compilation cache key */
+#define DRIVER_VERSION 1
+
+/**
+ * @brief the driver function pointer type: runs the kernel repetitions times and reads the time stamp counter around the loop
+ * @param repetitions the number of calls of the kernel
+ * @param vectorSizes the size of each vector
+ * @param elemSize the size of the elements of the vectors
+ * @param vectors the vectors
+ * @param cycles filled with the number of cycles spent in the loop
+ * @return the value returned by the last call of the kernel (its number of iterations)
+ */
+typedef unsigned long (*driver_fctptr) (unsigned long repetitions, unsigned long *vectorSizes, unsigned elemSize, void **vectors, unsigned long long *cycles);
+
+//Advance declaration
+struct sDescription;
+
+/**
+ * @brief Generates the source of the driver, specialised for the kernel function and the number of vectors
+ * @param desc the SDescription of the run
+ * @param fileName the file the source is written in
+ * @param tag filled with a string identifying the generated code (for the compilation cache)
+ * @param size the size of tag
+ * @return 0 on success, -1 otherwise
+ */
+int Driver_generate (struct sDescription *desc, const char *fileName, char *tag, size_t size);
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef H_FLUSH
+#define H_FLUSH
+
+#include <stddef.h>
+
+/* Size of a cache line, in octets */
+#define FLUSH_LINE_SIZE 64
+
+/* The eviction buffer is this many times larger than the targeted cache */
+#define FLUSH_EVICT_FACTOR 2
+
+/* Cache sizes used when they cannot be detected (see Topology.h), in octets */
+#define FLUSH_DEFAULT_L1_SIZE (32 * 1024)
+#define FLUSH_DEFAULT_L2_SIZE (256 * 1024)
+#define FLUSH_DEFAULT_LLC_SIZE (8 * 1024 * 1024)
+
+/* Maximum number of threads streaming over a LLC eviction buffer besides the measuring one */
+#define FLUSH_MAX_HELPERS 3
+
+/* Maximum number of lines probed per vector by the verification */
+#define FLUSH_PROBED_LINES 1024
+
+/* Percentage of residual hits above which the verification warns */
+#define FLUSH_RESIDUAL_WARNING 1.0
+
+/**
+ * @brief How the caches are flushed before each meta-repetition
+ */
+typedef enum eFlushStrategy
+{
+	FLUSH_READ = 0,		/**< @brief Sum over the --sizedummy dummy array */
+	FLUSH_CLFLUSH,		/**< @brief clflushopt (or clflush) over every line of the vectors */
+	FLUSH_EVICT,		/**< @brief Streaming reads over a buffer sized from the targeted cache level */
+	FLUSH_NONE,			/**< @brief No flush, the measures are warm */
+	FLUSH_CLWB			/**< @brief clwb over every line of the vectors: they are written back to memory but stay cached */
+} EFlushStrategy;
+
+/**
+ * @brief Instruction used to flush a cache line
+ */
+typedef enum eFlushInstruction
+{
+	FLUSH_INSN_CLFLUSH = 0,	/**< @brief Ordered write back and invalidation */
+	FLUSH_INSN_CLFLUSHOPT,	/**< @brief Weakly ordered write back and invalidation */
+	FLUSH_INSN_CLWB			/**< @brief Weakly ordered write back, the line may stay cached */
+} EFlushInstruction;
+
+/**
+ * @brief Cache level the vectors have to be evicted from
+ */
+typedef enum eFlushLevel
+{
+	FLUSH_LEVEL_L1 = 0,	/**< @brief Evicted from the L1 data cache only */
+	FLUSH_LEVEL_L2,		/**< @brief Evicted from the L1 and L2 caches */
+	FLUSH_LEVEL_LLC,	/**< @brief Evicted from every cache level */
+	FLUSH_LEVEL_MEMORY	/**< @brief Evicted from every cache level, then the vectors are flushed to memory */
+} EFlushLevel;
+
+//Advance declaration
+struct sDescription;
+
+/**
+ * @brief struct sFlush holds the buffers and the calibration of the flush
+ */
+typedef struct sFlush
+{
+	EFlushStrategy strategy;	/**< @brief The flush strategy */
+	EFlushLevel level;			/**< @brief The targeted level (evict strategy) */
+	EFlushInstruction instruction;	/**< @brief The instruction flushing the lines of the vectors */
+	EFlushInstruction evictInstruction;	/**< @brief The instruction evicting a line (clflushopt when the processor has it) */
+	double *dummy;				/**< @brief The dummy array (read strategy) */
+	unsigned long dummySize;	/**< @brief The dummy array size (read strategy) */
+	char *buffer;				/**< @brief The eviction buffer */
+	size_t bufferSize;			/**< @brief The eviction buffer size, in octets */
+	struct sFlushHelpers *helpers;	/**< @brief The threads streaming over an LLC sized buffer with the measuring one (NULL if none) */
+	int verify;					/**< @brief Whether or not the flushes are verified */
+	char *canary;				/**< @brief Buffer touched before each flush and probed after it */
+	size_t canarySize;			/**< @brief The canary buffer size, in octets */
+	unsigned long threshold;	/**< @brief Latency under which a probed line is a hit, in cycles */
+	unsigned long probed;		/**< @brief Number of lines probed since the last report */
+	unsigned long hits;			/**< @brief Number of probed lines found in the targeted caches since the last report */
+} SFlush;
+
+/**
+ * @brief Creates the flush described by the SDescription (the dummy array has to be set for the read strategy)
+ * @param desc the SDescription of the run
+ * @return the flush
+ */
+SFlush *Flush_create (struct sDescription *desc);
+
+/**
+ * @brief Releases a flush
+ * @param flush the flush (can be NULL)
+ */
+void Flush_destroy (SFlush *flush);
+
+/**
+ * @brief Flushes the caches before a measure
+ * @param flush the flush (nothing is done if NULL)
+ * @param desc the SDescription giving the vector sizes
+ * @param arrays the vectors of the kernel (NULL in exec mode)
+ */
+void Flush_caches (SFlush *flush, struct sDescription *desc, void **arrays);
+
+/**
+ * @brief Reports the residual hits found by the verification since the last report, then resets them
+ * @param flush the flush (nothing is done if NULL)
+ * @param isPrintingProcess whether or not the current process has to print something
+ */
+void Flush_report (SFlush *flush, int isPrintingProcess);
+
+#endif
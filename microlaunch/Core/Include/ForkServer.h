@@ -0,0 +1,55 @@
+#ifndef H_FORKSERVER
+#define H_FORKSERVER
+
+#include <sys/resource.h>
+#include <sys/types.h>
+
+/* Environment variables giving the fork server its pipe ends */
+#define FORKSERVER_ENV_CTL "ML_FORKSERVER_CTL"
+#define FORKSERVER_ENV_STATUS "ML_FORKSERVER_STATUS"
+
+/* Path of the preloaded stub, relative to MLDIR */
+#define FORKSERVER_LIB_PATH "Libraries/forkserver/forkserver.so"
+
+/* Commands sent to the fork server */
+enum ForkServerCommand { FORKSERVER_QUIT = 0, FORKSERVER_RUN };
+
+//Advance declaration
+struct sDescription;
+
+/**
+ * @brief struct sForkServer describes a target stopped before its main function
+ */
+typedef struct sForkServer
+{
+	pid_t pid;		/**< @brief The fork server process */
+	int ctl;		/**< @brief Pipe end used to send commands */
+	int status;		/**< @brief Pipe end used to receive the pids and exit statuses */
+	pid_t lastChild;	/**< @brief The pid of the last forked copy */
+	struct rusage usage;	/**< @brief The resource usage of the last forked copy */
+} SForkServer;
+
+/**
+ * @brief Launches a target with the fork server stub preloaded and waits for it to reach its main function
+ * @param desc the SDescription describing the program
+ * @param fileName the executable to launch
+ * @param overhead whether or not the current execution is overhead computation
+ * @param isPrintingProcess whether or not the current process has to print something
+ * @return the fork server
+ */
+SForkServer *ForkServer_start (struct sDescription *desc, char *fileName, int overhead, int isPrintingProcess);
+
+/**
+ * @brief Runs a fresh copy of the target and waits for its end
+ * @param server the fork server
+ * @return the exit status of the copy
+ */
+int ForkServer_run (SForkServer *server);
+
+/**
+ * @brief Stops the fork server and releases it
+ * @param server the fork server (can be NULL)
+ */
+void ForkServer_stop (SForkServer *server);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef H_PERFEVENTS
+#define H_PERFEVENTS
+
+#include <sys/types.h>
+#include <linux/perf_event.h>
+
+/**
+ * @brief Fills a perf_event_attr from a human readable event name
+ *
+ * Accepted names are the generic hardware, software and cache events as named by perf
+ * (cycles, instructions, LLC-load-misses, page-faults...) or a raw event ("r01c2").
+ * A ":u" or ":k" suffix restricts counting to user or kernel level, the default being user level only.
+ *
+ * @param name the event name
+ * @param attr the attribute structure to fill (it is cleared first)
+ * @return 0 on success, -1 if the event name is unknown
+ */
+int PerfEvents_parseEvent (const char *name, struct perf_event_attr *attr);
+
+/**
+ * @brief Wrapper around the perf_event_open system call
+ * @param attr the event attributes
+ * @param pid the process to monitor (0 for the calling one)
+ * @param cpu the cpu to monitor (-1 for any)
+ * @param groupFd the group leader file descriptor (-1 to create a new group)
+ * @param flags the perf_event_open flags
+ * @return the file descriptor of the event, -1 on error (errno is set)
+ */
+int PerfEvents_open (struct perf_event_attr *attr, pid_t pid, int cpu, int groupFd, unsigned long flags);
+
+/**
+ * @brief Splits a list in place and returns the number of tokens found
+ * @param list the string to be split (modified)
+ * @param separator the separator character
+ * @param tokens the array receiving the tokens (can be NULL to only count them)
+ * @param max the size of the tokens array
+ * @return the number of tokens in the list
+ */
+unsigned PerfEvents_splitList (char *list, char separator, char **tokens, unsigned max);
+
+#endif
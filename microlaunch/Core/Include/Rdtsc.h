@@ -8,6 +8,20 @@
 			asm volatile("rdtsc" : "=a" (__a), "=d" (__d)); \
 			(val) = ((unsigned long)__a) | (((unsigned long)__d)<<32); \
 	} while(0)
+
+	// Serialized versions: no earlier instruction can be executed after the start read,
+	// and no later instruction can be executed before the stop read
+	#define rdtscll_start(val) do { \
+			unsigned int __a,__d; \
+			asm volatile("lfence\n\trdtsc" : "=a" (__a), "=d" (__d) :: "memory"); \
+			(val) = ((unsigned long)__a) | (((unsigned long)__d)<<32); \
+	} while(0)
+
+	#define rdtscpll_stop(val) do { \
+			unsigned int __a,__d; \
+			asm volatile("rdtscp\n\tlfence" : "=a" (__a), "=d" (__d) :: "rcx", "memory"); \
+			(val) = ((unsigned long)__a) | (((unsigned long)__d)<<32); \
+	} while(0)
 #endif
 
 // Define rdtscll for i386 arch
@@ -15,6 +29,14 @@
 	#define rdtscll(val) { \
 		asm volatile ("rdtsc" : "=A"(val)); \
 		}
+
+	#define rdtscll_start(val) { \
+		asm volatile ("lfence\n\trdtsc" : "=A"(val) :: "memory"); \
+		}
+
+	#define rdtscpll_stop(val) { \
+		asm volatile ("rdtscp\n\tlfence" : "=A"(val) :: "ecx", "memory"); \
+		}
 #endif
 
 #endif
@@ -0,0 +1,120 @@
+#ifndef H_RESULTSINK
+#define H_RESULTSINK
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Binary result file (native byte order):
+ *  - header: RESULTSINK_MAGIC (8 bytes), version (uint32), number of columns (uint32)
+ *  - for each column: kind (uint32), name length (uint32), name (not terminated)
+ *  - blocks until the end of the file: number of rows (uint32), then the values of each column (nbRows doubles per column)
+ */
+#define RESULTSINK_MAGIC "MLRESULT"
+#define RESULTSINK_VERSION 1
+
+/* Extension of the binary result files */
+#define RESULTSINK_BINARY_EXTENSION ".mlr"
+
+/* Number of rows kept in memory before being written */
+#define RESULTSINK_ROWS 4096
+
+/**
+ * @brief How a column is printed in the CSV
+ */
+typedef enum eResultColumnKind
+{
+	RESULT_COLUMN_REAL = 0,	/**< @brief Printed with 6 decimals */
+	RESULT_COLUMN_INTEGER,	/**< @brief Printed without decimals */
+	RESULT_COLUMN_ERROR,	/**< @brief Error code without header, only printed when it is not 0 */
+	RESULT_COLUMN_NB_KINDS
+} EResultColumnKind;
+
+/**
+ * @brief struct sResultColumn describes a column of the results
+ */
+typedef struct sResultColumn
+{
+	char *name;		/**< @brief Name of the column (CSV header) */
+	unsigned kind;	/**< @brief Kind of the column (see EResultColumnKind) */
+} SResultColumn;
+
+/**
+ * @brief struct sResultSink accumulates the result rows and writes them by blocks
+ */
+typedef struct sResultSink
+{
+	int binary;				/**< @brief Whether the file is a binary result file or a CSV */
+	FILE *file;				/**< @brief The output file */
+	unsigned nbColumns;		/**< @brief Number of columns of the schema */
+	SResultColumn *columns;	/**< @brief The schema */
+	unsigned capacity;		/**< @brief Number of rows of the buffer */
+	unsigned nbRows;		/**< @brief Number of complete rows in the buffer */
+	unsigned current;		/**< @brief Next column of the row being filled */
+	double *values;			/**< @brief The buffer, column by column: values[column * capacity + row] (NULL until the first value) */
+	int headerWritten;		/**< @brief Whether the header was already written */
+	int error;				/**< @brief Whether a write failed */
+} SResultSink;
+
+/**
+ * @brief Creates a result sink writing in a file
+ * @param fileName the name of the output file
+ * @param binary whether the results are written in the binary format or as a CSV
+ * @return the sink, NULL if the file cannot be opened
+ */
+SResultSink *ResultSink_create (const char *fileName, int binary);
+
+/**
+ * @brief Adds a column to the schema, before the first value
+ * @param sink the sink
+ * @param name the column name
+ * @param kind how the column is printed (see EResultColumnKind)
+ */
+void ResultSink_addColumn (SResultSink *sink, const char *name, EResultColumnKind kind);
+
+/**
+ * @brief Gives the value of the next column of the current row
+ * @param sink the sink
+ * @param value the value
+ */
+void ResultSink_put (SResultSink *sink, double value);
+
+/**
+ * @brief Ends the current row, the buffer is only written once full (or on ResultSink_flush)
+ * @param sink the sink
+ */
+void ResultSink_endRow (SResultSink *sink);
+
+/**
+ * @brief Writes the buffered rows
+ * @param sink the sink
+ * @return 0 on success, -1 if a write failed
+ */
+int ResultSink_flush (SResultSink *sink);
+
+/**
+ * @brief Writes the buffered rows, closes the file and releases the sink
+ * @param sink the sink (can be NULL)
+ * @return 0 on success, -1 if a write failed
+ */
+int ResultSink_destroy (SResultSink *sink);
+
+/**
+ * @brief Converts a binary result file in the CSV microlaunch would have written
+ * @param fileName the binary result file
+ * @param csv the CSV output stream
+ * @return 0 on success, -1 if the file is not a valid binary result file
+ */
+int ResultSink_convert (const char *fileName, FILE *csv);
+
+/**
+ * @brief Merges binary result files having the same schema, the rows are ordered by the values of a column (ties keep the file order)
+ * @param fileNames the binary result files
+ * @param nbFiles the number of files
+ * @param key the name of the column the rows are ordered by (the file order is kept if no column has this name)
+ * @param output the sink the rows are written to, its schema is taken from the first file if it has none
+ * @return 0 on success, -1 if a file is not a valid binary result file or does not have the schema of the others
+ */
+int ResultSink_merge (char **fileNames, unsigned nbFiles, const char *key, SResultSink *output);
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef H_ROI
+#define H_ROI
+
+#include "BenchResult.h"
+
+/* Environment variables read by the preloaded library in the target */
+#define ROI_ENV_FD "ML_ROI_FD"
+#define ROI_ENV_EVALLIBS "ML_ROI_EVALLIBS"
+#define ROI_ENV_EMPTY "ML_ROI_EMPTY"
+
+/* Path of the preloaded library, relative to MLDIR */
+#define ROI_LIB_PATH "Libraries/roi/roi.so"
+
+/* Limits of the shared channel */
+#define ROI_MAX_EVALLIBS 16
+#define ROI_MAX_COUNTERS 32
+
+/**
+ * @brief struct sRoiChannel is the memory shared between microlaunch and the target
+ *
+ * The target accumulates every region it went through; microlaunch resets the channel before each sample
+ * and reads it once the target ended (waitpid orders the accesses).
+ */
+typedef struct sRoiChannel
+{
+	unsigned nbRegions;							/**< @brief Number of ml_roi_begin/ml_roi_end regions measured */
+	unsigned nbEvalLibs;						/**< @brief Number of evaluation libraries loaded by the target */
+	unsigned nbCounters[ROI_MAX_EVALLIBS];		/**< @brief Number of counters of each evaluation library */
+	double values[ROI_MAX_EVALLIBS];			/**< @brief Main value of each evaluation library (stop - start) */
+	double counters[ROI_MAX_EVALLIBS][ROI_MAX_COUNTERS];	/**< @brief Counters of each evaluation library */
+} SRoiChannel;
+
+//Advance declaration
+struct sDescription;
+
+/**
+ * @brief struct sRoi is the microlaunch side of the region of interest mode
+ */
+typedef struct sRoi
+{
+	int fd;						/**< @brief File descriptor of the channel, inherited by the targets */
+	SRoiChannel *channel;		/**< @brief The shared channel */
+	char *previousPreload;		/**< @brief LD_PRELOAD before the ROI library was added (can be NULL) */
+} SRoi;
+
+/**
+ * @brief Creates the shared channel and sets the environment so that the executed programs preload the ROI library
+ * @param desc the SDescription describing the program
+ * @return the region of interest handler
+ */
+SRoi *Roi_create (struct sDescription *desc);
+
+/**
+ * @brief Resets the channel before a sample
+ * @param roi the region of interest handler
+ */
+void Roi_reset (SRoi *roi);
+
+/**
+ * @brief Asks the target to measure one empty region (overhead computation)
+ * @param roi the region of interest handler
+ * @param empty whether or not the executed programs have to measure an empty region
+ */
+void Roi_setEmpty (SRoi *roi, int empty);
+
+/**
+ * @brief Stores the values sent by the target
+ * @param roi the region of interest handler
+ * @param res the results (one per evaluation library)
+ * @param nbEvalLibs the number of evaluation libraries
+ * @param idX the current meta-repetition
+ * @return the number of regions the target went through
+ */
+unsigned Roi_store (SRoi *roi, BenchResult **res, unsigned nbEvalLibs, unsigned idX);
+
+/**
+ * @brief Releases the channel and restores the environment
+ * @param roi the region of interest handler (can be NULL)
+ */
+void Roi_destroy (SRoi *roi);
+
+#endif
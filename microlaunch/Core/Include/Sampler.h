@@ -0,0 +1,126 @@
+#ifndef H_SAMPLER
+#define H_SAMPLER
+
+#include <stdint.h>
+
+//Advance declaration
+struct sDescription;
+
+/* Default share of the alignment configurations measured when sampling */
+#define SAMPLER_DEFAULT_RATIO 20
+
+/* Configuration left by an interrupted run: measured, but not known any more */
+#define SAMPLER_UNKNOWN UINT64_MAX
+
+/* Default relative deviation from the neighbours above which the adaptive sampler refines a configuration */
+#define SAMPLER_DEFAULT_THRESHOLD 0.1
+
+/**
+ * @brief How the alignment configurations of a vector size are chosen
+ */
+typedef enum eSamplerMode
+{
+	SAMPLER_FULL = 0,	/**< @brief Every configuration, in Benchmark_next order */
+	SAMPLER_RANDOM,		/**< @brief Uniform random configurations, without replacement */
+	SAMPLER_LHS,		/**< @brief Latin hypercube: each vector covers its alignment range evenly */
+	SAMPLER_ADAPTIVE	/**< @brief A Latin hypercube of half the budget, then the neighbours of the configurations deviating from theirs */
+} ESamplerMode;
+
+/**
+ * @brief struct sSampler holds the configurations measured for the current vector size
+ */
+typedef struct sSampler
+{
+	int mode;					/**< @brief The ESamplerMode */
+	unsigned nbVectors;			/**< @brief Number of dimensions of the alignment space */
+	unsigned *nbLevels;			/**< @brief Number of alignments of each vector */
+	int *start;					/**< @brief First alignment of each vector */
+	int *step;					/**< @brief Alignment step of each vector */
+	uint64_t nbConfigurations;	/**< @brief Number of configurations of the full product */
+	unsigned budget;			/**< @brief Number of configurations measured per vector size */
+	unsigned nbBase;			/**< @brief Number of configurations drawn before any measure */
+	double threshold;			/**< @brief Relative deviation refined by the adaptive mode */
+	uint64_t seed;				/**< @brief Seed of the draws */
+	uint64_t rng;				/**< @brief Current state of the generator */
+	unsigned nbPoints;			/**< @brief Number of configurations in the list */
+	uint64_t *points;			/**< @brief The configurations in measurement order, as indices in the full product (last vector fastest) */
+	double *timings;			/**< @brief Measured value of each configuration (NAN until measured) */
+	int *refined;				/**< @brief Whether or not the neighbours of each configuration were already added */
+	double *deviations;			/**< @brief Relative deviation of each configuration from its nearest measured ones (NAN if unknown) */
+	unsigned nbScored;			/**< @brief Number of configurations of the list whose deviation is computed */
+	uint64_t *drawn;			/**< @brief Open addressing set of the configurations in the list (index + 1, 0 if empty) */
+	unsigned drawnSize;			/**< @brief Size of the set, a power of two */
+	unsigned position;			/**< @brief Index of the next configuration to measure */
+} SSampler;
+
+/**
+ * @brief Creates the sampler of the alignment space described by the vectors
+ * @param desc the description (vector ranges and sampling options)
+ * @return the sampler, NULL if every configuration is measured or there is no vector
+ */
+SSampler *Sampler_create (struct sDescription *desc);
+
+/**
+ * @brief Releases a sampler
+ * @param sampler the sampler (can be NULL)
+ */
+void Sampler_destroy (SSampler *sampler);
+
+/**
+ * @brief Starts a new vector size: the drawn configurations are kept, the refinements are dropped
+ * @param sampler the sampler
+ */
+void Sampler_restart (SSampler *sampler);
+
+/**
+ * @brief Moves to a position of the configuration list, for the resume system
+ * @param sampler the sampler
+ * @param position the index of the next configuration to measure (the refinements measured before an interruption are skipped)
+ */
+void Sampler_seek (SSampler *sampler, unsigned position);
+
+/**
+ * @brief Gives the index of the next configuration to measure
+ * @param sampler the sampler
+ * @return the position
+ */
+unsigned Sampler_getPosition (const SSampler *sampler);
+
+/**
+ * @brief Gives the next configuration to measure
+ * @param sampler the sampler
+ * @param state filled with the alignment of each vector
+ * @return 0 on success, -1 once the budget of the vector size is spent
+ */
+int Sampler_next (SSampler *sampler, int *state);
+
+/**
+ * @brief Records the measure of the configuration given by the last Sampler_next
+ * @param sampler the sampler
+ * @param value the measure (median of the meta-repetitions)
+ */
+void Sampler_record (SSampler *sampler, double value);
+
+/**
+ * @brief Gives a drawn configuration, in any order (the adaptive mode cannot be used this way)
+ * @param sampler the sampler
+ * @param idx the index of the configuration, lower than the budget
+ * @param state filled with the alignment of each vector
+ */
+void Sampler_getConfiguration (const SSampler *sampler, unsigned idx, int *state);
+
+/**
+ * @brief Gives the number of alignments of a vector, as enumerated by Benchmark_next
+ * @param vect the vector description (start, stop, step)
+ * @return the number of alignments
+ */
+unsigned Sampler_getNbLevels (const int *vect);
+
+/**
+ * @brief Gives the number of configurations measured per vector size
+ * @param desc the description
+ * @return the full product of the alignments (saturated to UINT64_MAX), or the sampling budget
+ */
+uint64_t Sampler_getNbSamples (struct sDescription *desc);
+
+#endif
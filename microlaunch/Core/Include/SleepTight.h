@@ -26,4 +26,10 @@ int sleep_tight_preparesignals ();
  */
 void escape_from_scary_killers ();
 
+/**
+ * @brief Tells whether a stop was requested by a signal (SIGTERM), without any system call
+ * @return Returns 1 if Microlauncher has to stop, 0 otherwise
+ */
+int escape_requested ();
+
 #endif
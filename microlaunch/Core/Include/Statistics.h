@@ -0,0 +1,101 @@
+#ifndef H_STATISTICS
+#define H_STATISTICS
+
+/**
+ * @brief Precision criteria usable to stop the meta-repetitions
+ */
+typedef enum eAdaptiveCriterion
+{
+	ADAPTIVE_CI = 0,	/**< @brief Half-width of the 95% confidence interval of the mean, relative to the mean */
+	ADAPTIVE_MAD		/**< @brief Median absolute deviation, relative to the median */
+} EAdaptiveCriterion;
+
+/**
+ * @brief Summary of a sample, as written in the statistics files
+ */
+typedef struct sStatisticsSummary
+{
+	unsigned n;			/**< @brief Number of values in the sample */
+	double min;			/**< @brief Minimum */
+	double p5;			/**< @brief 5th percentile */
+	double p25;			/**< @brief First quartile */
+	double median;		/**< @brief Median */
+	double p75;			/**< @brief Third quartile */
+	double p95;			/**< @brief 95th percentile */
+	double max;			/**< @brief Maximum */
+	double mean;		/**< @brief Arithmetic mean */
+	double stddev;		/**< @brief Standard deviation */
+	double mad;			/**< @brief Median absolute deviation */
+	double medianLow;	/**< @brief Lower bound of the bootstrap 95% confidence interval of the median */
+	double medianHigh;	/**< @brief Upper bound of the bootstrap 95% confidence interval of the median */
+} SStatisticsSummary;
+
+/**
+ * @brief Computes the arithmetic mean of a sample
+ * @param values the sample
+ * @param n the number of values in the sample
+ * @return the mean, 0 if the sample is empty
+ */
+double Statistics_mean (const double *values, unsigned n);
+
+/**
+ * @brief Computes the (unbiased) standard deviation of a sample
+ * @param values the sample
+ * @param n the number of values in the sample
+ * @return the standard deviation, 0 if the sample has less than two values
+ */
+double Statistics_stddev (const double *values, unsigned n);
+
+/**
+ * @brief Computes the median of a sample
+ * @param values the sample (left untouched)
+ * @param n the number of values in the sample
+ * @return the median, 0 if the sample is empty
+ */
+double Statistics_median (const double *values, unsigned n);
+
+/**
+ * @brief Computes a percentile of a sample (linear interpolation between the closest ranks)
+ * @param values the sample (left untouched)
+ * @param n the number of values in the sample
+ * @param percent the percentile wanted, between 0 and 100
+ * @return the percentile, 0 if the sample is empty
+ */
+double Statistics_percentile (const double *values, unsigned n, double percent);
+
+/**
+ * @brief Computes the median absolute deviation of a sample
+ * @param values the sample (left untouched)
+ * @param n the number of values in the sample
+ * @return the median absolute deviation, 0 if the sample is empty
+ */
+double Statistics_mad (const double *values, unsigned n);
+
+/**
+ * @brief Computes the relative precision reached by a sample
+ * @param values the sample (left untouched)
+ * @param n the number of values in the sample
+ * @param criterion the precision criterion (see EAdaptiveCriterion)
+ * @return the relative precision (lower is better), -1 if it cannot be computed
+ */
+double Statistics_relativePrecision (const double *values, unsigned n, EAdaptiveCriterion criterion);
+
+/**
+ * @brief Computes a bootstrap percentile confidence interval of the median of a sample
+ * @param values the sample (left untouched)
+ * @param n the number of values in the sample
+ * @param confidence the confidence level (e.g. 0.95)
+ * @param low the lower bound of the interval
+ * @param high the upper bound of the interval
+ */
+void Statistics_bootstrapMedian (const double *values, unsigned n, double confidence, double *low, double *high);
+
+/**
+ * @brief Computes the summary of a sample
+ * @param values the sample (left untouched)
+ * @param n the number of values in the sample
+ * @param summary the summary to be filled
+ */
+void Statistics_summarize (const double *values, unsigned n, SStatisticsSummary *summary);
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef H_STEPPING
+#define H_STEPPING
+
+//Advance declaration
+struct sDescription;
+
+/* Default ratio between two consecutive vector sizes of the geometric progression */
+#define STEPPING_DEFAULT_RATIO 1.25
+
+/* Default relative difference between consecutive vector sizes above which the adaptive mode bisects their interval */
+#define STEPPING_DEFAULT_THRESHOLD 0.1
+
+/* Vector size left by an interrupted run: measured, but not known any more */
+#define STEPPING_UNKNOWN -1
+
+/**
+ * @brief How the vector sizes between --startvector and --endvector are chosen
+ */
+typedef enum eSteppingMode
+{
+	STEPPING_LINEAR = 0,	/**< @brief Every --stepvector */
+	STEPPING_GEOMETRIC,		/**< @brief Each size is the previous one times the ratio, rounded to --stepvector */
+	STEPPING_ADAPTIVE		/**< @brief The geometric sizes, then the bisection of the intervals whose measures differ the most */
+} ESteppingMode;
+
+/**
+ * @brief struct sStepping holds the vector sizes measured for the current kernel
+ */
+typedef struct sStepping
+{
+	int mode;				/**< @brief The ESteppingMode */
+	int start;				/**< @brief First vector size */
+	int end;				/**< @brief Last vector size (included) */
+	int step;				/**< @brief Every size is start plus a multiple of step */
+	double threshold;		/**< @brief Relative difference bisected by the adaptive mode */
+	unsigned budget;		/**< @brief Number of vector sizes measured */
+	unsigned nbBase;		/**< @brief Number of sizes of the geometric progression */
+	unsigned nbPoints;		/**< @brief Number of sizes in the list */
+	unsigned position;		/**< @brief Index of the next size to measure */
+	int *sizes;				/**< @brief The sizes in measurement order */
+	double *sums;			/**< @brief Sum of the measures of each size */
+	unsigned *counts;		/**< @brief Number of measures of each size */
+} SStepping;
+
+/**
+ * @brief Creates the vector size stepping of the description
+ * @param desc the description (size range and stepping options)
+ * @return the stepping, NULL in linear mode
+ */
+SStepping *Stepping_create (struct sDescription *desc);
+
+/**
+ * @brief Releases a stepping
+ * @param stepping the stepping (can be NULL)
+ */
+void Stepping_destroy (SStepping *stepping);
+
+/**
+ * @brief Starts a new kernel: the progression is kept, the bisections are dropped
+ * @param stepping the stepping
+ */
+void Stepping_restart (SStepping *stepping);
+
+/**
+ * @brief Moves to a position of the size list, for the resume system
+ * @param stepping the stepping
+ * @param position the index of the next size to measure
+ * @param size the size at this index (the bisections measured before an interruption are otherwise skipped)
+ */
+void Stepping_seek (SStepping *stepping, unsigned position, int size);
+
+/**
+ * @brief Gives the index of the next size to measure
+ * @param stepping the stepping
+ * @return the position
+ */
+unsigned Stepping_getPosition (const SStepping *stepping);
+
+/**
+ * @brief Gives the next vector size to measure
+ * @param stepping the stepping
+ * @return the size, -1 once the budget is spent
+ */
+int Stepping_next (SStepping *stepping);
+
+/**
+ * @brief Records a measure of the size given by the last Stepping_next (one per alignment configuration)
+ * @param stepping the stepping
+ * @param value the measure (median of the meta-repetitions)
+ */
+void Stepping_record (SStepping *stepping, double value);
+
+/**
+ * @brief Gives the number of vector sizes measured per kernel
+ * @param desc the description
+ * @return the number of sizes
+ */
+unsigned Stepping_getNbSizes (struct sDescription *desc);
+
+/**
+ * @brief Gives a size of the linear or geometric progression, in any order (the adaptive mode cannot be used this way)
+ * @param desc the description
+ * @param idx the index of the size, lower than Stepping_getNbSizes
+ * @return the size
+ */
+int Stepping_getSize (struct sDescription *desc, unsigned idx);
+
+#endif
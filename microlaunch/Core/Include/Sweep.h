@@ -0,0 +1,96 @@
+#ifndef H_SWEEP
+#define H_SWEEP
+
+#include <stdint.h>
+
+//Advance declaration
+struct sDescription;
+
+/* Suffix of the files written by each worker, merged by the father once the sweep is over */
+#define SWEEP_PART_SUFFIX "_part"
+
+/**
+ * @brief Processors the sweep workers are spread on
+ */
+typedef enum eSweepIsolation
+{
+	SWEEP_ISOLATION_CPU = 0,	/**< @brief Every available processor */
+	SWEEP_ISOLATION_CORE,		/**< @brief One processor per physical core, no SMT sibling is shared */
+	SWEEP_ISOLATION_L2			/**< @brief One processor per L2 cache */
+} ESweepIsolation;
+
+/**
+ * @brief Points left to a worker, one cache line per worker
+ */
+typedef struct sSweepDeque
+{
+	volatile uint64_t range;		/**< @brief First point in the low 32 bits, end of the range (excluded) in the high ones */
+	uint64_t padding[7];
+} SSweepDeque;
+
+/**
+ * @brief struct sSweep lives in a shared anonymous mapping, created by the father before the workers
+ */
+typedef struct sSweep
+{
+	unsigned nbWorkers;				/**< @brief Number of workers */
+	unsigned nbPoints;				/**< @brief Number of (vector size, alignment) points of the sweep */
+	uint32_t padding[14];
+	SSweepDeque deques[];			/**< @brief One deque per worker */
+} SSweep;
+
+/**
+ * @brief Creates the work queue, to be called before the workers are forked
+ * @param nbWorkers the number of workers
+ * @param nbPoints the number of points of the sweep
+ * @return the work queue
+ */
+SSweep *Sweep_create (unsigned nbWorkers, unsigned nbPoints);
+
+/**
+ * @brief Releases the work queue
+ * @param sweep the work queue (can be NULL)
+ */
+void Sweep_destroy (SSweep *sweep);
+
+/**
+ * @brief Deals the points again, one contiguous chunk per worker
+ * @param sweep the work queue
+ * @param nbPoints the number of points of the next sweep
+ */
+void Sweep_reset (SSweep *sweep, unsigned nbPoints);
+
+/**
+ * @brief Takes the next point of a worker, steals half of the points left to the most loaded worker once its own chunk is done
+ * @param sweep the work queue
+ * @param worker the id of the calling worker
+ * @return the point, -1 once the sweep is over
+ */
+int Sweep_take (SSweep *sweep, unsigned worker);
+
+/**
+ * @brief Gives the number of points of the sweep of the current kernel
+ * @param desc the description (vector ranges and size range)
+ * @return the number of points
+ */
+unsigned Sweep_getNbPoints (struct sDescription *desc);
+
+/**
+ * @brief Decodes a point, the last vector alignment varies fastest as in Benchmark_next
+ * @param desc the description
+ * @param point the point
+ * @param state filled with the alignment of each vector
+ * @return the vector size of the point
+ */
+int Sweep_decode (struct sDescription *desc, unsigned point, int *state);
+
+/**
+ * @brief Gives the processors the workers can be pinned on
+ * @param isolation the ESweepIsolation
+ * @param cpus filled with the processors
+ * @param max the size of cpus
+ * @return the number of processors
+ */
+int Sweep_getCpus (int isolation, int *cpus, int max);
+
+#endif
@@ -75,8 +75,8 @@ void parseVectorSizes (struct sDescription *desc, char *src);
 void parseCPUPinning (struct sDescription *desc, char *src);
 
 /**
- * @brief Returns the cache size of the machine
- * @return Returns the cache size of the machine
+ * @brief Returns the last level cache size of the machine (see Topology.h)
+ * @return Returns the cache size of the machine, in KB
  */
 int getCacheSize (void);
 
@@ -88,19 +88,26 @@ int getMemorySpaceToAllocated (struct sDescription *desc);
 
 /**
  * @brief Allows the program to make a barrier from the son way (child processes)
- @param pipeSF : the pipe for Son->Child communication
- @param pipeFS : the pipe for Child->Son communication */
-void barrierS (int pipeSF[2], int pipeFS[2]);
+ @param desc : the description of the child (holds its pipes or the shared barrier) */
+void barrierS (struct sDescription *desc);
 
 /**
  * @brief Allows the program to make a barrier from the father way (master process)
- @param pipes table of pipes to communicate with every child process created
+ @param desc the description of the father (holds the shared barrier, if any)
+ @param pipes table of pipes to communicate with every child process created (pipe mode)
  @param nbprocess the table size to run through all the child processes created */
-void barrierF (SPipe *pipes, unsigned nbprocess);
+void barrierF (struct sDescription *desc, SPipe *pipes, unsigned nbprocess);
 
 /**
- * @brief Get the number of processors available from /proc/cpuinfo
- @return the number of processors available detected from /proc/cpuinfo */
+ * @brief Exports the thread placement of the pinning policy: ML_PIN_CPUS for the thread pinning library,
+ * OMP_PLACES, OMP_PROC_BIND and GOMP_CPU_AFFINITY in OpenMP mode, and logs the thread to processor map
+ * @param desc the SDescription of the run (nothing is exported with the linear policy)
+ */
+void exportThreadPinning (struct sDescription *desc);
+
+/**
+ * @brief Get the number of processors available (online and allowed by the cpuset cgroup, see Topology.h)
+ @return the number of processors available */
 int getNbProcessorsAvailable ( void );
 
 /**
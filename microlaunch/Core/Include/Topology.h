@@ -0,0 +1,149 @@
+#ifndef H_TOPOLOGY
+#define H_TOPOLOGY
+
+/* cpu_set_t needs _GNU_SOURCE to be defined before the first include */
+#include <sched.h>
+#include <stddef.h>
+
+/* Limits of the described machine */
+#define TOPOLOGY_MAX_CPUS CPU_SETSIZE
+#define TOPOLOGY_MAX_CACHES 8
+
+/* Environment variable giving the thread pinning library the ordered processors to pin the threads on */
+#define TOPOLOGY_ENV_PIN_CPUS "ML_PIN_CPUS"
+
+/**
+ * @brief Orders in which the threads are placed on the available processors
+ */
+typedef enum eTopologyPinPolicy
+{
+	TOPOLOGY_PIN_LINEAR = 0,	/**< @brief Processor identifier order */
+	TOPOLOGY_PIN_COMPACT,		/**< @brief SMT siblings first, then the next core of the package, then the next package */
+	TOPOLOGY_PIN_SCATTER,		/**< @brief One core of each package in turn, SMT siblings once every core is used */
+	TOPOLOGY_PIN_PHYSICAL,		/**< @brief One processor per physical core, compact order */
+	TOPOLOGY_PIN_SOCKET,		/**< @brief The processors of one package only, compact order */
+	TOPOLOGY_PIN_LIST			/**< @brief A list given by the user */
+} ETopologyPinPolicy;
+
+/**
+ * @brief Kinds of caches
+ */
+typedef enum eTopologyCacheType
+{
+	TOPOLOGY_CACHE_DATA = 0,		/**< @brief Data cache */
+	TOPOLOGY_CACHE_INSTRUCTION,		/**< @brief Instruction cache */
+	TOPOLOGY_CACHE_UNIFIED			/**< @brief Data and instructions */
+} ETopologyCacheType;
+
+/**
+ * @brief A cache of the first available processor
+ */
+typedef struct sTopologyCache
+{
+	int level;					/**< @brief Cache level, starting at 1 */
+	ETopologyCacheType type;	/**< @brief Kind of cache */
+	size_t size;				/**< @brief Capacity in octets */
+	unsigned lineSize;			/**< @brief Line size in octets */
+	unsigned ways;				/**< @brief Associativity */
+	cpu_set_t sharedWith;		/**< @brief Processors sharing this cache (empty if unknown) */
+} STopologyCache;
+
+/**
+ * @brief A logical processor
+ */
+typedef struct sTopologyCpu
+{
+	int online;					/**< @brief Whether or not the processor is online */
+	int core;					/**< @brief Core identifier, inside its package */
+	int package;				/**< @brief Package (socket) identifier */
+	int node;					/**< @brief NUMA node */
+	cpu_set_t siblings;			/**< @brief SMT siblings, itself included */
+} STopologyCpu;
+
+/**
+ * @brief struct sTopology describes the machine, it is read once and then cached
+ */
+typedef struct sTopology
+{
+	int nbCpus;					/**< @brief Number of logical processors described (highest online identifier + 1) */
+	int nbOnline;				/**< @brief Number of online processors */
+	cpu_set_t available;		/**< @brief Online processors allowed by the cpuset cgroup */
+	int nbAvailable;			/**< @brief Number of available processors */
+	cpu_set_t affinity;			/**< @brief sched_getaffinity mask of the process when it was read */
+	int nbNodes;				/**< @brief Number of NUMA nodes */
+	unsigned lineSize;			/**< @brief Cache line size in octets (cpuid) */
+	int nbCaches;				/**< @brief Number of caches described */
+	STopologyCache caches[TOPOLOGY_MAX_CACHES];	/**< @brief The caches of the first available processor */
+	STopologyCpu cpus[TOPOLOGY_MAX_CPUS];		/**< @brief The logical processors */
+} STopology;
+
+/**
+ * @brief Reads the topology from sysfs and cpuid the first time, then gives the cached one
+ * @return the topology
+ */
+const STopology *Topology_get (void);
+
+/**
+ * @brief Parses a processor list as written by sysfs ("0-3,8,10-11")
+ * @param list the list
+ * @param set the set to be filled
+ * @return the number of processors in the list, -1 if it is malformed
+ */
+int Topology_parseCpuList (const char *list, cpu_set_t *set);
+
+/**
+ * @brief Parses an ordered processor list ("3,1,4-6"), the order and the duplicates are kept
+ * @param list the list
+ * @param cpus the table to be filled
+ * @param max the size of the table
+ * @return the number of processors in the table, -1 if the list is malformed
+ */
+int Topology_parseCpuOrder (const char *list, int *cpus, int max);
+
+/**
+ * @brief Orders the available processors following a pinning policy
+ * @param policy the policy (TOPOLOGY_PIN_LIST is not handled here, see Topology_parseCpuOrder)
+ * @param anchor a processor of the package kept by TOPOLOGY_PIN_SOCKET
+ * @param cpus the table to be filled
+ * @param max the size of the table
+ * @return the number of processors in the table
+ */
+int Topology_orderCpus (ETopologyPinPolicy policy, int anchor, int *cpus, int max);
+
+/**
+ * @brief Gives the number of processors the benchmarks can be pinned on
+ * @return the number of online processors allowed by the cpuset cgroup
+ */
+int Topology_getNbAvailableCpus (void);
+
+/**
+ * @brief Gives an available processor
+ * @param idx the index of the processor among the available ones (modulo their number)
+ * @return the processor identifier
+ */
+int Topology_getAvailableCpu (int idx);
+
+/**
+ * @brief Gives a data (or unified) cache of the first available processor
+ * @param level the cache level, 0 for the last level
+ * @return the cache, NULL if it is unknown
+ */
+const STopologyCache *Topology_getCache (int level);
+
+/**
+ * @brief Gives the size of a data (or unified) cache of the first available processor
+ * @param level the cache level, 0 for the last level
+ * @return the size in octets, 0 if it is unknown
+ */
+size_t Topology_getCacheSize (int level);
+
+/**
+ * @brief Gives the processors sharing a data (or unified) cache with a given processor
+ * @param cpu the processor
+ * @param level the cache level
+ * @param set filled with the processors sharing the cache, itself included (empty if unknown)
+ * @return 0 on success, -1 if the cache is not described
+ */
+int Topology_getCacheSharing (int cpu, int level, cpu_set_t *set);
+
+#endif
@@ -0,0 +1,127 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "Arena.h"
+#include "Description.h"
+#include "Log.h"
+
+/**
+ * @brief Largest number of elements a vector gets during the sweep
+ */
+static unsigned long Arena_getMaxElements (SDescription *desc, unsigned no)
+{
+	if (Description_isNbSizeDefined (desc))
+	{
+		return desc->vectorSizes[no];
+	}
+	return Description_getEndVectorSize (desc) / Description_getMaxStride (desc);
+}
+
+SArena *Arena_create (SDescription *desc)
+{
+	SArena *arena;
+	personalized_malloc_t alloc = Description_getMyMalloc (desc);
+	unsigned nbVectors = Description_getNbVectors (desc);
+	unsigned long pageSize = getpagesize ();
+	unsigned long elemSize = Description_getVectorElementSize (desc);
+	unsigned long total = 0, size, offset;
+	unsigned i;
+	int *vect;
+	
+	if (nbVectors == 0 || Description_getVector (desc, 0) == NULL)
+	{
+		return NULL;
+	}
+	
+	arena = malloc (sizeof (*arena));
+	assert (arena != NULL);
+	arena->nbVectors = 0;
+	arena->bases = malloc (nbVectors * sizeof (*arena->bases));
+	arena->starts = malloc (nbVectors * sizeof (*arena->starts));
+	arena->capacities = malloc (nbVectors * sizeof (*arena->capacities));
+	assert (arena->bases != NULL && arena->starts != NULL && arena->capacities != NULL);
+	
+	for (i = 0; i < nbVectors; i++)
+	{
+		vect = Description_getVector (desc, i);
+		
+		/* Largest vector, one more stride, the largest alignment and the spacing with the next vector */
+		size = (Arena_getMaxElements (desc, i) + Description_getMaxStride (desc)) * elemSize
+				+ vect[VSTOP] + Description_getVectorSpacing (desc);
+		
+		/* One more page: the allocation library gives no alignment guarantee */
+		arena->bases[i] = alloc (size + pageSize, i, 0);
+		if (arena->bases[i] == NULL)
+		{
+			Log_output (-1, "Error: Cannot allocate the arena slot of vector %u (%lu octets)\n", i, size + pageSize);
+			Arena_destroy (arena, desc);
+			return NULL;
+		}
+		arena->nbVectors++;
+		
+		arena->starts[i] = (char *) (((uintptr_t) arena->bases[i] + pageSize - 1) & ~((uintptr_t) pageSize - 1));
+		arena->capacities[i] = size;
+		
+		/* Prefault: every configuration then runs on the same physical pages */
+		for (offset = 0; offset < size; offset += pageSize)
+		{
+			arena->starts[i][offset] = 0;
+		}
+		arena->starts[i][size - 1] = 0;
+		
+		total += size + pageSize;
+	}
+	
+	Log_output (5, "Info: Vector arena of %lu octets allocated and prefaulted\n", total);
+	
+	return arena;
+}
+
+void *Arena_getView (SArena *arena, unsigned no, int alignment, size_t size)
+{
+	assert (arena != NULL && no < arena->nbVectors);
+	assert (alignment >= 0 && alignment + size <= arena->capacities[no]);
+	
+	return arena->starts[no] + alignment;
+}
+
+void Arena_destroy (SArena *arena, SDescription *desc)
+{
+	personalized_free_t myFree = Description_getMyFree (desc);
+	unsigned i;
+	
+	if (arena == NULL)
+	{
+		return;
+	}
+	
+	for (i = 0; i < arena->nbVectors; i++)
+	{
+		myFree (arena->bases[i]);
+	}
+	
+	free (arena->capacities), arena->capacities = NULL;
+	free (arena->starts), arena->starts = NULL;
+	free (arena->bases), arena->bases = NULL;
+	free (arena), arena = NULL;
+}
@@ -0,0 +1,254 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Audit.h"
+#include "Log.h"
+#include "PerfEvents.h"
+
+/* Identifier of the syscall entry tracepoint, depending on where the tracing file system is mounted */
+static const char *auditSyscallTracepoints[] =
+{
+	"/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+	"/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id",
+};
+
+static const char *auditEventNames[AUDIT_NB_EVENTS] =
+{
+	"Audit context switches",
+	"Audit page faults",
+	"Audit syscalls"
+};
+
+/**
+ * @brief Fills the attributes of an audit event
+ * @param event the event (see AuditEvents)
+ * @param attr the attribute structure to fill
+ * @return 0 on success, -1 if the event is not available on this system
+ */
+static int Audit_parseEvent (unsigned event, struct perf_event_attr *attr)
+{
+	unsigned i;
+	unsigned long long id;
+	FILE *file;
+	int res;
+	
+	switch (event)
+	{
+		case AUDIT_CONTEXT_SWITCHES:
+			res = PerfEvents_parseEvent ("context-switches", attr);
+			break;
+		case AUDIT_PAGE_FAULTS:
+			res = PerfEvents_parseEvent ("page-faults", attr);
+			break;
+		default:
+			res = -1;
+			memset (attr, 0, sizeof (*attr));
+			attr->size = sizeof (*attr);
+			attr->type = PERF_TYPE_TRACEPOINT;
+			
+			for (i = 0; i < sizeof (auditSyscallTracepoints) / sizeof (*auditSyscallTracepoints) && res == -1; i++)
+			{
+				file = fopen (auditSyscallTracepoints[i], "r");
+				if (file != NULL)
+				{
+					if (fscanf (file, "%llu", &id) == 1)
+					{
+						attr->config = id;
+						res = 0;
+					}
+					fclose (file), file = NULL;
+				}
+			}
+			break;
+	}
+	
+	/* Context switches and syscall entries happen in the kernel: they would never be counted at user level only */
+	if (event != AUDIT_PAGE_FAULTS)
+	{
+		attr->exclude_kernel = 0;
+	}
+	attr->read_format = PERF_FORMAT_GROUP;
+	
+	return res;
+}
+
+/**
+ * @brief Reads the whole group
+ * @param audit the audit
+ * @param values filled with the value of each event (0 if the event is not available)
+ */
+static inline void Audit_read (SAudit *audit, uint64_t *values)
+{
+	uint64_t buf[1 + AUDIT_NB_EVENTS];
+	unsigned e;
+	
+	/* A single system call for the whole group */
+	if (audit->leader == -1 || read (audit->leader, buf, sizeof (buf)) < (ssize_t) ((1 + audit->nbOpened) * sizeof (*buf)))
+	{
+		memset (buf, 0, sizeof (buf));
+	}
+	
+	for (e = 0; e < AUDIT_NB_EVENTS; e++)
+	{
+		values[e] = (audit->position[e] != -1) ? buf[1 + audit->position[e]] : 0;
+	}
+}
+
+SAudit *Audit_create (void)
+{
+	SAudit *audit;
+	struct perf_event_attr attr;
+	unsigned e;
+	
+	audit = malloc (sizeof (*audit));
+	assert (audit != NULL);
+	memset (audit, 0, sizeof (*audit));
+	audit->leader = -1;
+	
+	for (e = 0; e < AUDIT_NB_EVENTS; e++)
+	{
+		audit->fds[e] = -1;
+		audit->position[e] = -1;
+		
+		/* The first event opened leads the group */
+		if (Audit_parseEvent (e, &attr) == 0)
+		{
+			audit->fds[e] = PerfEvents_open (&attr, 0, -1, audit->leader, 0);
+		}
+		
+		if (audit->fds[e] == -1)
+		{
+			Log_output (-1, "Warning: Cannot count \"%s\" for the audit (kernel events need a perf_event_paranoid of 1 at most, syscalls the tracing file system), the column is set to -1.\n",
+						auditEventNames[e]);
+			continue;
+		}
+		
+		if (audit->leader == -1)
+		{
+			audit->leader = audit->fds[e];
+		}
+		audit->position[e] = audit->nbOpened++;
+	}
+	
+	if (audit->leader == -1)
+	{
+		Log_output (-1, "Warning: No event can be counted, the audit is disabled.\n");
+		Audit_destroy (audit);
+		return NULL;
+	}
+	
+	Audit_calibrate (audit, NULL, NULL);
+	
+	return audit;
+}
+
+void Audit_calibrate (SAudit *audit, void (*window) (void *), void *data)
+{
+	uint64_t values[AUDIT_NB_EVENTS];
+	unsigned e, r;
+	
+	assert (audit != NULL);
+	
+	for (e = 0; e < AUDIT_NB_EVENTS; e++)
+	{
+		audit->baseline[e] = (uint64_t) -1;
+	}
+	
+	/* The read ending a window is counted in it: an empty window gives what has to be removed */
+	for (r = 0; r < AUDIT_CALIBRATION_RUNS; r++)
+	{
+		Audit_read (audit, audit->start);
+		if (window != NULL)
+		{
+			window (data);
+		}
+		Audit_read (audit, values);
+		
+		for (e = 0; e < AUDIT_NB_EVENTS; e++)
+		{
+			if (values[e] - audit->start[e] < audit->baseline[e])
+			{
+				audit->baseline[e] = values[e] - audit->start[e];
+			}
+		}
+	}
+}
+
+void Audit_destroy (SAudit *audit)
+{
+	unsigned e;
+	
+	if (audit == NULL)
+	{
+		return;
+	}
+	
+	/* The group leader is closed last */
+	for (e = 0; e < AUDIT_NB_EVENTS; e++)
+	{
+		if (audit->fds[e] != -1 && audit->fds[e] != audit->leader)
+		{
+			close (audit->fds[e]), audit->fds[e] = -1;
+		}
+	}
+	if (audit->leader != -1)
+	{
+		close (audit->leader), audit->leader = -1;
+	}
+	free (audit), audit = NULL;
+}
+
+void Audit_start (SAudit *audit)
+{
+	assert (audit != NULL);
+	Audit_read (audit, audit->start);
+}
+
+void Audit_stop (SAudit *audit, double *counts)
+{
+	uint64_t values[AUDIT_NB_EVENTS];
+	uint64_t diff;
+	unsigned e;
+	
+	assert (audit != NULL && counts != NULL);
+	Audit_read (audit, values);
+	
+	for (e = 0; e < AUDIT_NB_EVENTS; e++)
+	{
+		if (audit->position[e] == -1)
+		{
+			counts[e] = -1.;
+			continue;
+		}
+		
+		diff = values[e] - audit->start[e];
+		counts[e] = (diff > audit->baseline[e]) ? (double) (diff - audit->baseline[e]) : 0.;
+	}
+}
+
+const char *Audit_getEventName (unsigned event)
+{
+	assert (event < AUDIT_NB_EVENTS);
+	return auditEventNames[event];
+}
@@ -0,0 +1,260 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Barrier.h"
+#include "Log.h"
+#include "Rdtsc.h"
+#include "SleepTight.h"
+
+static inline size_t Barrier_size (unsigned nbProcess)
+{
+	return sizeof (SBarrier) + nbProcess * sizeof (SBarrierSlot);
+}
+
+/**
+ * @brief Sleeps while *word == value, at most BARRIER_CHECK_PERIOD milliseconds (the processes are not related by a thread: shared futexes)
+ */
+static inline void Barrier_wait (volatile uint32_t *word, uint32_t value)
+{
+	struct timespec timeout = {BARRIER_CHECK_PERIOD / 1000, (BARRIER_CHECK_PERIOD % 1000) * 1000000L};
+	
+	if (syscall (SYS_futex, word, FUTEX_WAIT, value, &timeout, NULL, 0) == -1 && errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT)
+	{
+		perror ("Error: futex wait");
+		exit (EXIT_FAILURE);
+	}
+}
+
+static inline void Barrier_wake (volatile uint32_t *word)
+{
+	syscall (SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+SBarrier *Barrier_create (int mode, unsigned nbProcess)
+{
+	SBarrier *barrier;
+	
+	if (mode == BARRIER_PIPE)
+	{
+		return NULL;
+	}
+	
+	barrier = mmap (NULL, Barrier_size (nbProcess), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (barrier == MAP_FAILED)
+	{
+		perror ("Error: barrier mapping");
+		exit (EXIT_FAILURE);
+	}
+	
+	memset (barrier, 0, Barrier_size (nbProcess));
+	barrier->mode = mode;
+	barrier->nbProcess = nbProcess;
+	
+	return barrier;
+}
+
+void Barrier_destroy (SBarrier *barrier)
+{
+	if (barrier != NULL)
+	{
+		munmap (barrier, Barrier_size (barrier->nbProcess));
+	}
+}
+
+/**
+ * @brief Leaves a benchmark process once the father gave up on the barrier
+ */
+static inline void Barrier_checkAborted (SBarrier *barrier)
+{
+	if (barrier->aborted)
+	{
+		Log_output (-1, "Error: A benchmark process died, leaving the barrier.\n");
+		exit (EXIT_FAILURE);
+	}
+}
+
+/**
+ * @brief Gives whether or not a recorded benchmark process exited (it is not reaped, the father still waits for it)
+ */
+static int Barrier_isProcessDead (SBarrier *barrier)
+{
+	siginfo_t info;
+	unsigned i;
+	
+	for (i = 0; i < barrier->nbProcess; i++)
+	{
+		if (barrier->slots[i].pid == 0)
+		{
+			continue;
+		}
+		
+		memset (&info, 0, sizeof (info));
+		if (waitid (P_PID, barrier->slots[i].pid, &info, WEXITED | WNOHANG | WNOWAIT) == -1 || info.si_pid != 0)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+void Barrier_setProcess (SBarrier *barrier, unsigned processId, pid_t pid)
+{
+	if (barrier != NULL)
+	{
+		assert (processId < barrier->nbProcess);
+		barrier->slots[processId].pid = pid;
+	}
+}
+
+void Barrier_child (SBarrier *barrier, unsigned processId)
+{
+	uint32_t generation;
+	uint64_t now;
+	
+	assert (barrier != NULL && processId < barrier->nbProcess);
+	
+	/* Read before arriving: the father cannot release this generation before */
+	generation = barrier->generation;
+	
+	/* The last one to arrive wakes the father up */
+	if (__sync_add_and_fetch (&barrier->arrived, 1) == barrier->nbProcess)
+	{
+		Barrier_wake (&barrier->arrived);
+	}
+	
+	if (barrier->mode == BARRIER_SPIN)
+	{
+		while (barrier->generation == generation)
+		{
+			Barrier_checkAborted (barrier);
+			asm volatile ("pause" ::: "memory");
+		}
+		__sync_synchronize ();
+		
+		/* Everybody leaves at the same TSC value, whatever the time it took to see the release */
+		do
+		{
+			rdtscll (now);
+		} while (now < barrier->deadline);
+	}
+	else
+	{
+		while (barrier->generation == generation)
+		{
+			Barrier_checkAborted (barrier);
+			Barrier_wait (&barrier->generation, generation);
+		}
+		rdtscll (now);
+	}
+	
+	barrier->slots[processId].release = now;
+	__sync_synchronize ();
+	barrier->slots[processId].generation = generation + 1;
+}
+
+void Barrier_father (SBarrier *barrier)
+{
+	uint32_t arrived;
+	uint64_t now;
+	
+	assert (barrier != NULL);
+	
+	while ((arrived = barrier->arrived) < barrier->nbProcess)
+	{
+		Barrier_wait (&barrier->arrived, arrived);
+		
+		/* A process dying before it arrives would block the father and the other processes forever */
+		if (barrier->arrived < barrier->nbProcess && Barrier_isProcessDead (barrier))
+		{
+			barrier->aborted = 1;
+			__sync_synchronize ();
+			Barrier_wake (&barrier->generation);
+			Log_output (-1, "Error: A benchmark process died before reaching the barrier.\n");
+			exit (EXIT_FAILURE);
+		}
+	}
+	barrier->arrived = 0;
+	
+	if(sleep_tight() == 1)
+	{
+		// TODO: stuff to do if we slept
+	}
+	
+	if (barrier->mode == BARRIER_SPIN)
+	{
+		rdtscll (now);
+		barrier->deadline = now + BARRIER_SPIN_DELAY;
+	}
+	
+	/* The counter reset and the deadline are visible before the release */
+	__sync_add_and_fetch (&barrier->generation, 1);
+	
+	if (barrier->mode == BARRIER_FUTEX)
+	{
+		Barrier_wake (&barrier->generation);
+	}
+}
+
+double Barrier_getStartSkew (SBarrier *barrier, unsigned processId)
+{
+	uint32_t generation;
+	uint64_t release, earliest, latest;
+	unsigned i;
+	
+	if (barrier == NULL)
+	{
+		return -1.;
+	}
+	
+	generation = barrier->slots[processId].generation;
+	earliest = latest = barrier->slots[processId].release;
+	
+	/* The other processes write their release right after leaving the barrier */
+	for (i = 0; i < barrier->nbProcess; i++)
+	{
+		while (barrier->slots[i].generation < generation)
+		{
+			if (barrier->aborted)
+			{
+				return -1.;
+			}
+			sched_yield ();
+		}
+		__sync_synchronize ();
+		
+		release = barrier->slots[i].release;
+		earliest = (release < earliest) ? release : earliest;
+		latest = (release > latest) ? release : latest;
+	}
+	
+	return latest - earliest;
+}
@@ -0,0 +1,132 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BenchResult.h"
+
+BenchResult *BenchResult_create (unsigned meta_repet)
+{
+	BenchResult *br;
+	unsigned i;
+	
+	br = malloc (sizeof (*br));
+	assert (br != NULL);
+	
+	br->time = malloc ( meta_repet * sizeof (*br->time));
+	br->iterations = malloc ( meta_repet * sizeof (*br->iterations));
+	br->startSkew = malloc ( meta_repet * sizeof (*br->startSkew));
+	br->fusedTime = malloc ( meta_repet * sizeof (*br->fusedTime));
+	assert (br->iterations != NULL);
+	assert (br->time != NULL);
+	assert (br->startSkew != NULL);
+	assert (br->fusedTime != NULL);
+	memset (br->time, 0, meta_repet * sizeof (*br->time));
+	memset (br->iterations, 0, meta_repet * sizeof (*br->iterations));
+	for (i = 0; i < meta_repet; i++)
+	{
+		br->startSkew[i] = -1.;
+		br->fusedTime[i] = -1.;
+	}
+	br->initialTime = 0.;
+	br->finalTime = 0.;
+	br->nbCounters = 0;
+	br->counters = NULL;
+	br->nbAuditEvents = 0;
+	br->audit = NULL;
+	br->nbSamples = meta_repet;
+	br->precision = -1.;
+	
+	return br;
+}
+
+void BenchResult_createCounters (BenchResult *br, unsigned nbCounters, unsigned meta_repet)
+{
+	unsigned i;
+	
+	assert (br != NULL);
+	assert (br->counters == NULL); /* Mustn't be redefined */
+	
+	if (nbCounters == 0)
+	{
+		return;
+	}
+	
+	br->counters = malloc (nbCounters * sizeof (*br->counters));
+	assert (br->counters != NULL);
+	
+	for (i = 0; i < nbCounters; i++)
+	{
+		br->counters[i] = malloc (meta_repet * sizeof (*br->counters[i]));
+		assert (br->counters[i] != NULL);
+		memset (br->counters[i], 0, meta_repet * sizeof (*br->counters[i]));
+	}
+	br->nbCounters = nbCounters;
+}
+
+void BenchResult_createAudit (BenchResult *br, unsigned nbEvents, unsigned meta_repet)
+{
+	unsigned i, j;
+	
+	assert (br != NULL);
+	assert (br->audit == NULL); /* Mustn't be redefined */
+	
+	if (nbEvents == 0)
+	{
+		return;
+	}
+	
+	br->audit = malloc (nbEvents * sizeof (*br->audit));
+	assert (br->audit != NULL);
+	
+	for (i = 0; i < nbEvents; i++)
+	{
+		br->audit[i] = malloc (meta_repet * sizeof (*br->audit[i]));
+		assert (br->audit[i] != NULL);
+		for (j = 0; j < meta_repet; j++)
+		{
+			br->audit[i][j] = -1.;
+		}
+	}
+	br->nbAuditEvents = nbEvents;
+}
+
+void BenchResult_destroy (BenchResult *br)
+{
+	unsigned i;
+	
+	assert (br != NULL);
+	
+	for (i = 0; i < br->nbCounters; i++)
+	{
+		free (br->counters[i]), br->counters[i] = NULL;
+	}
+	free (br->counters), br->counters = NULL;
+	for (i = 0; i < br->nbAuditEvents; i++)
+	{
+		free (br->audit[i]), br->audit[i] = NULL;
+	}
+	free (br->audit), br->audit = NULL;
+	free (br->time), br->time = NULL;
+	free (br->iterations), br->iterations = NULL;
+	free (br->startSkew), br->startSkew = NULL;
+	free (br->fusedTime), br->fusedTime = NULL;
+	free (br), br = NULL;
+}
@@ -20,51 +20,57 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 	  
 #include <assert.h>
 #include <dlfcn.h>
+#include <math.h>
 #include <sys/io.h>
 #include <sys/wait.h>
 #include <sys/types.h>
+#include <time.h>
 
+#include "Arena.h"
+#include "Audit.h"
+#include "Barrier.h"
 #include "BenchDescriptor.h"
 #include "Benchmark.h"
 #include "Description.h"
 #include "Defines.h" 
-#include "Dflush.h"
+#include "Driver.h"
+#include "Flush.h"
 #include "Log.h"
 #include "Progress.h"
+#include "Rdtsc.h"
 #include "Resume.h"
+#include "ResultSink.h"
+#include "Sampler.h"
 #include "SleepTight.h"
 #include "Signal.h"
+#include "Statistics.h"
+#include "Stepping.h"
+#include "Sweep.h"
 #include "Toolkit.h"
 
+/* The calibration probe stops doubling the repetitions once it spans this fraction of the target */
+#define AUTO_REPETITION_PROBE_FRACTION 10
+#define AUTO_REPETITION_MAX (1u << 30)
+
 //Static declaration of functions
 static void benchmark_kernel (BenchResult **res, unsigned long *n, void ** Arrays, SDescription *desc, int EnableSync);
 
-static inline BenchResult *BenchResult_create (int meta_repet)
-{
-	BenchResult *br;
-	
-	br = malloc (sizeof (*br));
-	assert (br != NULL);
-	
-	br->time = malloc ( meta_repet * sizeof (*br->time));
-	br->iterations = malloc ( meta_repet * sizeof (*br->iterations));
-	assert (br->iterations != NULL);
-	assert (br->time != NULL);
-	memset (br->time, 0, meta_repet * sizeof (*br->time));
-	memset (br->iterations, 0, meta_repet * sizeof (*br->iterations));
-	br->initialTime = 0.;
-	br->finalTime = 0.;
-	
-	return br;
-}
+/* Whether a signal comes from the input benchmark (the kernel is running) or from microlaunch itself */
+static volatile sig_atomic_t insideKernel = 0;
 
-static inline void BenchResult_destroy (BenchResult *br)
+/**
+ * @brief Signal handler of a whole configuration, installed once rather than around each sample
+ */
+static void Benchmark_signalHandler (int signal, siginfo_t *info, void *data)
 {
-	assert (br != NULL);
-	
-	free (br->time), br->time = NULL;
-	free (br->iterations), br->iterations = NULL;
-	free (br), br = NULL;
+	if (insideKernel)
+	{
+		SignalHandler_benchmark (signal, info, data);
+	}
+	else
+	{
+		SignalHandler_launchingBenchmark (signal, info, data);
+	}
 }
 
 static inline void ClearArrayFloat (uint64_t nbElements, float *pArray)
@@ -118,11 +124,32 @@ static inline double Benchmark_launchEvalFunction (evaluationFct fct, int isProc
 	return 0.;
 }
 
+/**
+ * @brief Starts then stops the evaluation libraries, as around the kernel: the audit window holds these calls
+ * @param data the SDescription
+ */
+static void Benchmark_emptyEvalWindow (void *data)
+{
+	SDescription *desc = data;
+	int nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
+	int i;
+	
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		Benchmark_launchEvalFunction (Description_getEvaluationStartFunction (desc, i), 1, Description_getEvaluationData (desc, i));
+	}
+	
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		int lib = Description_isEvalStackEnabled (desc) ? nbEvalLibs - 1 - i : i;
+		
+		Benchmark_launchEvalFunction (Description_getEvaluationStopFunction (desc, lib), 1, Description_getEvaluationData (desc, lib));
+	}
+}
+
 static inline void Benchmark_launchBenchmark (BenchResult **res, SDescription *desc, unsigned long *vectorSizes, void **arrays,
 												kernel_fctptr kernel_run, int enableSync, int storeResult, int idX) {
 	int timeIsOk = 0;
-	int *pipeSF = Description_getTubeSF (desc);
-	int *pipeFS = Description_getTubeFS (desc);
 	evaluationFct start;
 	evaluationFct stop;
 	int nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
@@ -138,16 +165,23 @@ static inline void Benchmark_launchBenchmark (BenchResult **res, SDescription *d
 	uint64_t newIterations = 0;
 	int i;
 	int isEvalStackEnabled = Description_isEvalStackEnabled (desc);
+	driver_fctptr driver = Description_getDriverFunction (desc);
+	unsigned long long cycles = 0;
+	SAudit *audit = storeResult ? Description_getAudit (desc) : NULL;
+	double auditCounts[AUDIT_NB_EVENTS];
 
-	// If the file PATH_TO_KILL exists, cancel the program (SleepTight.h)
-	escape_from_scary_killers();
+	/* A stop request is a flag set by SIGTERM: no system call is made around the measure (PATH_TO_KILL is checked once per configuration) */
+	if (escape_requested ())
+	{
+		escape_from_scary_killers ();
+	}
 		
 	if (enableSync == 1)
 	{
-		barrierS (pipeSF, pipeFS);
+		barrierS (desc);
 	}
 		
-	pushSignalHandler (SignalHandler_benchmark);
+	insideKernel = 1;
 	while (!timeIsOk)
 	{
 			// Heat up the data and instruction caches
@@ -158,7 +192,14 @@ static inline void Benchmark_launchBenchmark (BenchResult **res, SDescription *d
 				evalData = Description_getEvaluationData (desc, i);
 				res[i]->initialTime = Benchmark_launchEvalFunction (start, isProcessEvalHandler, evalData);
 			}
-			oldIterations = kernel_run (nbVectors, vectorSizes, elemSize, arrays, func);
+			if (driver != NULL)
+			{
+				oldIterations = driver (1, vectorSizes, elemSize, arrays, &cycles);
+			}
+			else
+			{
+				oldIterations = kernel_run (nbVectors, vectorSizes, elemSize, arrays, func);
+			}
 			
 			/* EVAL STOP */
 			if (isEvalStackEnabled) /* We're stopping the librairies in the reverse order */
@@ -180,6 +221,11 @@ static inline void Benchmark_launchBenchmark (BenchResult **res, SDescription *d
 				}
 			}
 			
+			if (audit != NULL)
+			{
+				Audit_start (audit);
+			}
+			
 			if (isRoot)
 			{
 					iopl(3);
@@ -194,15 +240,23 @@ static inline void Benchmark_launchBenchmark (BenchResult **res, SDescription *d
 				res[i]->initialTime = Benchmark_launchEvalFunction (start, isProcessEvalHandler, evalData);
 			}
 			
-			for (repetitions = 0; repetitions < nbRepetitions; repetitions++) /* For each repetition */
+			if (driver != NULL)
 			{
-				newIterations = kernel_run (nbVectors, vectorSizes, elemSize, arrays, func);
-				
-				if (oldIterations != newIterations)
+				/* The repetition loop is in the kernel library: direct calls, timed inside the loop */
+				newIterations = driver (nbRepetitions, vectorSizes, elemSize, arrays, &cycles);
+			}
+			else
+			{
+				for (repetitions = 0; repetitions < nbRepetitions; repetitions++) /* For each repetition */
 				{
-						Log_output (25, "Warning: iteration number not the same\n");
+					newIterations = kernel_run (nbVectors, vectorSizes, elemSize, arrays, func);
+					
+					if (oldIterations != newIterations)
+					{
+							Log_output (25, "Warning: iteration number not the same\n");
+					}
+					oldIterations = newIterations;
 				}
-				oldIterations = newIterations;
 			}
 			
 			/* EVAL STOP */
@@ -232,6 +286,11 @@ static inline void Benchmark_launchBenchmark (BenchResult **res, SDescription *d
 					asm volatile("sti");
 			}
 			
+			if (audit != NULL)
+			{
+				Audit_stop (audit, auditCounts);
+			}
+			
 			/* Check : if one evaluation library has a negative value, then let's recompute results again */
 			timeIsOk = 1;
 			for (i = 0; i < nbEvalLibs; i++)
@@ -243,7 +302,7 @@ static inline void Benchmark_launchBenchmark (BenchResult **res, SDescription *d
 				}
 			}
 	}
-	popSignalHandler ();
+	insideKernel = 0;
 
 	if (storeResult)
 	{
@@ -252,8 +311,127 @@ static inline void Benchmark_launchBenchmark (BenchResult **res, SDescription *d
 		{
 			res[i]->time[idX] = res[i]->finalTime - res[i]->initialTime;
 			res[i]->iterations[idX] = newIterations;
+			if (driver != NULL)
+			{
+				res[i]->fusedTime[idX] = cycles;
+			}
+		}
+		
+		if (audit != NULL)
+		{
+			for (i = 0; i < (int) res[0]->nbAuditEvents; i++)
+			{
+				res[0]->audit[i][idX] = auditCounts[i];
+			}
+		}
+		
+		if (isProcessEvalHandler)
+		{
+			Benchmark_storeEvaluationCounters (res, desc, idX);
+		}
+		
+		if (enableSync == 1)
+		{
+			Benchmark_storeStartSkew (res, desc, idX);
+		}
+	}
+}
+
+/**
+ * @brief Selects the kernel wrapper matching the number of vectors
+ * @param desc the SDescription of this execution
+ * @return the kernel wrapper to be called
+ */
+static inline kernel_fctptr Benchmark_selectKernel (SDescription *desc)
+{
+	kernel_fctptr kernelTable[8] = {kernel1, kernel2, kernel3, kernel4, kernel5,kernel6, kernel7, kernel8};
+	unsigned long nbVectors = Description_getNbVectors (desc);
+	
+	if (Description_isNbSizeDefined (desc))
+	{
+		return kernelMDL;
+	}
+	
+	if (nbVectors == 0)
+	{
+		return kernelTable[0];
+	}
+	return kernelTable[nbVectors-1];
+}
+
+/**
+ * @brief Reads the clock used by the repetition calibration
+ * @param unit the unit of the calibration target
+ * @return the current time, in the calibration unit
+ */
+static inline uint64_t Benchmark_readCalibrationClock (AutoRepetition_unit unit)
+{
+	struct timespec ts;
+	uint64_t ticks;
+	
+	if (unit == AUTO_REPETITION_CYCLES)
+	{
+		rdtscll (ticks);
+		return ticks;
+	}
+	
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Finds the number of repetitions needed for a measure to span the auto-repetition target
+ * @param desc the SDescription of this execution
+ * @param vectorSizes the sizes used by the real run
+ * @param arrays the vectors
+ * @param minRepet the minimum number of repetitions
+ * @return the number of repetitions to use
+ */
+static unsigned Benchmark_calibrateRepetitions (SDescription *desc, unsigned long *vectorSizes, void **arrays, unsigned minRepet)
+{
+	kernel_fctptr kernel_run = Benchmark_selectKernel (desc);
+	AutoRepetition_unit unit = Description_getAutoRepetitionUnit (desc);
+	double target = Description_getAutoRepetitionTarget (desc);
+	unsigned long nbVectors = Description_getNbVectors (desc);
+	unsigned elemSize = Description_getVectorElementSize (desc);
+	void *func = Description_getKernelFunction (desc);
+	unsigned long repet = 1, r;
+	uint64_t start, stop;
+	double elapsed, res;
+	
+	/* Heat up, as the real run does */
+	kernel_run (nbVectors, vectorSizes, elemSize, arrays, func);
+	
+	/* Double the repetitions until the probe is long enough to be extrapolated */
+	while (1)
+	{
+		start = Benchmark_readCalibrationClock (unit);
+		for (r = 0; r < repet; r++)
+		{
+			kernel_run (nbVectors, vectorSizes, elemSize, arrays, func);
+		}
+		stop = Benchmark_readCalibrationClock (unit);
+		elapsed = stop - start;
+		
+		if (elapsed * AUTO_REPETITION_PROBE_FRACTION >= target || repet >= AUTO_REPETITION_MAX)
+		{
+			break;
 		}
+		repet *= 2;
+	}
+	
+	res = (elapsed > 0) ? ceil (repet * target / elapsed) : AUTO_REPETITION_MAX;
+	
+	if (res < minRepet)
+	{
+		res = minRepet;
+	}
+	if (res > AUTO_REPETITION_MAX)
+	{
+		res = AUTO_REPETITION_MAX;
 	}
+	
+	return res;
 }
 
 /**
@@ -269,38 +447,22 @@ benchmark_kernel (BenchResult **res, unsigned long *vectorSizes, void **arrays,
 {
 	int coarse_loop;
 	int meta_repet = Description_getMetaRepetition (desc);
-	unsigned long nbVectors = Description_getNbVectors (desc);
-	kernel_fctptr kernelTable[8] = {kernel1, kernel2, kernel3, kernel4, kernel5,kernel6, kernel7, kernel8};
-	kernel_fctptr kernel_run;
+	kernel_fctptr kernel_run = Benchmark_selectKernel (desc);
 	verificationFctInit verifyInit = Description_getVerificationInitFct (desc);
 	verificationFctDisplay verifyDisplay = Description_getVerificationDisplayFct (desc);
 	verificationFctDestroy verifyDestroy = Description_getVerificationDestroyFct (desc);
 	void *verifyContextData = NULL;
-	double *dummyArray = Description_getDummyArrayAligned (desc);
-	unsigned dummySize = Description_getDummySize (desc);
+	int precisionReached = 0;
 	FILE *fp;
 	
 	//Associative table for the kernels
 	//init of this table
 	
-	pushSignalHandler (SignalHandler_launchingBenchmark);
+	// If the file PATH_TO_KILL exists, cancel the program (SleepTight.h)
+	escape_from_scary_killers();
 	
-	/* Selection of the kernel to execute */
-	if (Description_isNbSizeDefined (desc))
-	{
-		kernel_run = kernelMDL;
-	}
-	else
-	{
-		if (nbVectors == 0)
-		{
-			kernel_run = kernelTable[0];
-		}
-		else
-		{
-			kernel_run = kernelTable[nbVectors-1];
-		}
-	}
+	/* The handlers are installed for the whole configuration, the samples only switch a flag */
+	pushSignalHandler (Benchmark_signalHandler);
 	
 	/* Verifying library support */
 	if (verifyInit != NULL && verifyDisplay != NULL && verifyDestroy != NULL)
@@ -325,16 +487,31 @@ benchmark_kernel (BenchResult **res, unsigned long *vectorSizes, void **arrays,
 	// Meta loop that selects the lowest measure
 	for (coarse_loop = 0; coarse_loop < meta_repet ; coarse_loop ++)
 	{
+		/* Adaptive mode: once the precision is reached, the remaining meta-repetitions
+			only go through the barrier as the father expects meta_repet of them */
+		if (precisionReached)
+		{
+			if (EnableSync == 1)
+			{
+				barrierS (desc);
+			}
+			continue;
+		}
+		
 		/* Resume system counter saving */
 		desc->temp_values.current_meta_repet = coarse_loop;
 		
 		/* Flush Caches */
-		readDummyArray (dummyArray, dummySize);
+		Flush_caches (Description_getFlush (desc), desc, arrays);
 		
 		/* Benchmark launching */
 		Benchmark_launchBenchmark (res, desc, vectorSizes, arrays, kernel_run, EnableSync, 1, coarse_loop);
+		
+		precisionReached = Benchmark_updatePrecision (res, desc, coarse_loop + 1);
 	}
 	
+	Flush_report (Description_getFlush (desc), Description_isPrintingProcess (desc));
+	
 	popSignalHandler ();
 }
 
@@ -362,25 +539,11 @@ containsCFG (char *s)
 int
 getExperimentNumber (SDescription *desc)
 {
-	int nb_experiments = 1;
-	int i;
-	int nbVect = Description_getNbVectors(desc);
-	int *vect;
-	int tmp;
-	
-	/* This loop computes the number of alignments possibilities */
-	for (i=0 ; i < nbVect ; i++)
-	{
-		vect = Description_getVector (desc, i);
-		assert (vect != NULL);
-		tmp = (vect[VSTOP] - vect[VSTART]) ;
-		if (vect[VSTART] < vect[VSTOP] && vect[VSTEP] != 0)
-			tmp /= vect[VSTEP];
-		nb_experiments *= (tmp+1);
-	}
+	/* The number of alignments possibilities, or the sampling budget */
+	int nb_experiments = (int) Sampler_getNbSamples (desc);
 	
-	/* Then multiply it by the number of experiments to be launched : ((end-start)/step)+1 */
-	nb_experiments *= ((Description_getEndVectorSize (desc) - Description_getStartVectorSize (desc)) / Description_getVectorSizeStep (desc)) +1;
+	/* Then multiply it by the number of experiments to be launched : ((end-start)/step)+1, or the number of stepped sizes */
+	nb_experiments *= Stepping_getNbSizes (desc);
 	
 	/* If we're using the verification library, then we're doing one more experiment */
 	if (Description_getVerificationLibraryName (desc) != NULL)
@@ -484,6 +647,19 @@ static inline void *Benchmark_loadBenchmarkFunction (SDescription *desc, int isP
 
 		//Set kernel function
 		Description_setKernelFunction (desc, benchmarkFct);
+		
+		/* The fused driver is only linked in the kernels compiled by microlaunch */
+		Description_setDriverFunction (desc, NULL);
+		if (Description_isFusedDriverEnabled (desc))
+		{
+			void *driverFct = dlsym (dl, DRIVER_FUNCTION_NAME);
+			
+			if (driverFct == NULL && isPrintingProcess)
+			{
+				Log_output (-1, "Warning: No fused driver in \"%s\", the kernel is called through its wrapper\n", dynlibName);
+			}
+			Description_setDriverFunction (desc, driverFct);
+		}
 	}
 	
 	return dl;
@@ -542,11 +718,110 @@ static inline void *Benchmark_loadEvaluationFunctions (SDescription *desc, const
 		Description_setEvaluationInitFunction (desc, initFct, idX);
 		Description_setEvaluationCloseFunction (desc, closeFct, idX);
 		Description_setEvaluationLibraryOverheadFlag (desc, overheadFlag, idX);
+		Benchmark_loadEvaluationOptionalFunctions (desc, dl, idX);
 	}
 	
 	return dl;
 }
 
+void Benchmark_loadEvaluationOptionalFunctions (SDescription *desc, void *dl, unsigned idX)
+{
+	evaluationCounterNbFct nbFct;
+	evaluationCounterNameFct nameFct;
+	evaluationCounterValueFct valueFct;
+	evaluationReadCostFct readCostFct;
+	
+	assert (dl != NULL);
+	
+	/* These functions are optional: most libraries only return one value */
+	nbFct = dlsym (dl, "evaluationGetNbCounters");
+	nameFct = dlsym (dl, "evaluationGetCounterName");
+	valueFct = dlsym (dl, "evaluationGetCounterValue");
+	
+	if ((nbFct != NULL || nameFct != NULL || valueFct != NULL) && (nbFct == NULL || nameFct == NULL || valueFct == NULL))
+	{
+		Log_output (-1, "Warning: Evaluation library %s does not declare all the counter functions, its counters are ignored.\n",
+				Description_getEvaluationLibraryName (desc, idX));
+	}
+	
+	Description_setEvaluationCounterFunctions (desc, nbFct, nameFct, valueFct, idX);
+	
+	readCostFct = dlsym (dl, "evaluationGetReadCost");
+	Description_setEvaluationReadCostFunction (desc, readCostFct, idX);
+}
+
+void Benchmark_storeStartSkew (BenchResult **res, SDescription *desc, unsigned idX)
+{
+	unsigned nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
+	double skew;
+	unsigned i;
+	
+	/* Only the processes writing results wait for the other ones to publish their release time */
+	if (!Description_isProcessEvalHandler (desc) || Description_getBarrier (desc) == NULL)
+	{
+		return;
+	}
+	
+	skew = Barrier_getStartSkew (Description_getBarrier (desc), Description_getProcessId (desc));
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		res[i]->startSkew[idX] = skew;
+	}
+}
+
+void Benchmark_storeEvaluationCounters (BenchResult **res, SDescription *desc, unsigned idX)
+{
+	unsigned nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
+	evaluationCounterValueFct value;
+	void *evalData;
+	unsigned i, c;
+	
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		if (res[i]->nbCounters == 0)
+		{
+			continue;
+		}
+		
+		value = Description_getEvaluationCounterValueFunction (desc, i);
+		evalData = Description_getEvaluationData (desc, i);
+		for (c = 0; c < res[i]->nbCounters; c++)
+		{
+			res[i]->counters[c][idX] = value (evalData, c);
+		}
+	}
+}
+
+int Benchmark_updatePrecision (BenchResult **res, SDescription *desc, unsigned nbSamples)
+{
+	unsigned nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
+	int criterion = Description_getAdaptiveCriterion (desc);
+	unsigned i;
+	
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		res[i]->nbSamples = nbSamples;
+	}
+	
+	/* Only the processes handling the evaluation libraries get real values */
+	if (!Description_isAdaptiveModeEnabled (desc) || !Description_isProcessEvalHandler (desc))
+	{
+		return 0;
+	}
+	
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		res[i]->precision = Statistics_relativePrecision (res[i]->time, nbSamples, criterion);
+	}
+	
+	/* The first evaluation library decides when to stop */
+	if ((int) nbSamples < Description_getMinMetaRepetition (desc) || res[0]->precision < 0)
+	{
+		return 0;
+	}
+	return res[0]->precision <= Description_getAdaptivePrecision (desc);
+}
+
 static inline void *Benchmark_loadVerificationFunctions (SDescription *desc) {
 	char *verificationLibName = Description_getVerificationLibraryName (desc);
 	char *initVerify = "verificationInit";
@@ -646,7 +921,16 @@ static inline void *Benchmark_loadAllocationFunctions (SDescription *desc) {
 void Benchmark_makeDummyArray (SDescription *desc) {
 	unsigned int m;
 	unsigned sizeDummy = Description_getDummySize (desc);
-	double *dummy_array = malloc (sizeDummy * sizeof (*dummy_array));
+	double *dummy_array;
+	
+	/* Only the read flush uses the dummy array */
+	if (Description_getFlushStrategy (desc) != FLUSH_READ)
+	{
+		Description_setFlush (desc, Flush_create (desc));
+		return;
+	}
+	
+	dummy_array = malloc (sizeDummy * sizeof (*dummy_array));
 
 	if (dummy_array == NULL) {
 		Log_output (-1, "Error: could not allocate dummy array.\n");
@@ -660,6 +944,7 @@ void Benchmark_makeDummyArray (SDescription *desc) {
 	}
 
 	Description_setDummyArray (desc, dummy_array, dummy_array);
+	Description_setFlush (desc, Flush_create (desc));
 }
 
 /**
@@ -715,103 +1000,292 @@ static inline int Benchmark_closeLibraries (void *dl_bench, void **dl_eval, unsi
 	return 1;
 }
 
-inline FILE *Benchmark_createOutputFile (SDescription *desc, int currentExecRepet, int currentVectorSize)
+/**
+ * @brief Builds the name of an output file
+ * @param desc the description of the program
+ * @param currentExecRepet the current execute-repetition of the program
+ * @param sizeLabel the vector size part of the name (ignored in Exec mode)
+ * @param suffix the end of the name, before the extension
+ * @param extension the extension
+ * @param name filled with the name
+ * @param size the size of name
+ */
+static void Benchmark_getOutputFileName (SDescription *desc, int currentExecRepet, const char *sizeLabel, const char *suffix, const char *extension, char *name, size_t size)
 {
-	assert (desc != NULL);
-	
-	FILE *outputCsvFile = NULL;
-	int isAllProcessOutputEnabled = Description_isAllProcessOutputEnabled (desc);
 	unsigned execRepets = Description_getExecuteRepets (desc);
 	char *outputPath = Description_getOutputPath (desc);
 	char *basename = Description_getBaseName (desc);
 	int isKernelMode = (Description_getExecFileName (desc) == NULL);
 	unsigned w_size;
 	
-	char outputCsvFileName[STRBUF_MAXLEN];
-	char coreBuf[STRBUF_MAXLEN];
-	
-	/* We add a core_%d extension if several processes have to handle eval library */
-	if (isAllProcessOutputEnabled)
-	{
-		w_size = snprintf (coreBuf, sizeof (coreBuf), "_core_%d", Description_getProcessId (desc));
-		assert (w_size < sizeof (coreBuf));
-	}
-	else
-	{
-		coreBuf[0] = '\0'; /* Just initializes the string with nothing */
-	}
-	
 	if (isKernelMode) /* KERNEL MODE */
 	{
 		if (execRepets > 1) /* If there are several execute-repetition */
 		{
-			w_size = snprintf (outputCsvFileName, sizeof (outputCsvFileName), "%s/kernel_execution_%d__%s_%d%s.csv", outputPath, currentExecRepet, basename, currentVectorSize, coreBuf);
+			w_size = snprintf (name, size, "%s/kernel_execution_%d__%s_%s%s%s", outputPath, currentExecRepet, basename, sizeLabel, suffix, extension);
 		}
 		else
 		{
-			w_size = snprintf (outputCsvFileName, sizeof (outputCsvFileName), "%s/kernel_%s_%d%s.csv", outputPath, basename, currentVectorSize, coreBuf);
+			w_size = snprintf (name, size, "%s/kernel_%s_%s%s%s", outputPath, basename, sizeLabel, suffix, extension);
 		}
 	}
 	else /* EXEC MODE */
 	{
 		if (execRepets > 1)
 		{
-			w_size = snprintf (outputCsvFileName, sizeof (outputCsvFileName), "%s/exec_execution_%d__%s%s.csv", outputPath, currentExecRepet, basename, coreBuf);
+			w_size = snprintf (name, size, "%s/exec_execution_%d__%s%s%s", outputPath, currentExecRepet, basename, suffix, extension);
 		}
 		else
 		{
-			w_size = snprintf (outputCsvFileName, sizeof (outputCsvFileName), "%s/exec_%s%s.csv", outputPath, basename, coreBuf);
+			w_size = snprintf (name, size, "%s/exec_%s%s%s", outputPath, basename, suffix, extension);
 		}
 	}
-	assert (w_size < sizeof (outputCsvFileName));
-	Description_setOutputFileName (desc, outputCsvFileName);
-
-	/* Ouverture du fichier csv or not, depend on the presence of --no-output in the command line*/
-	outputCsvFile = fopen (outputCsvFileName, "w");
-	if (outputCsvFile == NULL)
-	{
-		Log_output (-1, "Error: Cannot open file %s\n", outputCsvFileName);
-		perror ("");
-		return NULL;
-	}
-	
-	return outputCsvFile;
+	assert (w_size < size);
 }
 
-static inline void initializeSystemState (SDescription *desc, int *systemState)
+/**
+ * @brief Builds the name of the statistics file of an output file: kernel_xxx.csv (or kernel_xxx.mlr) => kernel_xxx_stats.csv
+ */
+static void Benchmark_getStatisticsFileName (const char *outputFileName, char *name, size_t size)
 {
-	assert (desc != NULL && systemState != NULL);
-	int *vect;
-	unsigned i;
-	unsigned nbVectors = Description_getNbVectors (desc);
+	unsigned len = strlen (outputFileName);
 	
-	for (i = 0; i < nbVectors; i++)
+	if (len > 4 && (strcmp (outputFileName + len - 4, ".csv") == 0 || strcmp (outputFileName + len - 4, RESULTSINK_BINARY_EXTENSION) == 0))
 	{
-		vect = Description_getVector (desc, i);
-		if (vect[VSTEP] == 0)
-		{
-			vect[VSTEP] = 1;
-		}
-		systemState[i] = vect[VSTART];
+		len -= 4;
 	}
+	len = snprintf (name, size, "%.*s_stats.csv", len, outputFileName);
+	assert (len < size);
 }
 
-static inline void replaceBaseName (SDescription *desc)
+inline SResultSink *Benchmark_createOutputFile (SDescription *desc, int currentExecRepet, int currentVectorSize)
 {
 	assert (desc != NULL);
-	char *slash, *dot;
 	
-	/* If there is a path to the file */
-	if ((slash = strrchr (Description_getKernelFileName (desc), '/')) != NULL)
-	{
-		dot = strrchr (slash, '.'); /* Search for the last point of the filename (ie its extension) */
-		assert (dot != NULL); /* We have to have a file extension */
-		*dot = '\0';
-		Description_setBaseName (desc, slash+1);
+	SResultSink *outputSink = NULL;
+	int isBinaryOutput = Description_isBinaryOutputEnabled (desc);
+	const char *extension = isBinaryOutput ? RESULTSINK_BINARY_EXTENSION : ".csv";
+	int isAllProcessOutputEnabled = Description_isAllProcessOutputEnabled (desc);
+	unsigned w_size;
+	
+	char outputCsvFileName[STRBUF_MAXLEN];
+	char coreBuf[STRBUF_MAXLEN];
+	char sizeBuf[STRBUF_MAXLEN];
+	
+	/* Sweep mode: each worker writes a binary part holding every vector size, merged by the father (Benchmark_mergeSweep) */
+	if (Description_isSweepEnabled (desc))
+	{
+		isBinaryOutput = 1;
+		extension = RESULTSINK_BINARY_EXTENSION;
+		snprintf (sizeBuf, sizeof (sizeBuf), "sweep");
+		w_size = snprintf (coreBuf, sizeof (coreBuf), SWEEP_PART_SUFFIX "%d", Description_getProcessId (desc));
+		assert (w_size < sizeof (coreBuf));
+	}
+	/* We add a core_%d extension if several processes have to handle eval library */
+	else if (isAllProcessOutputEnabled)
+	{
+		snprintf (sizeBuf, sizeof (sizeBuf), "%d", currentVectorSize);
+		w_size = snprintf (coreBuf, sizeof (coreBuf), "_core_%d", Description_getProcessId (desc));
+		assert (w_size < sizeof (coreBuf));
+	}
+	else
+	{
+		snprintf (sizeBuf, sizeof (sizeBuf), "%d", currentVectorSize);
+		coreBuf[0] = '\0'; /* Just initializes the string with nothing */
+	}
+	
+	Benchmark_getOutputFileName (desc, currentExecRepet, sizeBuf, coreBuf, extension, outputCsvFileName, sizeof (outputCsvFileName));
+	Description_setOutputFileName (desc, outputCsvFileName);
+
+	/* The rows are buffered and written by blocks, between the measures */
+	outputSink = ResultSink_create (outputCsvFileName, isBinaryOutput);
+	
+	return outputSink;
+}
+
+FILE *Benchmark_createStatisticsFile (SDescription *desc)
+{
+	char *outputCsvFileName = Description_getOutputFileName (desc);
+	char statisticsFileName[STRBUF_MAXLEN];
+	FILE *statisticsFile;
+	
+	assert (outputCsvFileName != NULL);
+	
+	Benchmark_getStatisticsFileName (outputCsvFileName, statisticsFileName, sizeof (statisticsFileName));
+	
+	statisticsFile = fopen (statisticsFileName, "w");
+	if (statisticsFile == NULL)
+	{
+		Log_output (-1, "Error: Cannot open file %s\n", statisticsFileName);
+		perror ("");
+		return NULL;
+	}
+	
+	return statisticsFile;
+}
+
+static inline void replaceBaseName (SDescription *desc)
+{
+	assert (desc != NULL);
+	char buf[STRBUF_MAXLEN];
+	char *slash, *dot;
+	
+	/* The kernel file name is kept: the father also needs it */
+	snprintf (buf, sizeof (buf), "%s", Description_getKernelFileName (desc));
+	
+	/* If there is a path to the file */
+	if ((slash = strrchr (buf, '/')) != NULL)
+	{
+		dot = strrchr (slash, '.'); /* Search for the last point of the filename (ie its extension) */
+		assert (dot != NULL); /* We have to have a file extension */
+		*dot = '\0';
+		Description_setBaseName (desc, slash+1);
+	}
+}
+
+/**
+ * @brief Appends the statistics part of a sweep worker, the header is only copied from the first part
+ * @return 0 on success, -1 otherwise
+ */
+static int Benchmark_appendStatisticsPart (const char *partName, int isFirstPart, FILE *statisticsFile)
+{
+	FILE *part = fopen (partName, "r");
+	char *line = NULL;
+	size_t size = 0;
+	int lineId = 0;
+	
+	if (part == NULL)
+	{
+		Log_output (-1, "Error: Cannot open file %s\n", partName);
+		perror ("");
+		return -1;
+	}
+	
+	while (getline (&line, &size, part) != -1)
+	{
+		if (isFirstPart || lineId != 0)
+		{
+			fputs (line, statisticsFile);
+		}
+		lineId++;
+	}
+	
+	free (line), line = NULL;
+	fclose (part), part = NULL;
+	return 0;
+}
+
+int Benchmark_mergeSweep (SDescription *desc, int currentExecRepet)
+{
+	unsigned nbWorkers = Description_getNbProcess (desc);
+	int isBinaryOutput = Description_isBinaryOutputEnabled (desc);
+	char name[STRBUF_MAXLEN], suffix[STRBUF_MAXLEN];
+	char **parts = malloc (nbWorkers * sizeof (*parts));
+	SResultSink *outputSink;
+	FILE *statisticsFile;
+	unsigned w;
+	int res;
+	
+	assert (parts != NULL);
+	
+	/* The workers named their files after the kernel */
+	if (Description_getKernelFileNamesTabSize (desc) > 1)
+	{
+		replaceBaseName (desc);
+	}
+	
+	for (w = 0; w < nbWorkers; w++)
+	{
+		snprintf (suffix, sizeof (suffix), SWEEP_PART_SUFFIX "%u", w);
+		Benchmark_getOutputFileName (desc, currentExecRepet, "sweep", suffix, RESULTSINK_BINARY_EXTENSION, name, sizeof (name));
+		parts[w] = strDuplicate (name, STRBUF_MAXLEN);
+	}
+	
+	Benchmark_getOutputFileName (desc, currentExecRepet, "sweep", "", isBinaryOutput ? RESULTSINK_BINARY_EXTENSION : ".csv", name, sizeof (name));
+	Description_setOutputFileName (desc, name);
+	
+	outputSink = ResultSink_create (name, isBinaryOutput);
+	statisticsFile = Benchmark_createStatisticsFile (desc);
+	res = (outputSink != NULL && statisticsFile != NULL) ? 0 : -1;
+	
+	/* The rows of a point are consecutive and in meta-repetition order: the merge is stable */
+	if (res == 0)
+	{
+		res = ResultSink_merge (parts, nbWorkers, "Id of current run", outputSink);
+	}
+	
+	for (w = 0; w < nbWorkers && res == 0; w++)
+	{
+		Benchmark_getStatisticsFileName (parts[w], name, sizeof (name));
+		res = Benchmark_appendStatisticsPart (name, w == 0, statisticsFile);
+	}
+	
+	if (ResultSink_destroy (outputSink) == -1)
+	{
+		res = -1;
+	}
+	if (statisticsFile != NULL)
+	{
+		fclose (statisticsFile), statisticsFile = NULL;
+	}
+	
+	for (w = 0; w < nbWorkers; w++)
+	{
+		if (res == 0)
+		{
+			Benchmark_getStatisticsFileName (parts[w], name, sizeof (name));
+			remove (name);
+			remove (parts[w]);
+		}
+		free (parts[w]), parts[w] = NULL;
+	}
+	free (parts), parts = NULL;
+	
+	return res;
+}
+
+static inline void initializeSystemState (SDescription *desc, int *systemState)
+{
+	assert (desc != NULL && systemState != NULL);
+	int *vect;
+	unsigned i;
+	unsigned nbVectors = Description_getNbVectors (desc);
+	
+	for (i = 0; i < nbVectors; i++)
+	{
+		vect = Description_getVector (desc, i);
+		if (vect[VSTEP] == 0)
+		{
+			vect[VSTEP] = 1;
+		}
+		systemState[i] = vect[VSTART];
+	}
+}
+
+/**
+ * @brief Normalizes a measure according to the information the user wants to display
+ * @param desc the SDescription describing the program
+ * @param idX the evaluation library index
+ * @param value the measure, overhead already removed
+ * @param repet the number of repetitions of the kernel inside the measure
+ * @param iterations the number of iterations returned by the kernel
+ * @return the normalized value
+ */
+static inline double Benchmark_normalizeResult (SDescription *desc, unsigned idX, double value, unsigned repet, uint64_t iterations)
+{
+	switch (Description_getInfoDisplayed (desc, idX)) 
+	{
+		case ITERATION_COST:
+			return value / (((double) repet) * iterations);
+		case FUNCTION_COST:
+			return value / ((double) repet); 
+		case RAW_NUMBERS:	/* We do nothing */
+		default:
+			return value;
 	}
 }
 
-static inline void allocateArrays (void **arrays_offset, unsigned nbVectors, unsigned elemSize, int *systemState, SDescription *desc)
+static inline void allocateArrays (void **arrays_offset, unsigned nbVectors, unsigned elemSize, int *systemState, SArena *arena, SDescription *desc)
 {
 	int (*benchmarkInitFct) (int, int, void*, size_t) = Description_getKernelInitFunction (desc);
 	unsigned i;
@@ -820,7 +1294,14 @@ static inline void allocateArrays (void **arrays_offset, unsigned nbVectors, uns
 	/* Setting the new arrays offsets */
 	for (i = 0; i < nbVectors; i++)
 	{
-		arrays_offset[i] = alloc (desc->vectorSizes[i] * elemSize, i, systemState[i]);		
+		if (arena != NULL)
+		{
+			arrays_offset[i] = Arena_getView (arena, i, systemState[i], desc->vectorSizes[i] * elemSize);
+		}
+		else
+		{
+			arrays_offset[i] = alloc (desc->vectorSizes[i] * elemSize, i, systemState[i]);
+		}
 
 		// Putting valid data in our vectors for the overhead run
 		if (benchmarkInitFct != NULL)
@@ -871,18 +1352,46 @@ static inline void saveOrLoadDataFromResuming (int *curRuns, int *systemState, S
 	}
 }
 
+/**
+ * @brief Gives the vector size following the current one, past the end once the stepping is over
+ */
+static inline unsigned Benchmark_nextVectorSize (SStepping *stepping, unsigned size, unsigned step, unsigned end)
+{
+	int next;
+	
+	if (stepping == NULL)
+	{
+		return size + step;
+	}
+	
+	next = Stepping_next (stepping);
+	return (next == -1) ? end + 1 : (unsigned) next;
+}
+
 /*===================== BENCHMARK 2D =======================================*/
-int Benchmark_Wrapper (SDescription *desc, int currentExecRepet)
+/**
+ * @brief Runs the size and alignment sweep of one or several kernels
+ * @param desc the SDescription describing the program
+ * @param currentExecRepet the current --executerepetition iteration
+ * @param libraries the compiled libraries of the kernels, NULL to run the current kernel only
+ * @param nbKernels the number of kernels in libraries
+ * @return EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int Benchmark_run (SDescription *desc, int currentExecRepet, char **libraries, unsigned nbKernels)
 {
-	unsigned nCurrentVectorSize = Description_getStartVectorSize (desc);
-	unsigned i;
-	FILE *outputCsvFile  = NULL;
+	unsigned nCurrentVectorSize, lastVectorSize;
+	unsigned i, kernelId;
+	SResultSink *outputSink = NULL;
+	FILE *statisticsFile = NULL;
 	unsigned repet = Description_getRepetition (desc);
+	unsigned minRepet = repet; /* --repetition is the minimum once the repetitions are calibrated */
+	int isAutoRepetitionEnabled = Description_isAutoRepetitionEnabled (desc);
 	unsigned meta_repet = Description_getMetaRepetition (desc);
 	BenchResult **overhead;
 	BenchResult **res;
 	int *systemState;
 	void **arrays_offset = NULL;
+	SArena *arena = NULL;
 	unsigned nbVectors = Description_getNbVectors (desc);
 	int iterationCountIsEnabled = Description_isIterationCountEnabled (desc);
 	int iterationCount = Description_getIterationCount (desc);
@@ -910,6 +1419,10 @@ int Benchmark_Wrapper (SDescription *desc, int currentExecRepet)
 	unsigned evalLoop;
 	int isRequestedToMakeFile = Description_getPromptOutputCsv (desc);
 	int isNbSizeDefined = Description_isNbSizeDefined (desc);
+	SSweep *sweep = Description_getSweep (desc);
+	SSampler *sampler;
+	SStepping *stepping;
+	int point;
 	int *vect;
 	
 	/* Vectors allocation */
@@ -931,9 +1444,6 @@ int Benchmark_Wrapper (SDescription *desc, int currentExecRepet)
 	/* Prints out that we're currently running Kernel Mode */
 	Benchmark_printLaunchingTechnique (isPrintingProcess, KERNEL_MODE);
 	
-	/* Loads the Benchmark function */
-	dl_bench = Benchmark_loadBenchmarkFunction (desc, isPrintingProcess);
-	
 	/* Load the Allocation functions */
 	dl_alloc = Benchmark_loadAllocationFunctions (desc);
 	
@@ -966,17 +1476,32 @@ int Benchmark_Wrapper (SDescription *desc, int currentExecRepet)
 		{
 			return EXIT_FAILURE;
 		}
+		
+		/* Libraries exporting several counters get one table per counter */
+		BenchResult_createCounters (res[i], Description_getEvaluationNbCounters (desc, i), meta_repet);
+		BenchResult_createCounters (overhead[i], Description_getEvaluationNbCounters (desc, i), meta_repet);
 	}
 	
-	if (dl_bench == NULL || dl_alloc == NULL)
+	if (dl_alloc == NULL)
 	{
 		return EXIT_FAILURE;
 	}
 	
-	benchmarkInitFct = Description_getKernelInitFunction (desc);
-	
 	/* Allocate dummy array for cache flushes */
 	Benchmark_makeDummyArray (desc);
+	
+	/* The audit events are opened once, by the process writing the results */
+	if (Description_isAuditEnabled (desc) && isProcessEvalHandler && nbEvalLibs > 0)
+	{
+		Description_setAudit (desc, Audit_create ());
+		BenchResult_createAudit (res[0], AUDIT_NB_EVENTS, meta_repet);
+		
+		/* The system calls of the evaluation libraries (e.g. the ioctl and read of perfcounters) are not a contamination */
+		if (Description_getAudit (desc) != NULL)
+		{
+			Audit_calibrate (Description_getAudit (desc), Benchmark_emptyEvalWindow, desc);
+		}
+	}
 
 	// Set step minimum
 	if (step == 0)
@@ -993,21 +1518,37 @@ int Benchmark_Wrapper (SDescription *desc, int currentExecRepet)
 		Log_output (-1, "Error: could not initiate the allocation system.\n");
 		return EXIT_FAILURE;
 	}
-
-	/* Resuming system */
-	if (resumeInitCounter (&nCurrentVectorSize, desc->temp_values.current_vector_size))
+	
+	/* The sampled alignments are drawn once, every vector size measures the same ones */
+	sampler = Sampler_create (desc);
+	Description_setSampler (desc, sampler);
+	
+	/* The geometric sizes are computed once, the adaptive bisections are made again for each kernel */
+	stepping = Stepping_create (desc);
+	Description_setStepping (desc, stepping);
+	
+	/* The vectors are allocated once for the whole sweep */
+	if (Description_isArenaEnabled (desc))
 	{
-		if (isPrintingProcess)
+		arena = Arena_create (desc);
+		if (arena == NULL && nbVectors != 0 && Description_getVector (desc, 0) != NULL)
 		{
-			Log_output (-1, "Note: Resuming to last --startvector value : %d\n", nCurrentVectorSize);
+			return EXIT_FAILURE;
 		}
 	}
-	
+
 	if (isPrintingProcess)
 	{
 		Log_output (-1, "Launching Configuration :\n");
 		Log_output (-1, "\t- Meta-repetitions : %u\n", meta_repet);
-		Log_output (-1, "\t- Repetitions : %u\n", repet);
+		if (isAutoRepetitionEnabled)
+		{
+			Log_output (-1, "\t- Repetitions : calibrated (at least %u)\n", repet);
+		}
+		else
+		{
+			Log_output (-1, "\t- Repetitions : %u\n", repet);
+		}
 	}
 	
 	/* If iterationCount is enabled, then set all the vectors sizes to this value */
@@ -1028,207 +1569,379 @@ int Benchmark_Wrapper (SDescription *desc, int currentExecRepet)
 		overheadSizes[i] = 0;
 	}
 	
-	/* Replaces the basename in case of several input kernels */
-	if (Description_getKernelFileNamesTabSize (desc) > 1)
+	/* The eval libraries, the allocator, the dummy array and the arena are kept from one kernel to the next one */
+	for (kernelId = 0; kernelId < nbKernels; kernelId++)
 	{
-		replaceBaseName (desc);
-	}
-
-	/* Main Benchmark loop */
-	for ( ; nCurrentVectorSize <= end; nCurrentVectorSize += step)
-	{
-		/* Init correctly the vector sizes if static ones are not defined */
-		if (!isNbSizeDefined)
+		if (libraries != NULL)
 		{
-			for (i = 0; i < nbVectors; i++)
+			Description_setKernelCurrentFileId (desc, kernelId);
+			Description_setDynamicLibraryName (desc, libraries[kernelId], 0);
+			if (isPrintingProcess)
 			{
-				desc->vectorSizes[i] = nCurrentVectorSize;
-				desc->vectorSizes[i] /= maxStride;
+				Log_output (-1, "Current Kernel Execution : %s\n", Description_getKernelFileName (desc));
 			}
 		}
 		
-		desc->temp_values.current_vector_size = nCurrentVectorSize; /* saving current vector size (resume system) */
+		/* Loads the Benchmark function */
+		dl_bench = Benchmark_loadBenchmarkFunction (desc, isPrintingProcess);
+		if (dl_bench == NULL)
+		{
+			return EXIT_FAILURE;
+		}
+		benchmarkInitFct = Description_getKernelInitFunction (desc);
 		
-		/* Generates the output CSV file and initializes it */
-		if (isProcessEvalHandler && isRequestedToMakeFile) {
-			outputCsvFile = Benchmark_createOutputFile (desc, currentExecRepet, nCurrentVectorSize);
-			if (outputCsvFile == NULL)
+		nCurrentVectorSize = Description_getStartVectorSize (desc);
+		lastVectorSize = nCurrentVectorSize;
+		curRuns = 0;
+		if (stepping != NULL)
+		{
+			Stepping_restart (stepping);
+		}
+		
+		/* Resuming system */
+		if (resumeInitCounter (&nCurrentVectorSize, desc->temp_values.current_vector_size))
+		{
+			if (isPrintingProcess)
+			{
+				Log_output (-1, "Note: Resuming to last --startvector value : %d\n", nCurrentVectorSize);
+			}
+			if (stepping != NULL)
 			{
-				return EXIT_FAILURE;
+				Stepping_seek (stepping, desc->temp_values.current_size_step, nCurrentVectorSize);
 			}
-			Benchmark_initCsv (desc, outputCsvFile);
 		}
-
-		/*  -----------------------------------------------------------------------
-			ROUTINE A PROPREMENT PARLER DU BENCH POUR UNE TAILLE nCurrentVectorSize
-			----------------------------------------------------------------------- */
 		
-		/* Initializes the systemState table (having each alignment set) */
-		initializeSystemState (desc, systemState);
-
-		vect = Description_getVector(desc, 0);
-		
-		/* Save current run counters or load them if we're relaunching them */
-		saveOrLoadDataFromResuming (&curRuns, systemState, desc, nbVectors, isPrintingProcess);
+		/* The first stepped size (the resumed one, if any) */
+		if (stepping != NULL)
+		{
+			nCurrentVectorSize = Benchmark_nextVectorSize (stepping, nCurrentVectorSize, step, end);
+		}
 		
-		/* For each alignment process */
-		while ((vect == NULL) || systemState[0] <= vect[VSTOP])
+		/* Replaces the basename in case of several input kernels */
+		if (Description_getKernelFileNamesTabSize (desc) > 1)
 		{
-			/* Output where we are up to, this is not logged */
-			if (isPrintingProcess)
+			replaceBaseName (desc);
+		}
+
+		/* Main Benchmark loop */
+		for ( ; nCurrentVectorSize <= end; nCurrentVectorSize = Benchmark_nextVectorSize (stepping, nCurrentVectorSize, step, end))
+		{
+			/* Init correctly the vector sizes if static ones are not defined */
+			if (!isNbSizeDefined)
 			{
-				if (Description_isNbSizeDefined (desc))
-				{
-					fprintf (stderr, "\r- Benchmark computation process : %3d%% (Mixed sizes)\t\t",(curRuns*100) / (totalRuns));
-				}
-				else
+				for (i = 0; i < nbVectors; i++)
 				{
-					fprintf (stderr, "\r- Benchmark computation process : %3d%% (%d/%d)",(curRuns*100) / (totalRuns), nCurrentVectorSize, end);
+					desc->vectorSizes[i] = nCurrentVectorSize;
+					desc->vectorSizes[i] /= maxStride;
 				}
 			}
 			
-			/* Allocate the vectors */
-			allocateArrays (arrays_offset, nbVectors, elemSize, systemState, desc);
-			
-			/*Overhead computation*/
-			/** @todo The overhead calculation seems wrong to me */
-			benchmark_kernel (overhead, overheadSizes, arrays_offset, desc, 1);
-			
-			/* Clear all used vectors */
-			for ( i = 0 ; i < nbVectors ; i++ )
+			desc->temp_values.current_vector_size = nCurrentVectorSize; /* saving current vector size (resume system) */
+			if (stepping != NULL)
 			{
-				if (benchmarkInitFct != NULL)
+				desc->temp_values.current_size_step = Stepping_getPosition (stepping) - 1;
+			}
+			
+			/* Generates the output CSV file and initializes it */
+			if (isProcessEvalHandler && isRequestedToMakeFile) {
+				outputSink = Benchmark_createOutputFile (desc, currentExecRepet, nCurrentVectorSize);
+				if (outputSink == NULL)
 				{
-					benchmarkInitFct (i, desc->vectorSizes[i], arrays_offset[i], elemSize);
+					return EXIT_FAILURE;
 				}
-				else
+				Benchmark_initCsv (desc, outputSink);
+				
+				statisticsFile = Benchmark_createStatisticsFile (desc);
+				if (statisticsFile == NULL)
 				{
-					ClearArray (desc->vectorSizes[i],arrays_offset[i], elemSize);
+					return EXIT_FAILURE;
 				}
+				Benchmark_initStatisticsCsv (desc, statisticsFile);
 			}
+
+			/*  -----------------------------------------------------------------------
+				ROUTINE A PROPREMENT PARLER DU BENCH POUR UNE TAILLE nCurrentVectorSize
+				----------------------------------------------------------------------- */
 			
-			curRuns++;
-	
-			/* What is the number of iterations we want to make for each vector ? */
-			if (iterationCountIsEnabled)
-			{
-				iterationSizes = iterationCountTable;
-			}
-			else
+			/* Initializes the systemState table (having each alignment set) */
+			initializeSystemState (desc, systemState);
+			if (sampler != NULL)
 			{
-				iterationSizes = desc->vectorSizes;
+				Sampler_restart (sampler);
+				if (!resumeIsResuming ())
+				{
+					desc->temp_values.current_sample = 0;
+				}
 			}
-			benchmark_kernel (res, iterationSizes, arrays_offset, desc, 1);
 
-			/*------------------------------------------------*/
-			/* Computing the overhead average for each evaluation library */
-			for (evalLoop = 0; evalLoop < nbEvalLibs; evalLoop++)
+			vect = Description_getVector(desc, 0);
+			
+			/* Save current run counters or load them if we're relaunching them (a sweep cannot be resumed) */
+			if (sweep == NULL)
 			{
-				overheadAvg[evalLoop] = 0;
+				saveOrLoadDataFromResuming (&curRuns, systemState, desc, nbVectors, isPrintingProcess);
+				if (sampler != NULL)
+				{
+					Sampler_seek (sampler, desc->temp_values.current_sample);
+				}
+			}
 			
-				/* this lib requested no overhead computation */
-				if (!Description_getEvaluationLibraryOverheadFlag(desc, evalLoop))
+			/* For each alignment process */
+			while ((vect == NULL) || systemState[0] <= vect[VSTOP])
+			{
+				/* Sampled alignments: the configuration comes from the sampler list */
+				if (sampler != NULL && sweep == NULL && Sampler_next (sampler, systemState) == -1)
 				{
-					continue;
+					break;
 				}
 				
-				for ( i = 0 ; i < meta_repet ; i++ )
+				/* Sweep mode: the points, sizes included, are taken from the queue shared by the workers */
+				if (sweep != NULL)
 				{
-					overheadAvg[evalLoop] += overhead[evalLoop]->time[i];
+					point = Sweep_take (sweep, Description_getProcessId (desc));
+					if (point == -1)
+					{
+						break;
+					}
+					
+					nCurrentVectorSize = Sweep_decode (desc, point, systemState);
+					if (!isNbSizeDefined)
+					{
+						for (i = 0; i < nbVectors; i++)
+						{
+							desc->vectorSizes[i] = nCurrentVectorSize;
+							desc->vectorSizes[i] /= maxStride;
+						}
+					}
+					desc->temp_values.current_vector_size = nCurrentVectorSize;
+					curRuns = point;
 				}
-				overheadAvg[evalLoop] /= meta_repet;
-			}
-			
-			/*Computing all values we wish to use*/
-			for ( i = 0 ; i < meta_repet ; i++ )
-			{
-				for (evalLoop = 0; evalLoop < nbEvalLibs; evalLoop++)
+				
+				/* Output where we are up to, this is not logged */
+				if (isPrintingProcess)
+				{
+					if (Description_isNbSizeDefined (desc))
+					{
+						fprintf (stderr, "\r- Benchmark computation process : %3d%% (Mixed sizes)\t\t",(curRuns*100) / (totalRuns));
+					}
+					else
+					{
+						fprintf (stderr, "\r- Benchmark computation process : %3d%% (%d/%d)",(curRuns*100) / (totalRuns), nCurrentVectorSize, end);
+					}
+				}
+				lastVectorSize = nCurrentVectorSize;
+				
+				/* Allocate the vectors */
+				allocateArrays (arrays_offset, nbVectors, elemSize, systemState, arena, desc);
+				
+				/* What is the number of iterations we want to make for each vector ? */
+				if (iterationCountIsEnabled)
 				{
-					//Remove overhead 
-					res[evalLoop]->time[i] -= overheadAvg[evalLoop];
+					iterationSizes = iterationCountTable;
+				}
+				else
+				{
+					iterationSizes = desc->vectorSizes;
+				}
+				
+				/* The overhead and real runs use the same number of repetitions, so the probe is done before both */
+				if (isAutoRepetitionEnabled)
+				{
+					repet = Benchmark_calibrateRepetitions (desc, iterationSizes, arrays_offset, minRepet);
+					Description_setRepetition (desc, repet);
+					Log_output (10, "Info: Using %u repetitions for this configuration\n", repet);
+				}
+				
+				/*Overhead computation*/
+				/** @todo The overhead calculation seems wrong to me */
+				benchmark_kernel (overhead, overheadSizes, arrays_offset, desc, sweep == NULL);
+				
+				/* Clear all used vectors */
+				for ( i = 0 ; i < nbVectors ; i++ )
+				{
+					if (benchmarkInitFct != NULL)
+					{
+						benchmarkInitFct (i, desc->vectorSizes[i], arrays_offset[i], elemSize);
+					}
+					else
+					{
+						ClearArray (desc->vectorSizes[i],arrays_offset[i], elemSize);
+					}
+				}
+				
+				curRuns++;
+				
+				benchmark_kernel (res, iterationSizes, arrays_offset, desc, sweep == NULL);
 
-					switch (Description_getInfoDisplayed (desc, evalLoop)) 
+				/*------------------------------------------------*/
+				/* Computing the overhead for each evaluation library: the median is not moved by a single outlier */
+				for (evalLoop = 0; evalLoop < nbEvalLibs; evalLoop++)
+				{
+					/* this lib requested no overhead computation: only its calibrated read cost is removed */
+					overheadAvg[evalLoop] = Description_getEvaluationReadCost (desc, evalLoop, 0);
+					if (!Description_getEvaluationLibraryOverheadFlag(desc, evalLoop))
 					{
-						case ITERATION_COST:
-							res[evalLoop]->time[i] = res[evalLoop]->time[i] / (((double) repet) * res[evalLoop]->iterations[i]);
-							break;
-						case FUNCTION_COST:
-							res[evalLoop]->time[i] = res[evalLoop]->time[i] /( (double) repet); 
-							break;
-						case RAW_NUMBERS:	/* We do nothing */
-							break;
-						default:
-							break;
+						continue;
 					}
+					
+					overheadAvg[evalLoop] = Statistics_median (overhead[evalLoop]->time, overhead[evalLoop]->nbSamples);
 				}
 				
-				/* Write in Csv file if we are allowed to do it */
-				if (isProcessEvalHandler && isRequestedToMakeFile)
+				/* Counters are corrected and normalized the same way as the main value */
+				for (evalLoop = 0; evalLoop < nbEvalLibs; evalLoop++)
+				{
+					unsigned c;
+					
+					for (c = 0; c < res[evalLoop]->nbCounters; c++)
+					{
+						double counterOverhead = Description_getEvaluationReadCost (desc, evalLoop, c);
+						
+						if (Description_getEvaluationLibraryOverheadFlag (desc, evalLoop))
+						{
+							counterOverhead = Statistics_median (overhead[evalLoop]->counters[c], overhead[evalLoop]->nbSamples);
+						}
+						
+						for ( i = 0 ; i < res[evalLoop]->nbSamples ; i++ )
+						{
+							res[evalLoop]->counters[c][i] = Benchmark_normalizeResult (desc, evalLoop, res[evalLoop]->counters[c][i] - counterOverhead,
+																				repet, res[evalLoop]->iterations[i]);
+						}
+					}
+				}
+				
+				/* The fused loop is corrected by its own overhead, then normalized as the first evaluation library */
+				if (Description_getDriverFunction (desc) != NULL)
+				{
+					double fusedOverhead = Statistics_median (overhead[0]->fusedTime, overhead[0]->nbSamples);
+					
+					for ( i = 0 ; i < res[0]->nbSamples ; i++ )
+					{
+						res[0]->fusedTime[i] = Benchmark_normalizeResult (desc, 0, res[0]->fusedTime[i] - fusedOverhead,
+																		repet, res[0]->iterations[i]);
+					}
+				}
+				
+				/*Computing all values we wish to use*/
+				for ( i = 0 ; i < res[0]->nbSamples ; i++ )
 				{
-					int problem = NO_ERROR;
 					for (evalLoop = 0; evalLoop < nbEvalLibs; evalLoop++)
 					{
-						if (res[evalLoop]->time[i] < 0)
+						//Remove overhead 
+						res[evalLoop]->time[i] = Benchmark_normalizeResult (desc, evalLoop, res[evalLoop]->time[i] - overheadAvg[evalLoop],
+																	repet, res[evalLoop]->iterations[i]);
+					}
+					
+					/* Write in Csv file if we are allowed to do it */
+					if (isProcessEvalHandler && isRequestedToMakeFile)
+					{
+						int problem = NO_ERROR;
+						for (evalLoop = 0; evalLoop < nbEvalLibs; evalLoop++)
 						{
-							problem = OVERHEAD_TOO_HIGH;
-							break;
+							if (res[evalLoop]->time[i] < 0)
+							{
+								problem = OVERHEAD_TOO_HIGH;
+								break;
+							}
 						}
+						
+						/* Print every eval lib result in the CSV */
+						Benchmark_printCsv (desc, res, nbEvalLibs, i, systemState, nbVectors, desc->number_of_resumes, curRuns, outputSink, problem);
+					}
+				}
+				
+				if (isProcessEvalHandler && isRequestedToMakeFile)
+				{
+					Benchmark_printStatisticsCsv (desc, overhead, "Overhead (raw)", systemState, nbVectors, curRuns, statisticsFile);
+					Benchmark_printStatisticsCsv (desc, res, "Result", systemState, nbVectors, curRuns, statisticsFile);
+				}
+				
+				/* Computing the next step of alignement possibility*/
+				if (sweep == NULL)
+				{
+					/* The adaptive stepping compares the sizes on the mean of their configuration medians */
+					if (stepping != NULL)
+					{
+						Stepping_record (stepping, Statistics_median (res[0]->time, res[0]->nbSamples));
 					}
 					
-					/* Print every eval lib result in the CSV */
-					Benchmark_printCsv (res, nbEvalLibs, i, systemState, nbVectors, desc->number_of_resumes, curRuns, outputCsvFile, problem);
+					if (sampler != NULL)
+					{
+						Sampler_record (sampler, Statistics_median (res[0]->time, res[0]->nbSamples));
+						desc->temp_values.current_sample = Sampler_getPosition (sampler);
+					}
+					else
+					{
+						Benchmark_next (desc, systemState);
+					}
+					memcpy (desc->temp_values.alignments, systemState, nbVectors * sizeof(int));
+					
+					desc->temp_values.curruns = curRuns;
+					
+					/* Save the current counters */
+					if (isPrintingProcess)
+					{
+						resumeSaveCounters(desc);
+					}
 				}
-			}
-			
-			/* Computing the next step of alignement possibility*/
-			Benchmark_next (desc, systemState);
-			memcpy (desc->temp_values.alignments, systemState, nbVectors * sizeof(int));
 
-			desc->temp_values.curruns = curRuns;
+				/* Free the vectors, the arena ones are kept for the next configuration */
+				for (i = 0; i < nbVectors && arena == NULL; i++)
+				{
+					alloc_free (arrays_offset[i]);
+				}
+				resumeDisableResuming ();
+				
+				/* If there are no vectors allocated, we only make a single experiment => so we break the loop now */
+				if (vect == NULL && sweep == NULL)
+				{
+					break;
+				}
+			}
 			
-			/* Save the current counters */
 			if (isPrintingProcess)
 			{
-				resumeSaveCounters(desc);
+				resumeSaveCounters (desc);
 			}
-
-			/* Free the vectors */
-			for (i = 0; i < nbVectors; i++)
+			
+			if (isProcessEvalHandler && isRequestedToMakeFile)
 			{
-				alloc_free (arrays_offset[i]);
+				if (ResultSink_destroy (outputSink) == -1)
+				{
+					return EXIT_FAILURE;
+				}
+				outputSink = NULL;
+				fclose (statisticsFile), statisticsFile = NULL;
 			}
-			resumeDisableResuming ();
 			
-			/* If there are no vectors allocated, we only make a single experiment => so we break the loop now */
-			if (vect == NULL)
+			/* The queue held every vector size */
+			if (sweep != NULL)
 			{
 				break;
 			}
 		}
-		
 		if (isPrintingProcess)
 		{
-			resumeSaveCounters (desc);
+			if (Description_isNbSizeDefined (desc))
+			{
+				fprintf (stderr, "\r- Benchmark computation process : %3d%% (Mixed sizes)\n",(curRuns*100) / (totalRuns));
+			}
+			else
+			{
+				fprintf (stderr, "\r- Benchmark computation process : 100%% (%d/%d)\n", lastVectorSize, end);
+			}
 		}
 		
-		if (isProcessEvalHandler && isRequestedToMakeFile)
-		{
-			fclose (outputCsvFile), outputCsvFile = NULL;
-		}
-	}
-	if (isPrintingProcess)
-	{
-		if (Description_isNbSizeDefined (desc))
-		{
-			fprintf (stderr, "\r- Benchmark computation process : %3d%% (Mixed sizes)\n",(curRuns*100) / (totalRuns));
-		}
-		else
+		
+		/* Gives the user value back for the next kernels */
+		Description_setRepetition (desc, minRepet);
+		
+		if (Benchmark_closeLibraries (dl_bench, NULL, 0, NULL, NULL) == -1)
 		{
-			fprintf (stderr, "\r- Benchmark computation process : 100%% (%d/%d)\n", nCurrentVectorSize-step, end);
+			return EXIT_FAILURE;
 		}
+		dl_bench = NULL;
 	}
 	
-	
 	/* Close timer */
 	for (i = 0; i < nbEvalLibs; i++)
 	{
@@ -1240,6 +1953,16 @@ int Benchmark_Wrapper (SDescription *desc, int currentExecRepet)
 		assert (timerCloseRes == EXIT_SUCCESS);
 	}
 
+	Arena_destroy (arena, desc), arena = NULL;
+	
+	Sampler_destroy (sampler), sampler = NULL;
+	Description_setSampler (desc, NULL);
+	Stepping_destroy (stepping), stepping = NULL;
+	Description_setStepping (desc, NULL);
+	
+	Audit_destroy (Description_getAudit (desc));
+	Description_setAudit (desc, NULL);
+	
 	/* Call the end function of the alloc library */
 	Description_getMyMallocDestroy (desc) ();
 
@@ -1270,6 +1993,17 @@ int Benchmark_Wrapper (SDescription *desc, int currentExecRepet)
 	free (overheadSizes), overheadSizes = NULL;
 
 	return EXIT_SUCCESS;
+}
+
+int Benchmark_Wrapper (SDescription *desc, int currentExecRepet)
+{
+	return Benchmark_run (desc, currentExecRepet, NULL, 1);
+}
+
+int Benchmark_Batch (SDescription *desc, int currentExecRepet, char **libraries, unsigned nbKernels)
+{
+	assert (libraries != NULL);
+	return Benchmark_run (desc, currentExecRepet, libraries, nbKernels);
 }		  
 
 void Benchmark_next (SDescription *desc,int *systemState)
@@ -1292,48 +2026,268 @@ void Benchmark_next (SDescription *desc,int *systemState)
 	}
 }
 
-void Benchmark_initCsv (SDescription *desc, FILE *stream) {
+void Benchmark_initCsv (SDescription *desc, SResultSink *sink) {
 	unsigned nbVectors = Description_getNbVectors (desc);
-	unsigned nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
 	unsigned i;
+	char buf[STRBUF_MAXLEN];
+
+	Benchmark_initCsvEvaluationColumns (desc, sink);
 	
-	for (i = 0; i < nbEvalLibs; i++)
+	if (Description_isAutoRepetitionEnabled (desc))
 	{
-		fprintf (stream, "\"Eval '%s'\",", Description_getEvaluationLibraryName (desc, i));
+		ResultSink_addColumn (sink, "Number of repetitions", RESULT_COLUMN_INTEGER);
 	}
+
+	ResultSink_addColumn (sink, "Id of current run", RESULT_COLUMN_INTEGER);
 	
-	fprintf (stream, "\"Id of current run\",\"Number of resumes\",\"Number of arrays\",");
+	/* A sweep file holds every vector size */
+	if (Description_isSweepEnabled (desc))
+	{
+		ResultSink_addColumn (sink, "Vector size", RESULT_COLUMN_INTEGER);
+	}
+	ResultSink_addColumn (sink, "Number of resumes", RESULT_COLUMN_INTEGER);
+	ResultSink_addColumn (sink, "Number of arrays", RESULT_COLUMN_INTEGER);
 	for (i = 0; i < nbVectors; i++)
 	{
-		fprintf (stream, "\"Vector #%d alignment\",", i+1);
+		snprintf (buf, sizeof (buf), "Vector #%d alignment", i+1);
+		ResultSink_addColumn (sink, buf, RESULT_COLUMN_INTEGER);
 	}
-	fprintf (stream, "\n");
+	ResultSink_addColumn (sink, "Problem", RESULT_COLUMN_ERROR);
 }
 
 /**
  @todo Find the purpose of the overhead argument
 **/
-void Benchmark_printCsv (BenchResult **res, unsigned nbEvalLibs, unsigned currentMetaRepet, int* offsets, unsigned nb_offsets, int nb_resumes, int currun, FILE *stream, int problem)
+void Benchmark_printCsv (SDescription *desc, BenchResult **res, unsigned nbEvalLibs, unsigned currentMetaRepet, int* offsets, unsigned nb_offsets, int nb_resumes, int currun, SResultSink *sink, int problem)
 {
 	unsigned i;
 	
-	for (i = 0; i < nbEvalLibs; i++)
+	Benchmark_printCsvEvaluationColumns (desc, res, nbEvalLibs, currentMetaRepet, sink);
+	
+	if (Description_isAutoRepetitionEnabled (desc))
 	{
-		fprintf (stream, "%0.6f,", res[i]->time[currentMetaRepet]);
+		ResultSink_put (sink, Description_getRepetition (desc));
 	}
 	
 	// id of current run, number of resumes, number of arrays, (offsets)*
-	fprintf (stream, "%d,%d,%d,", currun, nb_resumes, nb_offsets);
+	ResultSink_put (sink, currun);
+	if (Description_isSweepEnabled (desc))
+	{
+		ResultSink_put (sink, desc->temp_values.current_vector_size);
+	}
+	ResultSink_put (sink, nb_resumes);
+	ResultSink_put (sink, nb_offsets);
 	for(i = 0; i<nb_offsets; i++)
 	{
-		fprintf(stream, "%d,", offsets[i]);
+		ResultSink_put (sink, offsets[i]);
 	}
 	
-	/* If an error occured with the benchmark result */
-	if (problem != NO_ERROR)
+	/* If an error occured with the benchmark result (only printed in the CSV when there is one) */
+	ResultSink_put (sink, problem);
+	ResultSink_endRow (sink);
+}
+
+/**
+ * @brief Whether or not the repetition loop is timed by the fused driver (a prebuilt library or a failed generation has none)
+ */
+static inline int Benchmark_isFusedLoopReported (SDescription *desc)
+{
+	return Description_isFusedDriverEnabled (desc) && Description_getDriverFunction (desc) != NULL && Description_getExecFileName (desc) == NULL;
+}
+
+/**
+ * @brief Whether or not the measurement window is audited
+ */
+static inline int Benchmark_isAuditReported (SDescription *desc)
+{
+	return Description_isAuditEnabled (desc) && Description_getExecFileName (desc) == NULL;
+}
+
+/**
+ * @brief Whether or not the start skew between the benchmark processes is measured
+ */
+static inline int Benchmark_isStartSkewReported (SDescription *desc)
+{
+	return Description_getBarrierMode (desc) != BARRIER_PIPE && Description_getNbProcess (desc) > 1 && !Description_isSweepEnabled (desc);
+}
+
+void Benchmark_initCsvEvaluationColumns (SDescription *desc, SResultSink *sink)
+{
+	unsigned nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
+	unsigned i, c, nbCounters;
+	char buf[STRBUF_MAXLEN];
+	
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		nbCounters = Description_getEvaluationNbCounters (desc, i);
+		
+		/* One column per counter, or a single one for the value of the library */
+		for (c = 0; c < nbCounters; c++)
+		{
+			snprintf (buf, sizeof (buf), "Eval '%s' %s", Description_getEvaluationLibraryName (desc, i), Description_getEvaluationCounterName (desc, i, c));
+			ResultSink_addColumn (sink, buf, RESULT_COLUMN_REAL);
+		}
+		
+		if (nbCounters == 0)
+		{
+			snprintf (buf, sizeof (buf), "Eval '%s'", Description_getEvaluationLibraryName (desc, i));
+			ResultSink_addColumn (sink, buf, RESULT_COLUMN_REAL);
+		}
+	}
+	
+	if (Description_isAdaptiveModeEnabled (desc))
+	{
+		ResultSink_addColumn (sink, "Number of samples", RESULT_COLUMN_INTEGER);
+		ResultSink_addColumn (sink, "Achieved precision", RESULT_COLUMN_REAL);
+	}
+	
+	if (Benchmark_isStartSkewReported (desc))
+	{
+		ResultSink_addColumn (sink, "Start skew (cycles)", RESULT_COLUMN_INTEGER);
+	}
+	
+	if (Benchmark_isFusedLoopReported (desc))
+	{
+		ResultSink_addColumn (sink, "Fused loop (cycles)", RESULT_COLUMN_REAL);
+	}
+	
+	if (Benchmark_isAuditReported (desc))
+	{
+		for (i = 0; i < AUDIT_NB_EVENTS; i++)
+		{
+			ResultSink_addColumn (sink, Audit_getEventName (i), RESULT_COLUMN_INTEGER);
+		}
+		ResultSink_addColumn (sink, "Contaminated", RESULT_COLUMN_INTEGER);
+	}
+}
+
+void Benchmark_printCsvEvaluationColumns (SDescription *desc, BenchResult **res, unsigned nbEvalLibs, unsigned currentMetaRepet, SResultSink *sink)
+{
+	unsigned i, c;
+	
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		for (c = 0; c < res[i]->nbCounters; c++)
+		{
+			ResultSink_put (sink, res[i]->counters[c][currentMetaRepet]);
+		}
+		
+		if (res[i]->nbCounters == 0)
+		{
+			ResultSink_put (sink, res[i]->time[currentMetaRepet]);
+		}
+	}
+	
+	/* The precision is the one of the first evaluation library, which decides when to stop */
+	if (Description_isAdaptiveModeEnabled (desc))
+	{
+		ResultSink_put (sink, res[0]->nbSamples);
+		ResultSink_put (sink, res[0]->precision);
+	}
+	
+	if (Benchmark_isStartSkewReported (desc))
+	{
+		ResultSink_put (sink, res[0]->startSkew[currentMetaRepet]);
+	}
+	
+	if (Benchmark_isFusedLoopReported (desc))
+	{
+		ResultSink_put (sink, res[0]->fusedTime[currentMetaRepet]);
+	}
+	
+	/* A sample is contaminated if anything but the kernel happened in its window (-1: not audited) */
+	if (Benchmark_isAuditReported (desc))
 	{
-		fprintf (stream, "%d,", problem);
+		int contaminated = -1;
+		
+		for (i = 0; i < res[0]->nbAuditEvents; i++)
+		{
+			ResultSink_put (sink, res[0]->audit[i][currentMetaRepet]);
+			if (res[0]->audit[i][currentMetaRepet] >= 0 && contaminated != 1)
+			{
+				contaminated = (res[0]->audit[i][currentMetaRepet] > 0);
+			}
+		}
+		for (; i < AUDIT_NB_EVENTS; i++)
+		{
+			ResultSink_put (sink, -1);
+		}
+		ResultSink_put (sink, contaminated);
+	}
+}
+
+void Benchmark_initStatisticsCsv (SDescription *desc, FILE *stream)
+{
+	unsigned nbVectors = Description_getNbVectors (desc);
+	unsigned i;
+	
+	/* Kernel mode: one summary per configuration */
+	if (Description_getExecFileName (desc) == NULL)
+	{
+		fprintf (stream, "\"Id of current run\",");
+		for (i = 0; i < nbVectors; i++)
+		{
+			fprintf (stream, "\"Vector #%d alignment\",", i+1);
+		}
+	}
+	
+	fprintf (stream, "\"Run\",\"Column\",\"Samples\",\"Min\",\"P5\",\"P25\",\"Median\",\"P75\",\"P95\",\"Max\",\"Mean\",\"Stddev\",\"MAD\",\"Median CI95 low\",\"Median CI95 high\",\n");
+}
+
+/**
+ * @brief Writes one line of the statistics file
+ */
+static inline void Benchmark_printStatisticsLine (const char *run, const char *lib, const char *counter, const double *values, unsigned n,
+													int *offsets, unsigned nb_offsets, int currun, FILE *stream)
+{
+	SStatisticsSummary summary;
+	unsigned i;
+	
+	Statistics_summarize (values, n, &summary);
+	
+	if (offsets != NULL)
+	{
+		fprintf (stream, "%d,", currun);
+		for (i = 0; i < nb_offsets; i++)
+		{
+			fprintf (stream, "%d,", offsets[i]);
+		}
+	}
+	
+	if (counter != NULL)
+	{
+		fprintf (stream, "\"%s\",\"Eval '%s' %s\",", run, lib, counter);
+	}
+	else
+	{
+		fprintf (stream, "\"%s\",\"Eval '%s'\",", run, lib);
+	}
+	
+	fprintf (stream, "%u,%0.6f,%0.6f,%0.6f,%0.6f,%0.6f,%0.6f,%0.6f,%0.6f,%0.6f,%0.6f,%0.6f,%0.6f,\n", summary.n,
+			summary.min, summary.p5, summary.p25, summary.median, summary.p75, summary.p95, summary.max,
+			summary.mean, summary.stddev, summary.mad, summary.medianLow, summary.medianHigh);
+}
+
+void Benchmark_printStatisticsCsv (SDescription *desc, BenchResult **res, const char *run, int *offsets, unsigned nb_offsets, int currun, FILE *stream)
+{
+	unsigned nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
+	const char *lib;
+	unsigned i, c;
+	
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		lib = Description_getEvaluationLibraryName (desc, i);
+		
+		for (c = 0; c < res[i]->nbCounters; c++)
+		{
+			Benchmark_printStatisticsLine (run, lib, Description_getEvaluationCounterName (desc, i, c), res[i]->counters[c], res[i]->nbSamples,
+											offsets, nb_offsets, currun, stream);
+		}
+		
+		if (res[i]->nbCounters == 0)
+		{
+			Benchmark_printStatisticsLine (run, lib, NULL, res[i]->time, res[i]->nbSamples, offsets, nb_offsets, currun, stream);
+		}
 	}
-	fprintf(stream, "\n");
-	fflush(stream);
+	fflush (stream);
 }
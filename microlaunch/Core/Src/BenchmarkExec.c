@@ -21,6 +21,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
@@ -29,32 +30,136 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "Benchmark.h"
 #include "BenchmarkExec.h"
+#include "ChildStats.h"
 #include "Defines.h"
 #include "Description.h"
-#include "Dflush.h"
+#include "Flush.h"
+#include "ForkServer.h"
 #include "Log.h"
 #include "Progress.h"
+#include "ResultSink.h"
+#include "Roi.h"
 #include "Signal.h"
+#include "Statistics.h"
 #include "Toolkit.h"
 
+void BenchmarkExec_prepareChildOutput (SDescription *desc, int overhead, int isPrintingProcess)
+{
+	int fd;
+	char *redirect;
+	
+	// Output handling : Does the exec has to print something ?
+	if (!isPrintingProcess || Description_getSuppressOutput (desc) == 1)
+	{
+		fclose (stdout);
+		fclose (stderr);
+	}
+	
+	redirect = Description_getOutputFileStream (desc);
+	/* If redirect is defined, then let's redirect executable's output */
+	if (isPrintingProcess && overhead == 0 && redirect != NULL)
+	{
+		/* Opening file descriptor */
+		if((fd = open(redirect, O_APPEND|O_CREAT|O_RDWR, S_IRUSR|S_IWUSR|S_IRGRP)) == -1) { /*open the file */
+			perror("Error while opening file descriptor");
+			abort ();
+		}
+		
+		/* Duping stdout to our file descriptor */
+		if (dup2 (fd, STDOUT_FILENO) == -1)
+		{
+			Log_output (-1, "An error occured while dup2ing stdout...\n");
+			perror("");
+			abort ();
+		}
+		
+		/* Duping stderr to our file descriptor */
+		if (dup2 (fd, STDERR_FILENO) == -1)
+		{
+			Log_output (-1, "An error occured while dup2ing stderr...\n");
+			perror ("");
+			abort ();
+		}
+		
+		/* We don't need our file descriptor anymore, so we close it */
+		if (close (fd) == -1)
+		{
+			perror ("Error while closing file descriptor");
+			abort ();
+		}
+		
+		/* Just writing a bit in the document to make it readable between each repetition */
+		fprintf (stderr, "\n\nMicrolauncher execution...\n");
+	}
+}
+
+void BenchmarkExec_executeChild (SDescription *desc, char *fileName)
+{
+	/* Getting executable's argument... */
+	char **argv = Description_getExecArgv (desc);
+	
+	/* If argv == NULL, we have to create an argv table anyway... */
+	if (argv == NULL)
+	{
+		char *argvNull[] = { fileName, NULL };
+		execvp (fileName, argvNull);
+	}
+	/* Else, simply execute it with the argv table we got... */
+	else
+	{
+		execvp (fileName, argv);
+	}
+	
+	/* If we are there, it's because an error occured... */
+	Log_output (-1, "(from child #%d) An error occured when executing \"%s\"\n", getppid(), fileName);
+	perror("Error");
+	abort (); /* For signal handling, we emit a SIGABRT */
+}
+
+int BenchmarkExec_checkChildStatus (int status)
+{
+	/* Child must end normally */
+	if (WIFEXITED (status) == 0)
+	{
+		if (WIFSIGNALED (status))
+		{
+			 psignal (WTERMSIG (status), "Error: Input benchmark performed an error, exiting now...");
+			 exit (EXIT_FAILURE);
+		}
+		Log_output (-1, "Benchmark ended non-normally, exiting now...\n");
+		exit (EXIT_FAILURE);
+	}
+	
+	return WEXITSTATUS (status);
+}
+
 /**
  * @brief Executes the fileName program
  * @param fileName : the file name we wish to execute
  * @param desc : The description is set to get the fileName arguments
  * @param overhead : whether or not the current execution is overhead computation
  * @param isPrintingProcess : whether or not the current process has to print something
+ * @param stats : what is measured on the program itself (can be NULL)
  * @return the exit status of the fileName execution
  */
 int
-execLauncher ( SDescription *desc, char *fileName, int overhead, int isPrintingProcess )
+execLauncher ( SDescription *desc, char *fileName, int overhead, int isPrintingProcess, SChildStats *stats )
 {
-	int fd;
 	pid_t pid;
 	int res;
-	char *redirect;
+	int startPipe[2];
+	int waitForEvents = ChildStats_hasEvents (stats);
+	char go = 0;
 	
 	pushSignalHandler (SignalHandler_benchmark);
 	
+	/* The child waits for its events to be attached: they are enabled by its exec */
+	if (waitForEvents && pipe (startPipe) == -1)
+	{
+		perror ("Error: child events pipe creation");
+		exit (EXIT_FAILURE);
+	}
+	
 	switch (pid = fork ())
 	{
 		case -1:
@@ -64,88 +169,42 @@ execLauncher ( SDescription *desc, char *fileName, int overhead, int isPrintingP
 		}
 		case 0:
 		{
-			// Output handling : Does the exec has to print something ?
-			if (!isPrintingProcess || Description_getSuppressOutput (desc) == 1)
+			if (waitForEvents)
 			{
-				fclose (stdout);
-				fclose (stderr);
-			}
-			
-			redirect = Description_getOutputFileStream (desc);
-			/* If redirect is defined, then let's redirect executable's output */
-			if (isPrintingProcess && overhead == 0 && redirect != NULL)
-			{
-				/* Opening file descriptor */
-				if((fd = open(redirect, O_APPEND|O_CREAT|O_RDWR, S_IRUSR|S_IWUSR|S_IRGRP)) == -1) { /*open the file */
-					perror("Error while opening file descriptor");
-					abort ();
-				}
-				
-				/* Duping stdout to our file descriptor */
-				if (dup2 (fd, STDOUT_FILENO) == -1)
-				{
-					Log_output (-1, "An error occured while dup2ing stdout...\n");
-					perror("");
-					abort ();
-				}
-				
-				/* Duping stderr to our file descriptor */
-				if (dup2 (fd, STDERR_FILENO) == -1)
-				{
-					Log_output (-1, "An error occured while dup2ing stderr...\n");
-					perror ("");
-					abort ();
-				}
-				
-				/* We don't need our file descriptor anymore, so we close it */
-				if (close (fd) == -1)
+				close (startPipe[1]);
+				if (read (startPipe[0], &go, sizeof (go)) != sizeof (go))
 				{
-					perror ("Error while closing file descriptor");
 					abort ();
 				}
-				
-				/* Just writing a bit in the document to make it readable between each repetition */
-				fprintf (stderr, "\n\nMicrolauncher execution...\n");
-			}
-			
-			/* Getting executable's argument... */
-			char **argv = Description_getExecArgv (desc);
-			
-			/* If argv == NULL, we have to create an argv table anyway... */
-			if (argv == NULL)
-			{
-				char *argvNull[] = { fileName, NULL };
-				execvp (fileName, argvNull);
-			}
-			/* Else, simply execute it with the argv table we got... */
-			else
-			{
-				execvp (fileName, argv);
+				close (startPipe[0]);
 			}
 			
-			/* If we are there, it's because an error occured... */
-			Log_output (-1, "(from child #%d) An error occured when executing \"%s\"\n", getppid(), fileName);
-			perror("Error");
-			abort (); /* For signal handling, we emit a SIGABRT */
+			BenchmarkExec_prepareChildOutput (desc, overhead, isPrintingProcess);
+			BenchmarkExec_executeChild (desc, fileName);
+			break;
 		}
 		default:
 		{
 			// Father
 			int status;
-			waitpid (pid, &status, 0);
+			struct rusage usage;
 			
-			res = WEXITSTATUS (status);
-			/* Child must end normally */
-			if (WIFEXITED (status) == 0)
+			if (waitForEvents)
 			{
-				if (WIFSIGNALED (status))
+				close (startPipe[0]);
+				ChildStats_attach (stats, pid, 1);
+				if (write (startPipe[1], &go, sizeof (go)) != sizeof (go))
 				{
-					 psignal (WTERMSIG (status), "Error: Input benchmark performed an error, exiting now...");
-					 exit (EXIT_FAILURE);
+					perror ("Error while releasing the child");
+					exit (EXIT_FAILURE);
 				}
-				Log_output (-1, "Benchmark ended non-normally, exiting now...\n");
-				exit (EXIT_FAILURE);
+				close (startPipe[1]);
 			}
+			
+			wait4 (pid, &status, 0, &usage);
+			
+			res = BenchmarkExec_checkChildStatus (status);
+			ChildStats_measure (stats, &usage);
 			break;
 		}
 	}
@@ -167,10 +226,12 @@ static inline double Benchmark_launchEvalFunction (evaluationFct fct, int isPrin
  * @brief Benchmark entry point for executables
  * @param desc the SDescription of this execution
  * @param EnableSync Enable/Disable the synchronisation (we are too fast in the overhead computation it leads to unstable beahavior)
+ * @param roi the region of interest handler (NULL if the whole execution is measured)
+ * @param stats what is measured on the executed program itself (can be NULL)
  * @return the benchmark result (can be NULL)
  */
 void
-benchmark_exec ( BenchResult **res, SDescription *desc, int EnableSync, int overhead)
+benchmark_exec ( BenchResult **res, SDescription *desc, int EnableSync, int overhead, SRoi *roi, SChildStats *stats)
 {
 	int coarse_loop;
 	uint64_t iterations = 0;
@@ -183,21 +244,22 @@ benchmark_exec ( BenchResult **res, SDescription *desc, int EnableSync, int over
 	void *evalData;
 	int isPrintingProcess = Description_isPrintingProcess (desc);
 	int isProcessEvalHandler = Description_isProcessEvalHandler (desc);
+	/* In ROI mode, the target itself drives the evaluation libraries */
+	int isMeasuringProcess = isProcessEvalHandler && roi == NULL;
 	int nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
-	double *dummyArray = Description_getDummyArrayAligned (desc);
-	unsigned dummySize = Description_getDummySize (desc);
 	verificationFctInit verifyInit = Description_getVerificationInitFct (desc);
 	verificationFctDisplay verifyDisplay = Description_getVerificationDisplayFct (desc);
 	verificationFctDestroy verifyDestroy = Description_getVerificationDestroyFct (desc);
 	int i;
+	int precisionReached = 0;
 	FILE *fp;
 	void *verifyContextData;
+	char emptyFileName[STRBUF_MAXLEN];
+	char *fileName = Description_getExecFileName (desc);
+	SForkServer *server = NULL;
 	
 	pushSignalHandler (SignalHandler_launchingBenchmark);
 
-	int *pipeSF = Description_getTubeSF (desc);
-	int *pipeFS = Description_getTubeFS (desc);
-
 	//Paranoid
 	assert (res != NULL);
 	
@@ -213,7 +275,7 @@ benchmark_exec ( BenchResult **res, SDescription *desc, int EnableSync, int over
 		verifyContextData = verifyInit (desc);
 		
 		/* Launch with verification */
-		execLauncher (desc, Description_getExecFileName ( desc ), 0, isPrintingProcess );
+		execLauncher (desc, Description_getExecFileName ( desc ), 0, isPrintingProcess, NULL );
 		
 		/* Display and close verification context */
 		verifyDisplay (verifyContextData, fp);
@@ -221,6 +283,27 @@ benchmark_exec ( BenchResult **res, SDescription *desc, int EnableSync, int over
 		fclose (fp), fp = NULL;
 	}
 	
+	/* The overhead is computed with an empty program */
+	if (overhead == 1)
+	{
+		snprintf (emptyFileName, sizeof (emptyFileName), "%s/%s", MLDIR, "example/empty/empty");
+		fileName = emptyFileName;
+	}
+	
+	if (roi != NULL)
+	{
+		Roi_setEmpty (roi, overhead);
+	}
+	
+	/* Fork-server mode: process creation and dynamic linking are paid once, here */
+	if (Description_isForkServerEnabled (desc))
+	{
+		server = ForkServer_start (desc, fileName, overhead, isPrintingProcess);
+		
+		/* The copies inherit the events of the server, which are gathered in it once they end */
+		ChildStats_attach (stats, server->pid, 0);
+	}
+	
 	// Meta loop that selects the lowest measure
 	for (coarse_loop = 0; coarse_loop < meta_repet ; coarse_loop ++)
 	{
@@ -229,11 +312,23 @@ benchmark_exec ( BenchResult **res, SDescription *desc, int EnableSync, int over
 		
 		if (EnableSync == 1)
 		{
-			barrierS (pipeSF, pipeFS);
+			barrierS (desc);
+		}
+		
+		/* Adaptive mode: once the precision is reached, the remaining meta-repetitions
+			only go through the barrier as the father expects meta_repet of them */
+		if (precisionReached)
+		{
+			continue;
 		}
 		
 		/* Flush Caches */
-		readDummyArray (dummyArray, dummySize);
+		Flush_caches (Description_getFlush (desc), desc, NULL);
+		
+		if (roi != NULL)
+		{
+			Roi_reset (roi);
+		}
 		
 		while (!timeIsOk)
 		{
@@ -248,25 +343,24 @@ benchmark_exec ( BenchResult **res, SDescription *desc, int EnableSync, int over
 				{
 					start = Description_getEvaluationStartFunction (desc, i);
 					evalData = Description_getEvaluationData (desc, i);
-					res[i]->initialTime = Benchmark_launchEvalFunction (start, isProcessEvalHandler, evalData);
+					res[i]->initialTime = Benchmark_launchEvalFunction (start, isMeasuringProcess, evalData);
 				}
 				
-				if (overhead == 1)
+				if (server != NULL)
 				{
-					char buf[STRBUF_MAXLEN];
-					snprintf (buf, sizeof (buf), "%s/%s", MLDIR, "example/empty/empty");
-					iterations = execLauncher (desc, buf, 1, isPrintingProcess );
+					iterations = ForkServer_run (server);
+					ChildStats_measure (stats, &server->usage);
 				}
 				else
 				{
-					iterations = execLauncher (desc, Description_getExecFileName ( desc ), 0, isPrintingProcess );
+					iterations = execLauncher (desc, fileName, overhead, isPrintingProcess, stats );
 				}
 				
 				for (i = nbEvalLibs-1; i >= 0; i--) /* Eval Stop */
 				{
 					stop = Description_getEvaluationStopFunction (desc, i);
 					evalData = Description_getEvaluationData (desc, i);
-					res[i]->finalTime = Benchmark_launchEvalFunction (stop, isProcessEvalHandler, evalData);
+					res[i]->finalTime = Benchmark_launchEvalFunction (stop, isMeasuringProcess, evalData);
 				}
 				/* --------------------------------------*/
 
@@ -292,9 +386,38 @@ benchmark_exec ( BenchResult **res, SDescription *desc, int EnableSync, int over
 			res[i]->time[coarse_loop] = res[i]->finalTime - res[i]->initialTime;
 			res[i]->iterations[coarse_loop] = iterations;
 		}
+		
+		if (roi != NULL)
+		{
+			if (Roi_store (roi, res, nbEvalLibs, coarse_loop) == 0 && overhead == 0 && coarse_loop == 0)
+			{
+				Log_output (-1, "Warning: \"%s\" did not go through any ml_roi_begin/ml_roi_end region.\n", fileName);
+			}
+		}
+		else if (isProcessEvalHandler)
+		{
+			Benchmark_storeEvaluationCounters (res, desc, coarse_loop);
+		}
+		ChildStats_store (stats, coarse_loop);
+		
+		if (EnableSync == 1)
+		{
+			Benchmark_storeStartSkew (res, desc, coarse_loop);
+		}
+		
+		precisionReached = Benchmark_updatePrecision (res, desc, coarse_loop + 1);
 	}
 	
 	Benchmark_printProgress (isPrintingProcess, meta_repet, meta_repet, overhead, 1);
+	
+	Flush_report (Description_getFlush (desc), isPrintingProcess);
+	
+	ForkServer_stop (server), server = NULL;
+	
+	if (roi != NULL)
+	{
+		Roi_setEmpty (roi, 0);
+	}
 
 	popSignalHandler ();
 }
@@ -352,35 +475,12 @@ static inline void *Benchmark_loadEvaluationFunctions (SDescription *desc, const
 		Description_setEvaluationInitFunction (desc, initFct, idX);
 		Description_setEvaluationCloseFunction (desc, closeFct, idX);
 		Description_setEvaluationLibraryOverheadFlag (desc, overheadFlag, idX);
+		Benchmark_loadEvaluationOptionalFunctions (desc, dl, idX);
 	}
 	
 	return dl;
 }
 
-static inline BenchResult *BenchResult_create (int meta_repet)
-{
-	BenchResult *br;
-	
-	br = malloc (sizeof (*br));
-	assert (br != NULL);
-	
-	br->time = malloc ( meta_repet * sizeof (*br->time));
-	br->iterations = malloc ( meta_repet * sizeof (*br->iterations));
-	assert (br->iterations != NULL);
-	assert (br->time != NULL);
-	
-	return br;
-}
-
-static inline void BenchResult_destroy (BenchResult *br)
-{
-	assert (br != NULL);
-	
-	free (br->time), br->time = NULL;
-	free (br->iterations), br->iterations = NULL;
-	free (br), br = NULL;
-}
-
 /**
  * @brief Benchmark launching executable
  * @param desc : The program parameters to be used
@@ -395,7 +495,8 @@ int Benchmark_Exec (SDescription *desc, int currentExecRepet)
 	BenchResult **overhead;
 	BenchResult **res;
 	double *overheadAvg;
-	FILE *outputCsvFile  = NULL;
+	SResultSink *outputSink = NULL;
+	FILE *statisticsFile = NULL;
 	void **dl_eval;
 	evaluationLogisticFctInit init_timer;
 	evaluationLogisticFctClose close_timer;
@@ -408,6 +509,8 @@ int Benchmark_Exec (SDescription *desc, int currentExecRepet)
 	unsigned evalLoop;
 	void *evalData;
 	int isRequestedToMakeFile = Description_getPromptOutputCsv (desc);
+	SRoi *roi = NULL;
+	SChildStats *childStats = NULL;
 
 	pushSignalHandler (SignalHandler_child);
 	
@@ -456,50 +559,91 @@ int Benchmark_Exec (SDescription *desc, int currentExecRepet)
 			Log_output (-1, "Warning: It looks like you have allocated some data structure in the %s evaluation library. You have to free this yourself in your close handler.\n",
 					Description_getEvaluationLibraryName (desc, i));
 		}
+		
+		/* Libraries exporting several counters get one table per counter */
+		BenchResult_createCounters (res[i], Description_getEvaluationNbCounters (desc, i), nbMetaRepetition);
+		BenchResult_createCounters (overhead[i], Description_getEvaluationNbCounters (desc, i), nbMetaRepetition);
 	}
 	
 	/* Allocate dummy array for cache flushes */
 	Benchmark_makeDummyArray (desc);
 	
+	/* ROI mode: the executed programs preload the ROI library (after the thread pinner is set) */
+	if (Description_isRoiEnabled (desc))
+	{
+		roi = Roi_create (desc);
+	}
+	
+	/* Events and resource usage of the executed program itself */
+	if (isProcessEvalHandler)
+	{
+		childStats = ChildStats_create (desc, nbMetaRepetition);
+	}
+	
 	/* CSV output handling */
 	if (isProcessEvalHandler && isRequestedToMakeFile)
 	{
-		outputCsvFile = Benchmark_createOutputFile (desc, currentExecRepet, -1);
-		if (outputCsvFile == NULL)
+		outputSink = Benchmark_createOutputFile (desc, currentExecRepet, -1);
+		if (outputSink == NULL)
 		{
 			return EXIT_FAILURE;
 		}
-	   	BenchmarkExec_initCsv (desc, outputCsvFile);
+	   	BenchmarkExec_initCsv (desc, childStats, outputSink);
+	   	
+		statisticsFile = Benchmark_createStatisticsFile (desc);
+		if (statisticsFile == NULL)
+		{
+			return EXIT_FAILURE;
+		}
+		Benchmark_initStatisticsCsv (desc, statisticsFile);
 	}
 
 	/* Overhead computation */
-	benchmark_exec (overhead, desc, 1, 1);
+	benchmark_exec (overhead, desc, 1, 1, roi, NULL);
 	
 	/* Real computation */
-	benchmark_exec (res, desc, 1, 0);
+	benchmark_exec (res, desc, 1, 0, roi, childStats);
+	
+	Roi_destroy (roi), roi = NULL;
 	
 	if (isProcessEvalHandler && isRequestedToMakeFile)
 	{
-		/* Computing the overhead average for each evaluation library */
+		/* Computing the overhead for each evaluation library: the median is not moved by a single outlier */
 		for (evalLoop = 0; evalLoop < nbEvalLibs; evalLoop++)
 		{
-			overheadAvg[evalLoop] = 0;
-			
-			/* this lib requested no overhead computation */
+			/* this lib requested no overhead computation: only its calibrated read cost is removed */
+			overheadAvg[evalLoop] = Description_getEvaluationReadCost (desc, evalLoop, 0);
 			if (!Description_getEvaluationLibraryOverheadFlag(desc, evalLoop))
 			{
 				continue;
 			}
 			
-			for ( i = 0 ; i < nbMetaRepetition ; i++ )
+			overheadAvg[evalLoop] = Statistics_median (overhead[evalLoop]->time, overhead[evalLoop]->nbSamples);
+		}
+		
+		/* Counters are corrected the same way as the main value */
+		for (evalLoop = 0; evalLoop < nbEvalLibs; evalLoop++)
+		{
+			unsigned c;
+			
+			for (c = 0; c < res[evalLoop]->nbCounters; c++)
 			{
-				overheadAvg[evalLoop] += overhead[evalLoop]->time[i];
+				double counterOverhead = Description_getEvaluationReadCost (desc, evalLoop, c);
+				
+				if (Description_getEvaluationLibraryOverheadFlag (desc, evalLoop))
+				{
+					counterOverhead = Statistics_median (overhead[evalLoop]->counters[c], overhead[evalLoop]->nbSamples);
+				}
+				
+				for ( i = 0 ; i < res[evalLoop]->nbSamples ; i++ )
+				{
+					res[evalLoop]->counters[c][i] -= counterOverhead;
+				}
 			}
-			overheadAvg[evalLoop] /= nbMetaRepetition;
 		}
 		
 		/* Computing all values we wish to use */
-		for (i = 0 ; i < nbMetaRepetition ; i++)
+		for (i = 0 ; i < res[0]->nbSamples ; i++)
 		{
 			int problem = NO_ERROR;
 			for (evalLoop = 0; evalLoop < nbEvalLibs; evalLoop++)
@@ -513,11 +657,19 @@ int Benchmark_Exec (SDescription *desc, int currentExecRepet)
 			}
 			
 			/* Print every eval lib result in the CSV */
-			BenchmarkExec_printCsv (res, nbEvalLibs, i, outputCsvFile, problem);
+			BenchmarkExec_printCsv (desc, res, childStats, nbEvalLibs, i, outputSink, problem);
 		}
 		
+		Benchmark_printStatisticsCsv (desc, overhead, "Overhead (raw)", NULL, 0, 0, statisticsFile);
+		Benchmark_printStatisticsCsv (desc, res, "Result", NULL, 0, 0, statisticsFile);
+		
 		Benchmark_printDataSavingProgress (isPrintingProcess, nbMetaRepetition, nbMetaRepetition, 100, 0, 1);
-		fclose (outputCsvFile), outputCsvFile = NULL;
+		if (ResultSink_destroy (outputSink) == -1)
+		{
+			return EXIT_FAILURE;
+		}
+		outputSink = NULL;
+		fclose (statisticsFile), statisticsFile = NULL;
 	}
 	
 	/* Close Timer */
@@ -539,6 +691,7 @@ int Benchmark_Exec (SDescription *desc, int currentExecRepet)
 	}
 	free (res), res = NULL;
 	free (overhead), overhead = NULL;
+	ChildStats_destroy (childStats), childStats = NULL;
 	
 	for (i = 0; i < nbEvalLibs; i++)
 	{
@@ -565,33 +718,20 @@ int Benchmark_Exec (SDescription *desc, int currentExecRepet)
 	return EXIT_SUCCESS;
 }
 
-void BenchmarkExec_initCsv (SDescription *desc, FILE *stream) {
-	unsigned nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
-	unsigned i;
-	
-	for (i = 0; i < nbEvalLibs; i++)
-	{
-		fprintf (stream, "\"Eval '%s'\",", Description_getEvaluationLibraryName (desc, i));
-	}
-	fprintf (stream, "\n");
+void BenchmarkExec_initCsv (SDescription *desc, SChildStats *stats, SResultSink *sink) {
+	Benchmark_initCsvEvaluationColumns (desc, sink);
+	ChildStats_initCsv (stats, sink);
+	ResultSink_addColumn (sink, "Problem", RESULT_COLUMN_ERROR);
 }
 
-void BenchmarkExec_printCsv (BenchResult **res, unsigned nbEvalLibs, unsigned currentMetaRepet, FILE *stream, int problem)
+void BenchmarkExec_printCsv (SDescription *desc, BenchResult **res, SChildStats *stats, unsigned nbEvalLibs, unsigned currentMetaRepet, SResultSink *sink, int problem)
 {
-	unsigned i;
+	Benchmark_printCsvEvaluationColumns (desc, res, nbEvalLibs, currentMetaRepet, sink);
+	ChildStats_printCsv (stats, currentMetaRepet, sink);
 	
-	for (i = 0; i < nbEvalLibs; i++)
-	{
-		fprintf (stream, "%0.6f,", res[i]->time[currentMetaRepet]);
-	}
-	
-	/* If an error occured with the benchmark result */
-	if (problem != NO_ERROR)
-	{
-		fprintf (stream, "%d,", problem);
-	}
-	fprintf(stream, "\n");
-	fflush(stream);
+	/* If an error occured with the benchmark result (only printed in the CSV when there is one) */
+	ResultSink_put (sink, problem);
+	ResultSink_endRow (sink);
 }
 
 
@@ -0,0 +1,255 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ChildStats.h"
+#include "Defines.h"
+#include "Description.h"
+#include "Log.h"
+#include "PerfEvents.h"
+#include "ResultSink.h"
+
+static const char *rusageColumnNames[RUSAGE_NB_COLUMNS] =
+{
+	"Minor faults",
+	"Major faults",
+	"Voluntary context switches",
+	"Involuntary context switches",
+	"Max RSS (KB)"
+};
+
+static void ChildStats_detach (SChildStats *stats)
+{
+	unsigned e;
+	
+	for (e = 0; e < stats->nbEvents; e++)
+	{
+		if (stats->fds[e] != -1)
+		{
+			close (stats->fds[e]), stats->fds[e] = -1;
+		}
+	}
+}
+
+SChildStats *ChildStats_create (SDescription *desc, unsigned meta_repet)
+{
+	SChildStats *stats;
+	struct perf_event_attr attr;
+	char *events = Description_getChildEvents (desc);
+	unsigned e, c;
+	
+	if (events == NULL && !Description_isRusageEnabled (desc))
+	{
+		return NULL;
+	}
+	
+	stats = malloc (sizeof (*stats));
+	assert (stats != NULL);
+	memset (stats, 0, sizeof (*stats));
+	
+	if (events != NULL)
+	{
+		stats->eventList = strdup (events);
+		stats->eventNames = malloc ((strlen (events) / 2 + 1) * sizeof (*stats->eventNames));
+		assert (stats->eventList != NULL && stats->eventNames != NULL);
+		stats->nbEvents = PerfEvents_splitList (stats->eventList, ',', stats->eventNames, strlen (events) / 2 + 1);
+		
+		stats->fds = malloc (stats->nbEvents * sizeof (*stats->fds));
+		stats->baseline = malloc (stats->nbEvents * sizeof (*stats->baseline));
+		assert (stats->fds != NULL && stats->baseline != NULL);
+		
+		for (e = 0; e < stats->nbEvents; e++)
+		{
+			if (PerfEvents_parseEvent (stats->eventNames[e], &attr) == -1)
+			{
+				Log_output (-1, "Error: Unknown perf event \"%s\" in the child events.\n", stats->eventNames[e]);
+				exit (EXIT_FAILURE);
+			}
+			stats->fds[e] = -1;
+			stats->baseline[e] = 0.;
+		}
+	}
+	
+	stats->rusage = Description_isRusageEnabled (desc);
+	stats->nbColumns = stats->nbEvents + (stats->rusage ? RUSAGE_NB_COLUMNS : 0);
+	
+	stats->current = malloc (stats->nbColumns * sizeof (*stats->current));
+	stats->values = malloc (stats->nbColumns * sizeof (*stats->values));
+	assert (stats->current != NULL && stats->values != NULL);
+	for (c = 0; c < stats->nbColumns; c++)
+	{
+		stats->current[c] = 0.;
+		stats->values[c] = malloc (meta_repet * sizeof (**stats->values));
+		assert (stats->values[c] != NULL);
+		memset (stats->values[c], 0, meta_repet * sizeof (**stats->values));
+	}
+	
+	return stats;
+}
+
+void ChildStats_destroy (SChildStats *stats)
+{
+	unsigned c;
+	
+	if (stats == NULL)
+	{
+		return;
+	}
+	
+	ChildStats_detach (stats);
+	
+	for (c = 0; c < stats->nbColumns; c++)
+	{
+		free (stats->values[c]), stats->values[c] = NULL;
+	}
+	free (stats->values), stats->values = NULL;
+	free (stats->current), stats->current = NULL;
+	free (stats->baseline), stats->baseline = NULL;
+	free (stats->fds), stats->fds = NULL;
+	free (stats->eventNames), stats->eventNames = NULL;
+	free (stats->eventList), stats->eventList = NULL;
+	free (stats), stats = NULL;
+}
+
+int ChildStats_hasEvents (SChildStats *stats)
+{
+	return stats != NULL && stats->nbEvents > 0;
+}
+
+void ChildStats_attach (SChildStats *stats, pid_t pid, int enableOnExec)
+{
+	struct perf_event_attr attr;
+	unsigned e;
+	
+	if (stats == NULL)
+	{
+		return;
+	}
+	
+	ChildStats_detach (stats);
+	
+	for (e = 0; e < stats->nbEvents; e++)
+	{
+		PerfEvents_parseEvent (stats->eventNames[e], &attr);
+		
+		/* Threads and children of the program are counted with it, not microlaunch */
+		attr.inherit = 1;
+		attr.disabled = enableOnExec;
+		attr.enable_on_exec = enableOnExec;
+		
+		stats->fds[e] = PerfEvents_open (&attr, pid, -1, -1, 0);
+		if (stats->fds[e] == -1)
+		{
+			Log_output (-1, "Error: Cannot count \"%s\" on the executed program.\n", stats->eventNames[e]);
+			perror ("perf_event_open");
+			exit (EXIT_FAILURE);
+		}
+		stats->baseline[e] = 0.;
+	}
+}
+
+void ChildStats_measure (SChildStats *stats, struct rusage *usage)
+{
+	uint64_t count;
+	double *rusageColumns;
+	unsigned e;
+	
+	if (stats == NULL)
+	{
+		return;
+	}
+	
+	/* The counts of the ended threads and children are gathered in the followed process once they are reaped */
+	for (e = 0; e < stats->nbEvents; e++)
+	{
+		count = 0;
+		if (stats->fds[e] != -1 && read (stats->fds[e], &count, sizeof (count)) != sizeof (count))
+		{
+			count = 0;
+		}
+		stats->current[e] = count - stats->baseline[e];
+		stats->baseline[e] = count;
+	}
+	
+	if (stats->rusage && usage != NULL)
+	{
+		rusageColumns = stats->current + stats->nbEvents;
+		rusageColumns[RUSAGE_MINOR_FAULTS] = usage->ru_minflt;
+		rusageColumns[RUSAGE_MAJOR_FAULTS] = usage->ru_majflt;
+		rusageColumns[RUSAGE_VOLUNTARY_SWITCHES] = usage->ru_nvcsw;
+		rusageColumns[RUSAGE_INVOLUNTARY_SWITCHES] = usage->ru_nivcsw;
+		rusageColumns[RUSAGE_MAX_RSS] = usage->ru_maxrss;
+	}
+}
+
+void ChildStats_store (SChildStats *stats, unsigned idX)
+{
+	unsigned c;
+	
+	if (stats == NULL)
+	{
+		return;
+	}
+	
+	for (c = 0; c < stats->nbColumns; c++)
+	{
+		stats->values[c][idX] = stats->current[c];
+	}
+}
+
+void ChildStats_initCsv (SChildStats *stats, SResultSink *sink)
+{
+	unsigned e, c;
+	char buf[STRBUF_MAXLEN];
+	
+	if (stats == NULL)
+	{
+		return;
+	}
+	
+	for (e = 0; e < stats->nbEvents; e++)
+	{
+		snprintf (buf, sizeof (buf), "Child '%s'", stats->eventNames[e]);
+		ResultSink_addColumn (sink, buf, RESULT_COLUMN_REAL);
+	}
+	
+	for (c = 0; stats->rusage && c < RUSAGE_NB_COLUMNS; c++)
+	{
+		ResultSink_addColumn (sink, rusageColumnNames[c], RESULT_COLUMN_REAL);
+	}
+}
+
+void ChildStats_printCsv (SChildStats *stats, unsigned idX, SResultSink *sink)
+{
+	unsigned c;
+	
+	if (stats == NULL)
+	{
+		return;
+	}
+	
+	for (c = 0; c < stats->nbColumns; c++)
+	{
+		ResultSink_put (sink, stats->values[c][idX]);
+	}
+}
@@ -0,0 +1,224 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CompileCache.h"
+#include "Defines.h"
+#include "Log.h"
+
+/* FNV-1a parameters, the second lane starts from another basis to widen the key to 128 bits */
+#define COMPILECACHE_FNV_PRIME 0x100000001b3ULL
+#define COMPILECACHE_FNV_BASIS 0xcbf29ce484222325ULL
+#define COMPILECACHE_FNV_BASIS2 0x84222325cbf29ce4ULL
+
+/**
+ * @brief struct sCompileCacheKey is the running hash of a compilation
+ */
+typedef struct sCompileCacheKey
+{
+	uint64_t low;	/**< @brief First lane */
+	uint64_t high;	/**< @brief Second lane */
+} SCompileCacheKey;
+
+static void CompileCache_hash (SCompileCacheKey *key, const void *data, size_t size)
+{
+	const unsigned char *bytes = data;
+	size_t i;
+	
+	for (i = 0; i < size; i++)
+	{
+		key->low = (key->low ^ bytes[i]) * COMPILECACHE_FNV_PRIME;
+		key->high = (key->high ^ bytes[i] ^ (key->low >> 56)) * COMPILECACHE_FNV_PRIME;
+	}
+}
+
+/**
+ * @brief Hashes a string with its terminating character, so that consecutive fields cannot be mixed up
+ */
+static void CompileCache_hashString (SCompileCacheKey *key, const char *str)
+{
+	if (str == NULL)
+	{
+		str = "";
+	}
+	CompileCache_hash (key, str, strlen (str) + 1);
+}
+
+/**
+ * @brief Hashes the contents of a file
+ * @return 0 on success, -1 if the file cannot be read
+ */
+static int CompileCache_hashFile (SCompileCacheKey *key, const char *fileName)
+{
+	char buf[65536];
+	size_t size, total = 0;
+	FILE *f = fopen (fileName, "rb");
+	
+	if (f == NULL)
+	{
+		return -1;
+	}
+	
+	while ((size = fread (buf, 1, sizeof (buf), f)) > 0)
+	{
+		CompileCache_hash (key, buf, size);
+		total += size;
+	}
+	
+	if (ferror (f))
+	{
+		fclose (f);
+		return -1;
+	}
+	fclose (f);
+	
+	CompileCache_hash (key, &total, sizeof (total));
+	return 0;
+}
+
+/**
+ * @brief Hashes the compiler identity: its resolved path, size and modification time, so that an upgrade invalidates the entries
+ * @return 0 on success, -1 if the compiler is not found in the PATH
+ */
+static int CompileCache_hashCompiler (SCompileCacheKey *key)
+{
+	char *path = getenv ("PATH");
+	char candidate[PATH_MAX], resolved[PATH_MAX];
+	const char *start, *end;
+	struct stat st;
+	
+	if (path == NULL)
+	{
+		return -1;
+	}
+	
+	for (start = path; *start != '\0'; start = (*end == ':') ? end + 1 : end)
+	{
+		unsigned w_size;
+		
+		end = strchr (start, ':');
+		if (end == NULL)
+		{
+			end = start + strlen (start);
+		}
+		
+		w_size = snprintf (candidate, sizeof (candidate), "%.*s/%s", (int) (end - start), start, COMPILECACHE_COMPILER);
+		if (w_size >= sizeof (candidate) || end == start)
+		{
+			continue;
+		}
+		
+		if (access (candidate, X_OK) == 0 && realpath (candidate, resolved) != NULL && stat (resolved, &st) == 0)
+		{
+			CompileCache_hashString (key, resolved);
+			CompileCache_hash (key, &st.st_size, sizeof (st.st_size));
+			CompileCache_hash (key, &st.st_mtime, sizeof (st.st_mtime));
+			return 0;
+		}
+	}
+	
+	return -1;
+}
+
+int CompileCache_lookup (const char *source, const char *flags, const char *ompPath, const char *suffix, char *path, size_t size)
+{
+	SCompileCacheKey key = {COMPILECACHE_FNV_BASIS, COMPILECACHE_FNV_BASIS2};
+	char dir[STRBUF_MAXLEN];
+	unsigned w_size;
+	
+	assert (source != NULL && path != NULL);
+	
+	w_size = snprintf (dir, sizeof (dir), "%s/%s", MLDIR, COMPILECACHE_DIR);
+	assert (w_size < sizeof (dir));
+	
+	if (mkdir (dir, 0777) != 0 && errno != EEXIST)
+	{
+		Log_output (-1, "Warning: Cannot create the compilation cache \"%s\" (%s), compiling without it.\n", dir, strerror (errno));
+		return -1;
+	}
+	
+	if (CompileCache_hashFile (&key, source) != 0)
+	{
+		return -1;
+	}
+	
+	if (CompileCache_hashCompiler (&key) != 0)
+	{
+		Log_output (-1, "Warning: Cannot find \"%s\" in the PATH, compiling without the compilation cache.\n", COMPILECACHE_COMPILER);
+		return -1;
+	}
+	
+	CompileCache_hashString (&key, flags);
+	CompileCache_hashString (&key, ompPath);
+	
+	w_size = snprintf (path, size, "%s/%016llx%016llx%s", dir,
+						(unsigned long long) key.high, (unsigned long long) key.low, (suffix != NULL) ? suffix : "");
+	if (w_size >= size)
+	{
+		return -1;
+	}
+	
+	return (access (path, F_OK) == 0);
+}
+
+int CompileCache_createTemporary (const char *path, char *tmp, size_t size)
+{
+	unsigned w_size;
+	int fd;
+	
+	assert (path != NULL && tmp != NULL);
+	
+	w_size = snprintf (tmp, size, "%s.XXXXXX", path);
+	if (w_size >= size)
+	{
+		return -1;
+	}
+	
+	fd = mkstemp (tmp);
+	if (fd == -1)
+	{
+		return -1;
+	}
+	close (fd); /* Because mkstemp opens the file and we don't need it */
+	
+	return 0;
+}
+
+int CompileCache_commit (const char *tmp, const char *path)
+{
+	assert (tmp != NULL && path != NULL);
+	
+	/* mkstemp creates the file with 0600, the entry has to be usable as an executable by the other users of the cache */
+	if (chmod (tmp, 0755) != 0 || rename (tmp, path) != 0)
+	{
+		Log_output (-1, "Warning: Cannot store \"%s\" in the compilation cache (%s).\n", path, strerror (errno));
+		remove (tmp);
+		return -1;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,291 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "CompilePipeline.h"
+#include "Description.h"
+#include "Log.h"
+#include "Toolkit.h"
+#include "Topology.h"
+
+/**
+ * @brief struct sCompilePipelineRecord is sent back by the compiler processes for each kernel
+ */
+typedef struct sCompilePipelineRecord
+{
+	int kernelId;	/**< @brief The kernel */
+	int status;		/**< @brief EXIT_SUCCESS if the kernel is in the compilation cache */
+} SCompilePipelineRecord;
+
+/**
+ * @brief Computes the processors left to the compiler processes: the available ones minus the ones the benchmark runs on
+ * @param desc the SDescription of the run
+ * @param cpus the set to be filled
+ * @return the number of processors in the set
+ */
+static int CompilePipeline_getFreeCpus (SDescription *desc, cpu_set_t *cpus)
+{
+	const STopology *topology = Topology_get ();
+	int order[TOPOLOGY_MAX_CPUS];
+	char *list = getenv (TOPOLOGY_ENV_PIN_CPUS);
+	int i, nb;
+	
+	memcpy (cpus, &topology->available, sizeof (*cpus));
+	
+	if (Description_getOmpPath (desc) != NULL)
+	{
+		/* The OpenMP threads run anywhere unless a pinning policy placed them */
+		nb = (list != NULL) ? Topology_parseCpuOrder (list, order, TOPOLOGY_MAX_CPUS) : 0;
+		if (nb <= 0)
+		{
+			CPU_ZERO (cpus);
+		}
+		for (i = 0; i < nb; i++)
+		{
+			CPU_CLR (order[i], cpus);
+		}
+	}
+	else if (Description_isThreadPinningEnabled (desc) == 0)
+	{
+		CPU_ZERO (cpus);
+	}
+	else if (Description_isCpuPinDefined (desc))
+	{
+		CPU_CLR (Description_getCPUDest (desc), cpus);
+	}
+	else
+	{
+		for (i = 0; i < Description_getNbProcess (desc); i++)
+		{
+			CPU_CLR (Description_getPinningAt (desc, i), cpus);
+		}
+	}
+	
+	return CPU_COUNT (cpus);
+}
+
+/**
+ * @brief Main loop of a compiler process: compiles the queued kernels into the compilation cache until it receives a negative id
+ */
+static void CompilePipeline_worker (SCompilePipeline *pipeline, SDescription *desc)
+{
+	SCompilePipelineRecord record;
+	int status;
+	pid_t pid;
+	
+	close (pipeline->queue[1]);
+	close (pipeline->done[0]);
+	
+	while (read (pipeline->queue[0], &record.kernelId, sizeof (record.kernelId)) == sizeof (record.kernelId)
+			&& record.kernelId >= 0)
+	{
+		/* compileInputFile exits on error, each compilation gets its own process */
+		pid = fork ();
+		if (pid == 0)
+		{
+			Description_setKernelCurrentFileId (desc, record.kernelId);
+			compileInputFile (desc);
+			
+			/* The cache could not be used, this copy is useless */
+			if (desc->dynlibDelete != 0)
+			{
+				remove (Description_getDynamicLibraryName (desc));
+				_exit (EXIT_FAILURE);
+			}
+			_exit (EXIT_SUCCESS);
+		}
+		
+		record.status = EXIT_FAILURE;
+		if (pid > 0 && waitpid (pid, &status, 0) == pid && WIFEXITED (status))
+		{
+			record.status = WEXITSTATUS (status);
+		}
+		
+		if (write (pipeline->done[1], &record, sizeof (record)) != sizeof (record))
+		{
+			break;
+		}
+	}
+	
+	_exit (EXIT_SUCCESS);
+}
+
+SCompilePipeline *CompilePipeline_create (SDescription *desc)
+{
+	SCompilePipeline *pipeline;
+	cpu_set_t cpus;
+	int nbCpus;
+	unsigned i;
+	
+	assert (desc != NULL);
+	
+	if (Description_getCompileJobs (desc) <= 0 || Description_getExecFileName (desc) != NULL
+		|| Description_getKernelFileNamesTabSize (desc) <= 1 || Description_isCompileCacheEnabled (desc) == 0)
+	{
+		return NULL;
+	}
+	
+	pipeline = malloc (sizeof (*pipeline));
+	assert (pipeline != NULL);
+	memset (pipeline, 0, sizeof (*pipeline));
+	
+	pipeline->nbKernels = Description_getKernelFileNamesTabSize (desc);
+	pipeline->depth = Description_getCompileAhead (desc);
+	pipeline->states = malloc (pipeline->nbKernels * sizeof (*pipeline->states));
+	assert (pipeline->states != NULL);
+	memset (pipeline->states, COMPILEPIPELINE_WAITING, pipeline->nbKernels * sizeof (*pipeline->states));
+	
+	if (pipe (pipeline->queue) != 0 || pipe (pipeline->done) != 0)
+	{
+		perror ("Error: Cannot create the compilation pipeline ");
+		exit (EXIT_FAILURE);
+	}
+	
+	nbCpus = CompilePipeline_getFreeCpus (desc, &cpus);
+	if (nbCpus == 0)
+	{
+		Log_output (-1, "Warning: No processor is left free by the benchmark, the compiler processes share its processors with a lower priority\n");
+	}
+	else
+	{
+		Log_output (5, "Info: The compiler processes run on %d processor(s) left free by the benchmark\n", nbCpus);
+	}
+	
+	pipeline->nbWorkers = Description_getCompileJobs (desc);
+	pipeline->workers = malloc (pipeline->nbWorkers * sizeof (*pipeline->workers));
+	assert (pipeline->workers != NULL);
+	
+	for (i = 0; i < pipeline->nbWorkers; i++)
+	{
+		pipeline->workers[i] = fork ();
+		
+		if (pipeline->workers[i] == 0)
+		{
+			if (nbCpus > 0 && sched_setaffinity (0, sizeof (cpus), &cpus) != 0)
+			{
+				perror ("Warning: Cannot pin the compiler process ");
+			}
+			if (setpriority (PRIO_PROCESS, 0, COMPILEPIPELINE_NICE) != 0)
+			{
+				perror ("Warning: Cannot lower the compiler process priority ");
+			}
+			
+			CompilePipeline_worker (pipeline, desc);
+		}
+		else if (pipeline->workers[i] < 0)
+		{
+			perror ("fork");
+			exit (EXIT_FAILURE);
+		}
+	}
+	
+	close (pipeline->queue[0]), pipeline->queue[0] = -1;
+	close (pipeline->done[1]), pipeline->done[1] = -1;
+	
+	return pipeline;
+}
+
+void CompilePipeline_wait (SCompilePipeline *pipeline, unsigned kernelId)
+{
+	SCompilePipelineRecord record;
+	ssize_t size;
+	
+	if (pipeline == NULL)
+	{
+		return;
+	}
+	
+	assert (kernelId < pipeline->nbKernels);
+	
+	/* The queue is bounded: only the measured kernel and the next ones up to the depth are compiled */
+	if (pipeline->next <= kernelId)
+	{
+		pipeline->next = kernelId;
+	}
+	while (pipeline->next < pipeline->nbKernels && pipeline->next <= kernelId + pipeline->depth)
+	{
+		int id = pipeline->next;
+		
+		if (write (pipeline->queue[1], &id, sizeof (id)) != sizeof (id))
+		{
+			Log_output (-1, "Warning: Cannot queue kernel #%d for compilation (%s)\n", id, strerror (errno));
+			break;
+		}
+		pipeline->states[id] = COMPILEPIPELINE_QUEUED;
+		pipeline->next++;
+	}
+	
+	/* Collect the compiled kernels until the measured one is ready */
+	while (pipeline->states[kernelId] == COMPILEPIPELINE_QUEUED)
+	{
+		size = read (pipeline->done[0], &record, sizeof (record));
+		if (size == -1 && errno == EINTR)
+		{
+			continue;
+		}
+		if (size != sizeof (record))
+		{
+			Log_output (-1, "Warning: The compiler processes stopped, the kernels are compiled in series\n");
+			break;
+		}
+		
+		assert (record.kernelId >= 0 && (unsigned) record.kernelId < pipeline->nbKernels);
+		pipeline->states[record.kernelId] = (record.status == EXIT_SUCCESS) ? COMPILEPIPELINE_READY : COMPILEPIPELINE_FAILED;
+	}
+}
+
+void CompilePipeline_destroy (SCompilePipeline *pipeline)
+{
+	int quit = -1;
+	unsigned i;
+	
+	if (pipeline == NULL)
+	{
+		return;
+	}
+	
+	for (i = 0; i < pipeline->nbWorkers; i++)
+	{
+		if (write (pipeline->queue[1], &quit, sizeof (quit)) != sizeof (quit))
+		{
+			kill (pipeline->workers[i], SIGTERM);
+		}
+	}
+	
+	for (i = 0; i < pipeline->nbWorkers; i++)
+	{
+		waitpid (pipeline->workers[i], NULL, 0);
+	}
+	
+	close (pipeline->queue[1]);
+	close (pipeline->done[0]);
+	free (pipeline->workers), pipeline->workers = NULL;
+	free (pipeline->states), pipeline->states = NULL;
+	free (pipeline), pipeline = NULL;
+}
@@ -252,6 +252,41 @@ int Config_parseXML (SDescription *desc, const char *filename)
 			}
 		}
 		
+		if (Config_isSetNode (tmp, "vectorStepping")) // <vectorStepping>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_parseVectorStepping (desc, buf);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "vectorRatio")) // <vectorRatio>
+		{
+			double ratio;
+			if (Config_getNodeAttribute (tmp, "value", C_DOUBLE, &ratio))
+			{
+				Description_setVectorRatio (desc, ratio);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "vectorPoints")) // <vectorPoints>
+		{
+			if (Config_getNodeAttribute (tmp, "value", C_INT, &val))
+			{
+				Description_setVectorPoints (desc, val);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "vectorThreshold")) // <vectorThreshold>
+		{
+			double threshold;
+			if (Config_getNodeAttribute (tmp, "value", C_DOUBLE, &threshold))
+			{
+				Description_setVectorThreshold (desc, threshold);
+			}
+		}
+		
 		if (Config_isSetNode (tmp, "iterationCount")) // <iterationCount>
 		{
 			if (Config_getNodeAttribute (tmp, "value", C_INT, &val))
@@ -269,6 +304,32 @@ int Config_parseXML (SDescription *desc, const char *filename)
 			}
 		}
 		
+		if (Config_isSetNode (tmp, "minMetaRepetition")) // <minMetaRepetition>
+		{
+			if (Config_getNodeAttribute (tmp, "value", C_INT, &val))
+			{
+				Description_setMinMetaRepetition (desc, val);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "adaptivePrecision")) // <adaptivePrecision>
+		{
+			double precision;
+			if (Config_getNodeAttribute (tmp, "value", C_DOUBLE, &precision))
+			{
+				Description_setAdaptivePrecision (desc, precision);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "adaptiveCriterion")) // <adaptiveCriterion>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_parseAdaptiveCriterion (desc, buf);
+			}
+		}
+		
 		if (Config_isSetNode (tmp, "repetition")) // <repetition>
 		{
 			if (Config_getNodeAttribute (tmp, "value", C_INT, &val))
@@ -277,6 +338,15 @@ int Config_parseXML (SDescription *desc, const char *filename)
 			}
 		}
 		
+		if (Config_isSetNode (tmp, "autoRepetition")) // <autoRepetition>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_parseAutoRepetition (desc, buf);
+			}
+		}
+		
 		if (Config_isSetNode (tmp, "executeRepetition")) // <executeRepetition>
 		{
 			if (Config_getNodeAttribute (tmp, "value", C_INT, &val))
@@ -388,6 +458,15 @@ int Config_parseXML (SDescription *desc, const char *filename)
 			}
 		}
 		
+		if (Config_isSetNode (tmp, "barrier")) // <barrier>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_parseBarrierMode (desc, buf);
+			}
+		}
+		
 		if (Config_isSetNode (tmp, "ompPath")) // <ompPath>
 		{
 			char buf[STRBUF_MAXLEN];
@@ -397,6 +476,92 @@ int Config_parseXML (SDescription *desc, const char *filename)
 			}
 		}
 		
+		if (Config_isSetNode (tmp, "noCompileCache")) // <noCompileCache>
+		{
+			Description_compileCacheDisable (desc);
+		}
+		
+		if (Config_isSetNode (tmp, "compileJobs")) // <compileJobs>
+		{
+			if (Config_getNodeAttribute (tmp, "value", C_INT, &val))
+			{
+				Description_setCompileJobs (desc, val);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "compileAhead")) // <compileAhead>
+		{
+			if (Config_getNodeAttribute (tmp, "value", C_INT, &val))
+			{
+				Description_setCompileAhead (desc, val);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "fusedDriver")) // <fusedDriver>
+		{
+			Description_fusedDriverEnable (desc);
+		}
+		
+		if (Config_isSetNode (tmp, "audit")) // <audit>
+		{
+			Description_auditEnable (desc);
+		}
+		
+		if (Config_isSetNode (tmp, "binaryOutput")) // <binaryOutput>
+		{
+			Description_binaryOutputEnable (desc);
+		}
+		
+		if (Config_isSetNode (tmp, "sweep")) // <sweep>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_parseSweepIsolation (desc, buf);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "alignmentSampling")) // <alignmentSampling>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_parseAlignmentSampling (desc, buf);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "alignmentSamples")) // <alignmentSamples>
+		{
+			int val;
+			if (Config_getNodeAttribute (tmp, "value", C_INT, &val))
+			{
+				Description_setAlignmentSamples (desc, val);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "alignmentSeed")) // <alignmentSeed>
+		{
+			long val;
+			if (Config_getNodeAttribute (tmp, "value", C_LONG, &val))
+			{
+				Description_setAlignmentSeed (desc, val);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "alignmentThreshold")) // <alignmentThreshold>
+		{
+			double threshold;
+			if (Config_getNodeAttribute (tmp, "value", C_DOUBLE, &threshold))
+			{
+				Description_setAlignmentThreshold (desc, threshold);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "batch")) // <batch>
+		{
+			Description_batchEnable (desc);
+		}
+		
 		if (Config_isSetNode (tmp, "maxStride")) // <maxStride>
 		{
 			if (Config_getNodeAttribute (tmp, "value", C_INT, &val))
@@ -461,6 +626,43 @@ int Config_parseXML (SDescription *desc, const char *filename)
 			}
 		}
 		
+		if (Config_isSetNode (tmp, "arena")) // <arena>
+		{
+			Description_arenaEnable (desc);
+		}
+		
+		if (Config_isSetNode (tmp, "flush")) // <flush>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_parseFlushStrategy (desc, buf);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "flushLevel")) // <flushLevel>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_parseFlushLevel (desc, buf);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "flushVerify")) // <flushVerify>
+		{
+			Description_flushVerifyEnable (desc);
+		}
+		
+		if (Config_isSetNode (tmp, "pinPolicy")) // <pinPolicy>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_parsePinPolicy (desc, buf);
+			}
+		}
+		
 		if (Config_isSetNode (tmp, "logOutput")) // <logOutput>
 		{
 			char buf[STRBUF_MAXLEN];
@@ -571,6 +773,30 @@ int Config_parseXML (SDescription *desc, const char *filename)
 			Description_setSuppressOutput (desc, 1);
 		}
 		
+		if (Config_isSetNode (tmp, "forkServer")) // <forkServer>
+		{
+			Description_forkServerEnable (desc);
+		}
+		
+		if (Config_isSetNode (tmp, "roi")) // <roi>
+		{
+			Description_roiEnable (desc);
+		}
+		
+		if (Config_isSetNode (tmp, "childEvents")) // <childEvents>
+		{
+			char buf[STRBUF_MAXLEN];
+			if (Config_getNodeAttribute (tmp, "value", C_STRING, &buf))
+			{
+				Description_setChildEvents (desc, buf);
+			}
+		}
+		
+		if (Config_isSetNode (tmp, "rusage")) // <rusage>
+		{
+			Description_rusageEnable (desc);
+		}
+		
 		if (Config_isSetNode (tmp, "noThreadPin")) // <noThreadPin>
 		{
 			Description_pinThreadDisable (desc);
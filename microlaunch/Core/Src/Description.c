@@ -19,6 +19,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <sched.h>
 
 #include <assert.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -26,11 +27,19 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#include "Audit.h"
+#include "Barrier.h"
 #include "Benchmark.h"
 #include "Config.h"
 #include "Description.h"
+#include "Flush.h"
 #include "Log.h"
+#include "Statistics.h"
+#include "Sampler.h"
+#include "Stepping.h"
+#include "Sweep.h"
 #include "Toolkit.h"
+#include "Topology.h"
 
 //Static function
 static char *reformatString (char *orig, int procId);
@@ -50,6 +59,11 @@ SDescription *Description_create (void)
 	Description_setStartVectorSize (res, DEFAULT_ARRAY_SIZE);
 	Description_setEndVectorSize (res, DEFAULT_ARRAY_SIZE);
 	Description_setVectorSizeStep (res, DEFAULT_STEP_VECTOR);
+	Description_setVectorStepping (res, STEPPING_LINEAR);
+	Description_setVectorRatio (res, STEPPING_DEFAULT_RATIO);
+	Description_setVectorPoints (res, DEFAULT_VECTOR_POINTS);
+	Description_setVectorThreshold (res, STEPPING_DEFAULT_THRESHOLD);
+	Description_setStepping (res, NULL);
 	Description_setVectorElementSize (res, DEFAULT_ELEM_SIZE);
 	Description_setCPUDest (res, DEFAULT_CPU_DEST);
 	Description_iterationCountDisable (res);
@@ -58,13 +72,41 @@ SDescription *Description_create (void)
 	Description_setNbPagesForCollision (res, DEFAULT_NBPAGESFORCOLLISION);
 	Description_setRepetition (res, DEFAULT_REPETITION);
 	Description_setMetaRepetition (res, DEFAULT_META_REPETITION);
+	Description_setMinMetaRepetition (res, DEFAULT_MIN_META_REPETITION);
+	Description_setAdaptivePrecision (res, DEFAULT_ADAPTIVE_PRECISION);
+	Description_setAdaptiveCriterion (res, DEFAULT_ADAPTIVE_CRITERION);
+	Description_setBarrierMode (res, DEFAULT_BARRIER_MODE);
+	Description_setBarrier (res, NULL);
+	Description_setAutoRepetitionTarget (res, DEFAULT_AUTO_REPETITION_TARGET);
+	Description_setAutoRepetitionUnit (res, AUTO_REPETITION_CYCLES);
 	Description_setExecuteRepets (res, DEFAULT_EXEC_REPETITION);
 	Description_setDummySize (res, DEFAULT_DUMMYSIZE);
+	Description_setFlushStrategy (res, DEFAULT_FLUSH_STRATEGY);
+	Description_setFlushLevel (res, DEFAULT_FLUSH_LEVEL);
+	Description_flushVerifyDisable (res);
+	res->flush = NULL;
 	Description_setMaxStride (res, DEFAULT_MAX_STRIDE);
 	Description_setLogOutput (res, stderr);
 	Description_setBaseName (res, NULL);				//OK
 	Description_setPromptOutputCsv (res, DEFAULT_PROMPT_OUTPUT);
 	Description_setOmpPath (res, NULL);
+	Description_compileCacheEnable (res);
+	Description_setCompileJobs (res, 0);
+	Description_setCompileAhead (res, DEFAULT_COMPILE_AHEAD);
+	Description_batchDisable (res);
+	Description_fusedDriverDisable (res);
+	Description_auditDisable (res);
+	Description_setAudit (res, NULL);
+	Description_binaryOutputDisable (res);
+	Description_sweepDisable (res);
+	Description_setSweepIsolation (res, SWEEP_ISOLATION_CPU);
+	Description_setSweep (res, NULL);
+	Description_setAlignmentSampling (res, SAMPLER_FULL);
+	Description_setAlignmentSamples (res, DEFAULT_ALIGNMENT_SAMPLES);
+	Description_setAlignmentSeed (res, 1);
+	Description_setAlignmentThreshold (res, SAMPLER_DEFAULT_THRESHOLD);
+	Description_setSampler (res, NULL);
+	Description_setDriverFunction (res, NULL);
 	Description_setKernelFileName (res, NULL);
 	Description_setOutputPath (res, NULL);
 	Description_setNbProcessorsAvailable (res, DEFAULT_NBPROC_AVAILABLE);
@@ -84,6 +126,13 @@ SDescription *Description_create (void)
 	Description_setNumber_of_resumes (res, DEFAULT_RESUME_NB);
 	Description_setResumeId (res, DEFAULT_RESUME_ID);
 	Description_pinThreadEnable (res);
+	Description_setPinPolicy (res, DEFAULT_PIN_POLICY);
+	res->pinList = NULL;
+	Description_forkServerDisable (res);
+	Description_roiDisable (res);
+	Description_arenaDisable (res);
+	Description_setChildEvents (res, NULL);
+	Description_rusageDisable (res);
 	Description_allProcessOutputDisable (res);
 	Description_disableSummary (res);
 	Description_setVerificationLibraryName (res, NULL);
@@ -124,10 +173,46 @@ void Description_setDefaults (SDescription *desc) {
 		Description_setMetaRepetition (desc, 1);
 	}
 	
+	if (Description_getAdaptivePrecision (desc) == DEFAULT_ADAPTIVE_PRECISION)
+	{
+		Log_output (5, "Info: Defining adaptive precision value : 0 (disabled)\n");
+		Description_setAdaptivePrecision (desc, 0);
+	}
+	
+	if (Description_getAdaptiveCriterion (desc) == DEFAULT_ADAPTIVE_CRITERION)
+	{
+		Log_output (5, "Info: Defining adaptive criterion value : ci\n");
+		Description_setAdaptiveCriterion (desc, ADAPTIVE_CI);
+	}
+	
+	if (Description_getBarrierMode (desc) == DEFAULT_BARRIER_MODE)
+	{
+		Log_output (5, "Info: Defining barrier value : futex\n");
+		Description_setBarrierMode (desc, BARRIER_FUTEX);
+	}
+	
+	if (Description_getAutoRepetitionTarget (desc) == DEFAULT_AUTO_REPETITION_TARGET)
+	{
+		Log_output (5, "Info: Defining auto-repetition value : 0 (disabled)\n");
+		Description_setAutoRepetitionTarget (desc, 0);
+	}
+	
+	if (Description_getMinMetaRepetition (desc) == DEFAULT_MIN_META_REPETITION)
+	{
+		Log_output (5, "Info: Defining minimum meta-repetition value : 5\n");
+		Description_setMinMetaRepetition (desc, 5);
+		
+		/* The default minimum mustn't be greater than the maximum */
+		if (Description_getMinMetaRepetition (desc) > Description_getMetaRepetition (desc))
+		{
+			Description_setMinMetaRepetition (desc, Description_getMetaRepetition (desc));
+		}
+	}
+	
 	if (Description_getCPUDest (desc) == DEFAULT_CPU_DEST)
 	{
-		Log_output (5, "Info: Defining CPU destination : 0\n");
-		Description_setCPUDest (desc, 0);
+		Log_output (5, "Info: Defining CPU destination : %d\n", Topology_getAvailableCpu (0));
+		Description_setCPUDest (desc, Topology_getAvailableCpu (0));
 	}
 	
 	if (Description_getRepetition (desc) == DEFAULT_REPETITION)
@@ -172,6 +257,31 @@ void Description_setDefaults (SDescription *desc) {
 		Description_setDummySize (desc, 3000000); /* We set this to 3M doubles, it should handle most of the current architectures */
 	}
 	
+	if (Description_getFlushStrategy (desc) == DEFAULT_FLUSH_STRATEGY)
+	{
+		Log_output (5, "Info: Defining flush strategy : read\n");
+		Description_setFlushStrategy (desc, FLUSH_READ);
+	}
+	
+	if (Description_getPinPolicy (desc) == DEFAULT_PIN_POLICY)
+	{
+		Log_output (5, "Info: Defining thread pinning policy : linear\n");
+		Description_setPinPolicy (desc, TOPOLOGY_PIN_LINEAR);
+	}
+	
+	if (Description_getCompileAhead (desc) == DEFAULT_COMPILE_AHEAD)
+	{
+		int ahead = (Description_getCompileJobs (desc) > 0) ? 2 * Description_getCompileJobs (desc) : 1;
+		Log_output (5, "Info: Defining compilation queue depth : %d\n", ahead);
+		Description_setCompileAhead (desc, ahead);
+	}
+	
+	if (Description_getFlushLevel (desc) == DEFAULT_FLUSH_LEVEL)
+	{
+		Log_output (5, "Info: Defining flush level : llc\n");
+		Description_setFlushLevel (desc, FLUSH_LEVEL_LLC);
+	}
+	
 	if (Description_getMaxStride (desc) == DEFAULT_MAX_STRIDE)
 	{
 		Log_output (5, "Info: Defining max stride value : 1\n");
@@ -234,6 +344,33 @@ void Description_setDefaults (SDescription *desc) {
 		Description_setExecArgc (desc, 0);
 	}
 	
+	/* The sweep workers are pinned on the processors kept by the isolation, --nbprocess only limits their number */
+	if (Description_isSweepEnabled (desc))
+	{
+		int *cpus = malloc (TOPOLOGY_MAX_CPUS * sizeof (*cpus));
+		int nbCpus, i;
+		
+		assert (cpus != NULL);
+		nbCpus = Sweep_getCpus (Description_getSweepIsolation (desc), cpus, TOPOLOGY_MAX_CPUS);
+		if (nbCpus == 0)
+		{
+			cpus[0] = Topology_getAvailableCpu (0);
+			nbCpus = 1;
+		}
+		
+		if (Description_getNbProcess (desc) == DEFAULT_NB_PROCESS || Description_getNbProcess (desc) > nbCpus)
+		{
+			Log_output (5, "Info: Defining nbProcess value : %d (sweep workers)\n", nbCpus);
+			Description_setNbProcess (desc, nbCpus);
+		}
+		
+		for (i = 0; i < Description_getNbProcess (desc); i++)
+		{
+			Description_setPinningAt (desc, cpus[i], i);
+		}
+		free (cpus), cpus = NULL;
+	}
+	
 	if (Description_getNbProcess (desc) == DEFAULT_NB_PROCESS)
 	{
 		Log_output (5, "Info: Defining nbProcess value : 1\n");
@@ -300,6 +437,8 @@ void Description_destroy (SDescription *desc)
 	{
 		free (desc->baseName), desc->baseName = NULL;
 		free (desc->dummyArrayNonAligned), desc->dummyArrayNonAligned = NULL;
+		Flush_destroy (desc->flush), desc->flush = NULL;
+		free (desc->pinList), desc->pinList = NULL;
 
 		if (desc->dynlibDelete != 0)
 		{
@@ -314,6 +453,7 @@ void Description_destroy (SDescription *desc)
 		free (desc->configFileName), desc->configFileName = NULL;
 		free (desc->outputPath), desc->outputPath = NULL;
 		free (desc->outputFileStream), desc->outputFileStream = NULL;
+		free (desc->childEvents), desc->childEvents = NULL;
 		free (desc->kernelInitFunctionName), desc->kernelInitFunctionName = NULL;
 		free (desc->vectorSizes), desc->vectorSizes = NULL;
 		free (desc->outputFileName), desc->outputFileName = NULL;
@@ -352,6 +492,10 @@ void Description_destroy (SDescription *desc)
 		free (desc->evaluationStart), desc->evaluationStart = NULL;
 		free (desc->evaluationStop), desc->evaluationStop = NULL;
 		free (desc->evaluationOverheadFlags), desc->evaluationOverheadFlags = NULL;
+		free (desc->evaluationCounterNb), desc->evaluationCounterNb = NULL;
+		free (desc->evaluationCounterName), desc->evaluationCounterName = NULL;
+		free (desc->evaluationCounterValue), desc->evaluationCounterValue = NULL;
+		free (desc->evaluationReadCost), desc->evaluationReadCost = NULL;
 		free (desc->evalData), desc->evalData = NULL;
 		free (desc->infoDisplayed), desc->infoDisplayed = NULL;
 		
@@ -382,6 +526,10 @@ void Description_ShowWarnings (SDescription *desc)
     if (Description_getOmpPath (desc) != NULL)
     {
     	Log_output (-1, "Warning: No process pinning because we are in OpenMP mode\n");
+    	if (Description_getPinPolicy (desc) == TOPOLOGY_PIN_LINEAR)
+    	{
+    		Log_output (-1, "Warning: The OpenMP threads are placed by the OpenMP runtime, see --pin-policy\n");
+    	}
     }
     
 	if(Description_getPromptOutputCsv (desc) == 0)
@@ -395,6 +543,11 @@ void Description_ShowWarnings (SDescription *desc)
 		Log_output (-1, "Warning: You're launching %d kernels\n", value);
 	}
 	
+	if (Description_getCompileJobs (desc) > 0 && Description_isCompileCacheEnabled (desc) == 0)
+	{
+		Log_output (-1, "Warning: The kernels can only be compiled ahead through the compilation cache, they are compiled in series\n");
+	}
+	
 	/* This means the user wants several input files and has defined a basename
 		This basename is going to be erased, so we have to warn him */
 	if (Description_getKernelFileNamesTabSize (desc) > 1
@@ -485,6 +638,89 @@ int Description_getVectorSizeStep (SDescription *desc)
 	return desc->vectorSizeStep;
 }
 
+int Description_getVectorStepping (SDescription *desc)
+{
+	assert (desc);
+	return desc->vectorStepping;
+}
+
+void Description_setVectorStepping (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->vectorStepping = value;
+}
+
+void Description_parseVectorStepping (SDescription *desc, const char *value)
+{
+	assert (desc != NULL && value != NULL);
+	
+	if (strcmp (value, "linear") == 0)
+	{
+		Description_setVectorStepping (desc, STEPPING_LINEAR);
+	}
+	else if (strcmp (value, "geometric") == 0)
+	{
+		Description_setVectorStepping (desc, STEPPING_GEOMETRIC);
+	}
+	else if (strcmp (value, "adaptive") == 0)
+	{
+		Description_setVectorStepping (desc, STEPPING_ADAPTIVE);
+	}
+	else
+	{
+		Log_output (-1, "Error: Unknown vector stepping \"%s\" (expected \"linear\", \"geometric\" or \"adaptive\").\n", value);
+		exit (EXIT_FAILURE);
+	}
+}
+
+double Description_getVectorRatio (SDescription *desc)
+{
+	assert (desc);
+	return desc->vectorRatio;
+}
+
+void Description_setVectorRatio (SDescription *desc, double value)
+{
+	assert (desc);
+	desc->vectorRatio = value;
+}
+
+int Description_getVectorPoints (SDescription *desc)
+{
+	assert (desc);
+	return desc->vectorPoints;
+}
+
+void Description_setVectorPoints (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->vectorPoints = value;
+}
+
+double Description_getVectorThreshold (SDescription *desc)
+{
+	assert (desc);
+	return desc->vectorThreshold;
+}
+
+void Description_setVectorThreshold (SDescription *desc, double value)
+{
+	assert (desc);
+	desc->vectorThreshold = value;
+}
+
+SStepping *Description_getStepping (SDescription *desc)
+{
+	assert (desc);
+	return desc->stepping;
+}
+
+void Description_setStepping (SDescription *desc, SStepping *value)
+{
+	assert (desc);
+	desc->stepping = value;
+}
+
 void Description_setExperimentNumber (SDescription *desc, int value)
 {
 	assert (desc);
@@ -594,6 +830,123 @@ void Description_setDummyArray (SDescription *desc, double* aligned, double* non
 	desc->dummyArrayNonAligned = non_aligned;
 }
 
+int Description_getFlushStrategy (SDescription *desc)
+{
+	assert (desc);
+	return desc->flushStrategy;
+}
+
+void Description_setFlushStrategy (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->flushStrategy = value;
+}
+
+void Description_parseFlushStrategy (SDescription *desc, const char *value)
+{
+	assert (desc != NULL && value != NULL);
+	
+	if (strcmp (value, "read") == 0)
+	{
+		Description_setFlushStrategy (desc, FLUSH_READ);
+	}
+	else if (strcmp (value, "clflush") == 0)
+	{
+		Description_setFlushStrategy (desc, FLUSH_CLFLUSH);
+	}
+	else if (strcmp (value, "evict") == 0)
+	{
+		Description_setFlushStrategy (desc, FLUSH_EVICT);
+	}
+	else if (strcmp (value, "none") == 0)
+	{
+		Description_setFlushStrategy (desc, FLUSH_NONE);
+	}
+	else if (strcmp (value, "clwb") == 0)
+	{
+		Description_setFlushStrategy (desc, FLUSH_CLWB);
+	}
+	else
+	{
+		Log_output (-1, "Error: Unknown flush strategy \"%s\" (expected \"read\", \"clflush\", \"clwb\", \"evict\" or \"none\").\n", value);
+		exit (EXIT_FAILURE);
+	}
+}
+
+int Description_getFlushLevel (SDescription *desc)
+{
+	assert (desc);
+	return desc->flushLevel;
+}
+
+void Description_setFlushLevel (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->flushLevel = value;
+}
+
+void Description_parseFlushLevel (SDescription *desc, const char *value)
+{
+	assert (desc != NULL && value != NULL);
+	
+	if (strcmp (value, "l1") == 0)
+	{
+		Description_setFlushLevel (desc, FLUSH_LEVEL_L1);
+	}
+	else if (strcmp (value, "l2") == 0)
+	{
+		Description_setFlushLevel (desc, FLUSH_LEVEL_L2);
+	}
+	else if (strcmp (value, "llc") == 0)
+	{
+		Description_setFlushLevel (desc, FLUSH_LEVEL_LLC);
+	}
+	else if (strcmp (value, "mem") == 0)
+	{
+		Description_setFlushLevel (desc, FLUSH_LEVEL_MEMORY);
+	}
+	else
+	{
+		Log_output (-1, "Error: Unknown flush level \"%s\" (expected \"l1\", \"l2\", \"llc\" or \"mem\").\n", value);
+		exit (EXIT_FAILURE);
+	}
+}
+
+void Description_flushVerifyEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->flushVerify = 1;
+}
+
+void Description_flushVerifyDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->flushVerify = 0;
+}
+
+int Description_isFlushVerifyEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->flushVerify;
+}
+
+SFlush *Description_getFlush (SDescription *desc)
+{
+	assert (desc);
+	return desc->flush;
+}
+
+void Description_setFlush (SDescription *desc, SFlush *value)
+{
+	assert (desc);
+	
+	if (desc->flush != value)
+	{
+		Flush_destroy (desc->flush);
+	}
+	desc->flush = value;
+}
+
 void Description_setVectorSpacing (SDescription *desc, int value)
 {
 	assert (desc);
@@ -612,6 +965,24 @@ int Description_getVectorSpacing (SDescription *desc)
 	return res;
 }
 
+void Description_arenaEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->arena = 1;
+}
+
+void Description_arenaDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->arena = 0;
+}
+
+int Description_isArenaEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->arena;
+}
+
 int Description_getNbProcess (SDescription *desc)
 {
 	assert(desc);
@@ -636,9 +1007,10 @@ void Description_setNbProcess (SDescription *desc, int val)
         assert (desc->pinning != NULL);
         memset (desc->pinning, 0, val * sizeof (*desc->pinning));
 
+        /* The processors allowed by the cpuset cgroup, in order */
         for (i = 0; i < val; i++)
         {
-            desc->pinning[i] = i;
+            desc->pinning[i] = Topology_getAvailableCpu (i);
         }
     }
 }
@@ -681,119 +1053,313 @@ void Description_setMetaRepetition (SDescription *desc, int value)
 	desc->metaRepetition = value;
 }
 
-int Description_getPageSize (SDescription *desc)
+int Description_getMinMetaRepetition (SDescription *desc)
 {
 	assert (desc);
-	int res = desc->pageSize;
+	int res = desc->minMetaRepetition;
 	return res;
 }
 
-void Description_setPageSize (SDescription *desc, int value)
+void Description_setMinMetaRepetition (SDescription *desc, int value)
 {
 	assert (desc);
-	desc->pageSize = value;
+	desc->minMetaRepetition = value;
 }
 
-char *Description_getBaseName (SDescription *desc)
+double Description_getAdaptivePrecision (SDescription *desc)
 {
 	assert (desc);
-	return desc->baseName;
+	return desc->adaptivePrecision;
 }
 
-void Description_setBaseName (SDescription *desc, char *value)
+void Description_setAdaptivePrecision (SDescription *desc, double value)
 {
 	assert (desc);
-
-	free (desc->baseName), desc->baseName = NULL;
-	if (value != NULL)
-	{
-		desc->baseName = strDuplicate (value, STRBUF_MAXLEN);
-	}
+	desc->adaptivePrecision = value;
 }
 
-void Description_setOmpPath (SDescription *desc, const char *value)
+int Description_getAdaptiveCriterion (SDescription *desc)
 {
 	assert (desc);
-
-	free (desc->ompPath), desc->ompPath = NULL;
-	if (value != NULL)
-	{
-		desc->ompPath = strDuplicate (value, STRBUF_MAXLEN);
-	}
+	return desc->adaptiveCriterion;
 }
 
-char *Description_getOmpPath (SDescription *desc)
+void Description_setAdaptiveCriterion (SDescription *desc, int value)
 {
 	assert (desc);
-
-	return desc->ompPath;
+	desc->adaptiveCriterion = value;
 }
 
-void Description_setOutputPath (SDescription *desc, const char *value)
+void Description_parseAdaptiveCriterion (SDescription *desc, const char *value)
 {
-	assert (desc);
-
-	free (desc->outputPath), desc->outputPath = NULL;
-	if (value != NULL)
+	assert (desc != NULL && value != NULL);
+	
+	if (strcmp (value, "ci") == 0)
 	{
-		desc->outputPath = strDuplicate (value, STRBUF_MAXLEN);
+		Description_setAdaptiveCriterion (desc, ADAPTIVE_CI);
+	}
+	else if (strcmp (value, "mad") == 0)
+	{
+		Description_setAdaptiveCriterion (desc, ADAPTIVE_MAD);
+	}
+	else
+	{
+		Log_output (-1, "Error: Unknown adaptive criterion \"%s\" (expected \"ci\" or \"mad\").\n", value);
+		exit (EXIT_FAILURE);
 	}
 }
 
-char *Description_getOutputPath (SDescription *desc)
+int Description_isAdaptiveModeEnabled (SDescription *desc)
 {
 	assert (desc);
-	return desc->outputPath;
+	return desc->adaptivePrecision > 0;
 }
 
-int Description_getNbPagesForCollision (SDescription *desc)
+double Description_getAutoRepetitionTarget (SDescription *desc)
 {
 	assert (desc);
-	int res = desc->nbPagesForCollision;
-	return res;
+	return desc->autoRepetitionTarget;
 }
 
-void Description_setNbPagesForCollision (SDescription *desc, int value)
+void Description_setAutoRepetitionTarget (SDescription *desc, double value)
 {
 	assert (desc);
-	desc->nbPagesForCollision = value;
+	desc->autoRepetitionTarget = value;
 }
 
-int* Description_getVector (SDescription* desc, int idx)
+AutoRepetition_unit Description_getAutoRepetitionUnit (SDescription *desc)
 {
 	assert (desc);
-
-	if (idx < 0 || idx >= Description_getNbVectors (desc))
-		return NULL;
-	return &(desc->vectorDescriptor[idx][0]);
+	return desc->autoRepetitionUnit;
 }
 
-int Description_getNbVectors (SDescription *desc)
+void Description_setAutoRepetitionUnit (SDescription *desc, AutoRepetition_unit value)
 {
 	assert (desc);
-	return desc->nbVector;
+	desc->autoRepetitionUnit = value;
 }
 
-void Description_setNbVectors (SDescription *desc, int value)
+void Description_parseAutoRepetition (SDescription *desc, const char *value)
 {
-	int nbVectors = Description_getNbVectors (desc);
-	int i;
-	assert (desc);
+	char *end;
+	double target;
 	
-	if (value < 1)
+	assert (desc != NULL && value != NULL);
+	
+	target = strtod (value, &end);
+	if (end == value || target <= 0)
 	{
-		desc->nbVector = value;
-		return;
+		Log_output (-1, "Error: Invalid auto-repetition target \"%s\".\n", value);
+		exit (EXIT_FAILURE);
 	}
-
-	// Now generate the vectorDescriptor
-	for (i = 0; i < nbVectors; i++)
+	
+	/* Time targets are stored in nanoseconds */
+	if (strcmp (end, "ns") == 0)
 	{
-		free (desc->vectorDescriptor[i]), desc->vectorDescriptor[i] = NULL;
-		free (desc->temp_values.alignments), desc->temp_values.alignments = NULL;
+		Description_setAutoRepetitionUnit (desc, AUTO_REPETITION_NS);
 	}
-	free (desc->vectorDescriptor), desc->vectorDescriptor = NULL;
-	free (desc->temp_values.alignments), desc->temp_values.alignments = NULL;
+	else if (strcmp (end, "us") == 0)
+	{
+		Description_setAutoRepetitionUnit (desc, AUTO_REPETITION_NS);
+		target *= 1e3;
+	}
+	else if (strcmp (end, "ms") == 0)
+	{
+		Description_setAutoRepetitionUnit (desc, AUTO_REPETITION_NS);
+		target *= 1e6;
+	}
+	else if (strcmp (end, "cycles") == 0 || *end == '\0')
+	{
+		Description_setAutoRepetitionUnit (desc, AUTO_REPETITION_CYCLES);
+	}
+	else
+	{
+		Log_output (-1, "Error: Unknown auto-repetition unit \"%s\" (expected ns, us, ms or cycles).\n", end);
+		exit (EXIT_FAILURE);
+	}
+	
+	Description_setAutoRepetitionTarget (desc, target);
+}
+
+int Description_isAutoRepetitionEnabled (SDescription *desc)
+{
+	assert (desc);
+	return desc->autoRepetitionTarget > 0;
+}
+
+int Description_getPageSize (SDescription *desc)
+{
+	assert (desc);
+	int res = desc->pageSize;
+	return res;
+}
+
+void Description_setPageSize (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->pageSize = value;
+}
+
+char *Description_getBaseName (SDescription *desc)
+{
+	assert (desc);
+	return desc->baseName;
+}
+
+void Description_setBaseName (SDescription *desc, char *value)
+{
+	assert (desc);
+
+	free (desc->baseName), desc->baseName = NULL;
+	if (value != NULL)
+	{
+		desc->baseName = strDuplicate (value, STRBUF_MAXLEN);
+	}
+}
+
+void Description_setOmpPath (SDescription *desc, const char *value)
+{
+	assert (desc);
+
+	free (desc->ompPath), desc->ompPath = NULL;
+	if (value != NULL)
+	{
+		desc->ompPath = strDuplicate (value, STRBUF_MAXLEN);
+	}
+}
+
+char *Description_getOmpPath (SDescription *desc)
+{
+	assert (desc);
+
+	return desc->ompPath;
+}
+
+void Description_compileCacheEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->compileCache = 1;
+}
+
+void Description_compileCacheDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->compileCache = 0;
+}
+
+int Description_isCompileCacheEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->compileCache;
+}
+
+int Description_getCompileJobs (SDescription *desc)
+{
+	assert (desc);
+	return desc->compileJobs;
+}
+
+void Description_setCompileJobs (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->compileJobs = value;
+}
+
+int Description_getCompileAhead (SDescription *desc)
+{
+	assert (desc);
+	return desc->compileAhead;
+}
+
+void Description_setCompileAhead (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->compileAhead = value;
+}
+
+void Description_batchEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->batch = 1;
+}
+
+void Description_batchDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->batch = 0;
+}
+
+int Description_isBatchEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->batch;
+}
+
+void Description_setOutputPath (SDescription *desc, const char *value)
+{
+	assert (desc);
+
+	free (desc->outputPath), desc->outputPath = NULL;
+	if (value != NULL)
+	{
+		desc->outputPath = strDuplicate (value, STRBUF_MAXLEN);
+	}
+}
+
+char *Description_getOutputPath (SDescription *desc)
+{
+	assert (desc);
+	return desc->outputPath;
+}
+
+int Description_getNbPagesForCollision (SDescription *desc)
+{
+	assert (desc);
+	int res = desc->nbPagesForCollision;
+	return res;
+}
+
+void Description_setNbPagesForCollision (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->nbPagesForCollision = value;
+}
+
+int* Description_getVector (SDescription* desc, int idx)
+{
+	assert (desc);
+
+	if (idx < 0 || idx >= Description_getNbVectors (desc))
+		return NULL;
+	return &(desc->vectorDescriptor[idx][0]);
+}
+
+int Description_getNbVectors (SDescription *desc)
+{
+	assert (desc);
+	return desc->nbVector;
+}
+
+void Description_setNbVectors (SDescription *desc, int value)
+{
+	int nbVectors = Description_getNbVectors (desc);
+	int i;
+	assert (desc);
+	
+	if (value < 1)
+	{
+		desc->nbVector = value;
+		return;
+	}
+
+	// Now generate the vectorDescriptor
+	for (i = 0; i < nbVectors; i++)
+	{
+		free (desc->vectorDescriptor[i]), desc->vectorDescriptor[i] = NULL;
+		free (desc->temp_values.alignments), desc->temp_values.alignments = NULL;
+	}
+	free (desc->vectorDescriptor), desc->vectorDescriptor = NULL;
+	free (desc->temp_values.alignments), desc->temp_values.alignments = NULL;
 	free (desc->vectorSizes), desc->vectorSizes = NULL;
 	
 	/* Vector descriptor array */
@@ -899,109 +1465,387 @@ void Description_setDynamicFunctionName (SDescription *desc, char *name)
 	}
 }
 
-void Description_setDynamicLibraryName (SDescription *desc, char *name, int shouldDelete)
+void Description_setDynamicLibraryName (SDescription *desc, char *name, int shouldDelete)
+{
+	assert (desc);
+
+	free (desc->dynlibName), desc->dynlibName = NULL;
+	if (name != NULL)
+	{
+		desc->dynlibName = strDuplicate (name, STRBUF_MAXLEN);
+		desc->dynlibDelete = shouldDelete;
+	}
+}
+
+char *Description_getDynamicLibraryName (SDescription *desc)
+{
+	assert (desc);
+	char *tmp = desc->dynlibName;
+	char *kernelName = Description_getKernelFileName (desc);
+	const Source_type sc = Description_getSourceType (desc);
+
+	//First check if the library name has been set
+	if (tmp != NULL)
+	{
+		return tmp;
+	}
+
+	//Check if we don't have a kernel defined
+	if (kernelName == NULL)
+	{
+		return NULL;
+	}
+
+	//If not a so, we have work to do
+	if (sc == LIBRARY_FILE)
+	{
+		//Actually have nothing to do
+		Description_setDynamicLibraryName (desc, kernelName, 0);
+		tmp = desc->dynlibName;
+	}
+	else
+	{
+		// If kernelName type is unknown or exec type
+		return NULL;
+	}
+
+	assert (tmp != NULL);
+	return tmp;
+}
+
+char *Description_getDynamicFunctionName (SDescription *desc)
+{
+	assert (desc);
+	return desc->dynlibFunc;
+}
+
+void Description_setCPUDest (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->CPUDest = value;
+}
+
+int Description_getCPUDest (SDescription *desc)
+{
+	assert (desc);
+	int res = desc->CPUDest;
+	return res;
+}
+
+void Description_setTubeSF (SDescription *desc, int* value)
+{
+	assert(desc);
+	desc->tubeSF = value;
+}
+
+int *Description_getTubeSF (SDescription *desc)
+{
+	assert (desc);
+	int *res = desc->tubeSF;
+	return res;
+}
+
+void Description_setTubeFS (SDescription *desc, int* value)
+{
+	assert(desc);
+	desc->tubeFS = value;
+}
+
+int *Description_getTubeFS (SDescription *desc)
+{
+	assert (desc);
+	int *res = desc->tubeFS;
+	return res;
+}
+
+int Description_getBarrierMode (SDescription *desc)
+{
+	assert (desc);
+	return desc->barrierMode;
+}
+
+void Description_setBarrierMode (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->barrierMode = value;
+}
+
+void Description_parseBarrierMode (SDescription *desc, const char *value)
+{
+	assert (desc != NULL && value != NULL);
+	
+	if (strcmp (value, "futex") == 0)
+	{
+		Description_setBarrierMode (desc, BARRIER_FUTEX);
+	}
+	else if (strcmp (value, "spin") == 0)
+	{
+		Description_setBarrierMode (desc, BARRIER_SPIN);
+	}
+	else if (strcmp (value, "pipe") == 0)
+	{
+		Description_setBarrierMode (desc, BARRIER_PIPE);
+	}
+	else
+	{
+		Log_output (-1, "Error: Unknown barrier \"%s\" (expected \"futex\", \"spin\" or \"pipe\").\n", value);
+		exit (EXIT_FAILURE);
+	}
+}
+
+SBarrier *Description_getBarrier (SDescription *desc)
+{
+	assert (desc);
+	return desc->barrier;
+}
+
+void Description_setBarrier (SDescription *desc, SBarrier *value)
+{
+	assert (desc);
+	desc->barrier = value;
+}
+
+void Description_setKernelFunction (SDescription *desc, void* value)
+{
+	assert (desc);
+	desc->kernelFunction = value;
+}
+
+void *Description_getKernelFunction (SDescription *desc)
+{
+	assert (desc);
+	return desc->kernelFunction;
+}
+
+void Description_setDriverFunction (SDescription *desc, void *value)
+{
+	assert (desc);
+	desc->driverFunction = value;
+}
+
+void *Description_getDriverFunction (SDescription *desc)
+{
+	assert (desc);
+	return desc->driverFunction;
+}
+
+void Description_fusedDriverEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->fusedDriver = 1;
+}
+
+void Description_fusedDriverDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->fusedDriver = 0;
+}
+
+int Description_isFusedDriverEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->fusedDriver;
+}
+
+void Description_auditEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->auditMode = 1;
+}
+
+void Description_auditDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->auditMode = 0;
+}
+
+int Description_isAuditEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->auditMode;
+}
+
+SAudit *Description_getAudit (SDescription *desc)
+{
+	assert (desc);
+	return desc->audit;
+}
+
+void Description_setAudit (SDescription *desc, SAudit *value)
+{
+	assert (desc);
+	desc->audit = value;
+}
+
+void Description_binaryOutputEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->binaryOutput = 1;
+}
+
+void Description_binaryOutputDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->binaryOutput = 0;
+}
+
+int Description_isBinaryOutputEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->binaryOutput;
+}
+
+void Description_sweepEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->sweep = 1;
+}
+
+void Description_sweepDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->sweep = 0;
+}
+
+int Description_isSweepEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->sweep;
+}
+
+int Description_getSweepIsolation (SDescription *desc)
+{
+	assert (desc);
+	return desc->sweepIsolation;
+}
+
+void Description_setSweepIsolation (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->sweepIsolation = value;
+}
+
+void Description_parseSweepIsolation (SDescription *desc, const char *value)
+{
+	assert (desc != NULL && value != NULL);
+	
+	if (strcmp (value, "cpu") == 0)
+	{
+		Description_setSweepIsolation (desc, SWEEP_ISOLATION_CPU);
+	}
+	else if (strcmp (value, "core") == 0)
+	{
+		Description_setSweepIsolation (desc, SWEEP_ISOLATION_CORE);
+	}
+	else if (strcmp (value, "l2") == 0)
+	{
+		Description_setSweepIsolation (desc, SWEEP_ISOLATION_L2);
+	}
+	else
+	{
+		Log_output (-1, "Error: Unknown sweep isolation \"%s\" (expected \"cpu\", \"core\" or \"l2\").\n", value);
+		exit (EXIT_FAILURE);
+	}
+	Description_sweepEnable (desc);
+}
+
+SSweep *Description_getSweep (SDescription *desc)
+{
+	assert (desc);
+	return desc->sweepQueue;
+}
+
+void Description_setSweep (SDescription *desc, SSweep *value)
 {
 	assert (desc);
+	desc->sweepQueue = value;
+}
 
-	free (desc->dynlibName), desc->dynlibName = NULL;
-	if (name != NULL)
-	{
-		desc->dynlibName = strDuplicate (name, STRBUF_MAXLEN);
-		desc->dynlibDelete = shouldDelete;
-	}
+int Description_getAlignmentSampling (SDescription *desc)
+{
+	assert (desc);
+	return desc->alignmentSampling;
 }
 
-char *Description_getDynamicLibraryName (SDescription *desc)
+void Description_setAlignmentSampling (SDescription *desc, int value)
 {
 	assert (desc);
-	char *tmp = desc->dynlibName;
-	char *kernelName = Description_getKernelFileName (desc);
-	const Source_type sc = Description_getSourceType (desc);
+	desc->alignmentSampling = value;
+}
 
-	//First check if the library name has been set
-	if (tmp != NULL)
+void Description_parseAlignmentSampling (SDescription *desc, const char *value)
+{
+	assert (desc != NULL && value != NULL);
+	
+	if (strcmp (value, "full") == 0)
 	{
-		return tmp;
+		Description_setAlignmentSampling (desc, SAMPLER_FULL);
 	}
-
-	//Check if we don't have a kernel defined
-	if (kernelName == NULL)
+	else if (strcmp (value, "random") == 0)
 	{
-		return NULL;
+		Description_setAlignmentSampling (desc, SAMPLER_RANDOM);
 	}
-
-	//If not a so, we have work to do
-	if (sc == LIBRARY_FILE)
+	else if (strcmp (value, "lhs") == 0)
 	{
-		//Actually have nothing to do
-		Description_setDynamicLibraryName (desc, kernelName, 0);
-		tmp = desc->dynlibName;
+		Description_setAlignmentSampling (desc, SAMPLER_LHS);
+	}
+	else if (strcmp (value, "adaptive") == 0)
+	{
+		Description_setAlignmentSampling (desc, SAMPLER_ADAPTIVE);
 	}
 	else
 	{
-		// If kernelName type is unknown or exec type
-		return NULL;
+		Log_output (-1, "Error: Unknown alignment sampling \"%s\" (expected \"full\", \"random\", \"lhs\" or \"adaptive\").\n", value);
+		exit (EXIT_FAILURE);
 	}
-
-	assert (tmp != NULL);
-	return tmp;
 }
 
-char *Description_getDynamicFunctionName (SDescription *desc)
+int Description_getAlignmentSamples (SDescription *desc)
 {
 	assert (desc);
-	return desc->dynlibFunc;
+	return desc->alignmentSamples;
 }
 
-void Description_setCPUDest (SDescription *desc, int value)
+void Description_setAlignmentSamples (SDescription *desc, int value)
 {
 	assert (desc);
-	desc->CPUDest = value;
+	desc->alignmentSamples = value;
 }
 
-int Description_getCPUDest (SDescription *desc)
+unsigned long Description_getAlignmentSeed (SDescription *desc)
 {
 	assert (desc);
-	int res = desc->CPUDest;
-	return res;
-}
-
-void Description_setTubeSF (SDescription *desc, int* value)
-{
-	assert(desc);
-	desc->tubeSF = value;
+	return desc->alignmentSeed;
 }
 
-int *Description_getTubeSF (SDescription *desc)
+void Description_setAlignmentSeed (SDescription *desc, unsigned long value)
 {
 	assert (desc);
-	int *res = desc->tubeSF;
-	return res;
+	desc->alignmentSeed = value;
 }
 
-void Description_setTubeFS (SDescription *desc, int* value)
+double Description_getAlignmentThreshold (SDescription *desc)
 {
-	assert(desc);
-	desc->tubeFS = value;
+	assert (desc);
+	return desc->alignmentThreshold;
 }
 
-int *Description_getTubeFS (SDescription *desc)
+void Description_setAlignmentThreshold (SDescription *desc, double value)
 {
 	assert (desc);
-	int *res = desc->tubeFS;
-	return res;
+	desc->alignmentThreshold = value;
 }
 
-void Description_setKernelFunction (SDescription *desc, void* value)
+SSampler *Description_getSampler (SDescription *desc)
 {
 	assert (desc);
-	desc->kernelFunction = value;
+	return desc->sampler;
 }
 
-void *Description_getKernelFunction (SDescription *desc)
+void Description_setSampler (SDescription *desc, SSampler *value)
 {
 	assert (desc);
-	return desc->kernelFunction;
+	desc->sampler = value;
 }
 
 void Description_setLogVerbosity (SDescription *desc, int value)
@@ -1126,6 +1970,74 @@ evaluationFlag Description_getEvaluationLibraryOverheadFlag (SDescription *desc,
 	return *desc->evaluationOverheadFlags[idX];
 }
 
+void Description_setEvaluationCounterFunctions (SDescription *desc, evaluationCounterNbFct nbFct, evaluationCounterNameFct nameFct, evaluationCounterValueFct valueFct, unsigned idX)
+{
+	assert (desc);
+	assert (idX < desc->nbEvalLibs);
+	
+	desc->evaluationCounterNb[idX] = nbFct;
+	desc->evaluationCounterName[idX] = nameFct;
+	desc->evaluationCounterValue[idX] = valueFct;
+}
+
+unsigned Description_getEvaluationNbCounters (SDescription *desc, unsigned idX)
+{
+	assert (desc);
+	assert (idX < desc->nbEvalLibs);
+	
+	/* The three functions are needed to handle the counters */
+	if (desc->evaluationCounterNb[idX] == NULL || desc->evaluationCounterName[idX] == NULL || desc->evaluationCounterValue[idX] == NULL)
+	{
+		return 0;
+	}
+	
+	/* Only the processes which initialized the library can ask it */
+	if (!Description_isProcessEvalHandler (desc))
+	{
+		return 0;
+	}
+	
+	return desc->evaluationCounterNb[idX] (desc->evalData[idX]);
+}
+
+const char *Description_getEvaluationCounterName (SDescription *desc, unsigned idX, unsigned counter)
+{
+	assert (desc);
+	assert (idX < desc->nbEvalLibs);
+	assert (desc->evaluationCounterName[idX] != NULL);
+	
+	return desc->evaluationCounterName[idX] (desc->evalData[idX], counter);
+}
+
+evaluationCounterValueFct Description_getEvaluationCounterValueFunction (SDescription *desc, unsigned idX)
+{
+	assert (desc);
+	assert (idX < desc->nbEvalLibs);
+	
+	return desc->evaluationCounterValue[idX];
+}
+
+void Description_setEvaluationReadCostFunction (SDescription *desc, evaluationReadCostFct fct, unsigned idX)
+{
+	assert (desc);
+	assert (idX < desc->nbEvalLibs);
+	
+	desc->evaluationReadCost[idX] = fct;
+}
+
+double Description_getEvaluationReadCost (SDescription *desc, unsigned idX, unsigned counter)
+{
+	assert (desc);
+	assert (idX < desc->nbEvalLibs);
+	
+	if (desc->evaluationReadCost[idX] == NULL || !Description_isProcessEvalHandler (desc))
+	{
+		return 0.;
+	}
+	
+	return desc->evaluationReadCost[idX] (desc->evalData[idX], counter);
+}
+
 void Description_setSourceType (SDescription *desc, Source_type sc)
 {
 	assert (desc);
@@ -1319,6 +2231,13 @@ int Description_AssertValues (SDescription *desc)
 			return -1;
 		}
 		
+		if (desc->vectorStepping != STEPPING_LINEAR && (desc->vectorRatio <= 1 || desc->vectorThreshold < 0 || (desc->vectorPoints <= 0 && desc->vectorPoints != DEFAULT_VECTOR_POINTS)))
+		{
+			Log_output (-1, "Error: The --vector-ratio argument must be greater than 1, the --vector-points argument greater than 0 and the --vector-threshold argument cannot be negative.\n");
+			Log_output (-1, use_microlaunch_h);
+			return -1;
+		}
+		
 		if (Description_isIterationCountEnabled(desc) && desc->iterationCount <= 0)
 		{
 			Log_output (-1, "Error: IterationCount argument value must be greater than 0 (given value : %d).\n", desc->iterationCount);
@@ -1463,6 +2382,63 @@ int Description_AssertValues (SDescription *desc)
 		return -1;
 	}
 	
+	/* The experiments are counted in an int, the barrier rounds (two per experiment and meta-repetition) in an unsigned */
+	if (desc->kernelFileName != NULL)
+	{
+		uint64_t nbSamples = Sampler_getNbSamples (desc);
+		uint64_t nbSizes = Stepping_getNbSizes (desc);
+		
+		if (nbSamples > INT_MAX / nbSizes || nbSamples * nbSizes > UINT_MAX / (2 * (uint64_t) desc->metaRepetition))
+		{
+			Log_output (-1, "Error: %llu alignment configurations for each of the %llu vector sizes are too many experiments, reduce them with --alignment-sampling and --alignment-samples.\n",
+						(unsigned long long) nbSamples, (unsigned long long) nbSizes);
+			Log_output (-1, use_microlaunch_h);
+			return -1;
+		}
+	}
+	
+	if (desc->adaptivePrecision < 0)
+	{
+		Log_output (-1, "Error: The --adaptive-precision argument cannot have a negative value.\n");
+		Log_output (-1, use_microlaunch_h);
+		return -1;
+	}
+	
+	if (desc->adaptivePrecision > 0 && (desc->minMetaRepetition < 2 || desc->minMetaRepetition > desc->metaRepetition))
+	{
+		Log_output (-1, "Error: The --min-metarepetition argument must be between 2 and the --metarepetition value.\n");
+		Log_output (-1, use_microlaunch_h);
+		return -1;
+	}
+	
+	if (desc->compileJobs < 0 || desc->compileAhead < 1)
+	{
+		Log_output (-1, "Error: The --compile-jobs argument cannot be negative and the --compile-ahead argument must be greater than 0.\n");
+		Log_output (-1, use_microlaunch_h);
+		return -1;
+	}
+	
+	if (desc->sweep && (desc->execFileName != NULL || desc->batch || desc->resuming || desc->cpupinDefined))
+	{
+		Log_output (-1, "Error: The --sweep argument cannot be used with --execname, --batch, --resume or --cpupin.\n");
+		Log_output (-1, use_microlaunch_h);
+		return -1;
+	}
+	
+	if (desc->alignmentSampling != SAMPLER_FULL && ((desc->alignmentSamples <= 0 && desc->alignmentSamples != DEFAULT_ALIGNMENT_SAMPLES) || desc->alignmentThreshold < 0))
+	{
+		Log_output (-1, "Error: The --alignment-samples argument must be greater than 0 and the --alignment-threshold argument cannot be negative.\n");
+		Log_output (-1, use_microlaunch_h);
+		return -1;
+	}
+	
+	if (desc->sweep && (desc->alignmentSampling == SAMPLER_ADAPTIVE || desc->vectorStepping == STEPPING_ADAPTIVE))
+	{
+		Log_output (-1, "Error: The adaptive alignment sampling and vector stepping cannot be used with --sweep (the sweep points are drawn before any measure).\n");
+		Log_output (-1, use_microlaunch_h);
+		return -1;
+	}
+	
 	if (desc->nbprocess <= 0)
 	{
 		Log_output (-1, "Error: Nbprocess argument value must be greater than 0 (given value : %d).\n", desc->nbprocess);
@@ -1470,6 +2446,22 @@ int Description_AssertValues (SDescription *desc)
 		return -1;
 	}
 	
+	/* Each process would bisect from its own measures, so the processes would not measure the same size at a barrier */
+	if (desc->nbprocess > 1 && desc->vectorStepping == STEPPING_ADAPTIVE)
+	{
+		Log_output (-1, "Error: The adaptive vector stepping cannot be used with more than one benchmark process (--nbprocess).\n");
+		Log_output (-1, use_microlaunch_h);
+		return -1;
+	}
+	
+	/* Likewise, each process would refine around its own deviations and draw its own configurations */
+	if (desc->nbprocess > 1 && desc->alignmentSampling == SAMPLER_ADAPTIVE)
+	{
+		Log_output (-1, "Error: The adaptive alignment sampling cannot be used with more than one benchmark process (--nbprocess).\n");
+		Log_output (-1, use_microlaunch_h);
+		return -1;
+	}
+	
 	if ( desc->nbprocess > desc->nbProcessorsAvailable)
 	{
 		Log_output (-1, "Error: Cannot execute %d processes on this machine (%d processors available detected)\n", desc->nbprocess, desc->nbProcessorsAvailable);
@@ -1775,6 +2767,144 @@ int Description_isThreadPinningEnabled (SDescription *desc)
 	return desc->threadPin;
 }
 
+int Description_getPinPolicy (SDescription *desc)
+{
+	assert (desc);
+	return desc->pinPolicy;
+}
+
+void Description_setPinPolicy (SDescription *desc, int value)
+{
+	assert (desc);
+	desc->pinPolicy = value;
+}
+
+void Description_parsePinPolicy (SDescription *desc, const char *value)
+{
+	int cpus[TOPOLOGY_MAX_CPUS];
+	
+	assert (desc != NULL && value != NULL);
+	
+	if (strcmp (value, "linear") == 0)
+	{
+		Description_setPinPolicy (desc, TOPOLOGY_PIN_LINEAR);
+	}
+	else if (strcmp (value, "compact") == 0)
+	{
+		Description_setPinPolicy (desc, TOPOLOGY_PIN_COMPACT);
+	}
+	else if (strcmp (value, "scatter") == 0)
+	{
+		Description_setPinPolicy (desc, TOPOLOGY_PIN_SCATTER);
+	}
+	else if (strcmp (value, "physical") == 0)
+	{
+		Description_setPinPolicy (desc, TOPOLOGY_PIN_PHYSICAL);
+	}
+	else if (strcmp (value, "socket") == 0)
+	{
+		Description_setPinPolicy (desc, TOPOLOGY_PIN_SOCKET);
+	}
+	else if (Topology_parseCpuOrder (value, cpus, TOPOLOGY_MAX_CPUS) > 0)
+	{
+		Description_setPinPolicy (desc, TOPOLOGY_PIN_LIST);
+		Description_setPinList (desc, value);
+	}
+	else
+	{
+		Log_output (-1, "Error: Unknown pinning policy \"%s\" (expected \"linear\", \"compact\", \"scatter\", \"physical\", \"socket\" or a processor list such as \"0,2,4-7\").\n", value);
+		exit (EXIT_FAILURE);
+	}
+}
+
+char *Description_getPinList (SDescription *desc)
+{
+	assert (desc);
+	return desc->pinList;
+}
+
+void Description_setPinList (SDescription *desc, const char *value)
+{
+	assert (desc);
+	free (desc->pinList), desc->pinList = NULL;
+	
+	if (value != NULL)
+	{
+		desc->pinList = strDuplicate (value, STRBUF_MAXLEN);
+	}
+}
+
+void Description_forkServerEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->forkServer = 1;
+}
+
+void Description_forkServerDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->forkServer = 0;
+}
+
+int Description_isForkServerEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->forkServer;
+}
+
+void Description_roiEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->roi = 1;
+}
+
+void Description_roiDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->roi = 0;
+}
+
+int Description_isRoiEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->roi;
+}
+
+void Description_setChildEvents (SDescription *desc, char *value)
+{
+	assert (desc);
+
+	free (desc->childEvents), desc->childEvents = NULL;
+	if (value != NULL)
+	{
+		desc->childEvents = strDuplicate (value, STRBUF_MAXLEN);
+	}
+}
+
+char *Description_getChildEvents (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->childEvents;
+}
+
+void Description_rusageEnable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->rusage = 1;
+}
+
+void Description_rusageDisable (SDescription *desc)
+{
+	assert (desc != NULL);
+	desc->rusage = 0;
+}
+
+int Description_isRusageEnabled (SDescription *desc)
+{
+	assert (desc != NULL);
+	return desc->rusage;
+}
+
 void Description_allProcessOutputEnable (SDescription *desc)
 {
 	assert (desc != NULL);
@@ -2022,6 +3152,26 @@ void Description_setNbEvaluationLibrairies (SDescription *desc, unsigned value)
 	assert (desc->evaluationOverheadFlags != NULL);
 	memset (desc->evaluationOverheadFlags, 0, value * sizeof (*desc->evaluationOverheadFlags));
 	
+	free (desc->evaluationCounterNb), desc->evaluationCounterNb = NULL;
+	desc->evaluationCounterNb = malloc ( value * sizeof (*desc->evaluationCounterNb));
+	assert (desc->evaluationCounterNb != NULL);
+	memset (desc->evaluationCounterNb, 0, value * sizeof (*desc->evaluationCounterNb));
+	
+	free (desc->evaluationCounterName), desc->evaluationCounterName = NULL;
+	desc->evaluationCounterName = malloc ( value * sizeof (*desc->evaluationCounterName));
+	assert (desc->evaluationCounterName != NULL);
+	memset (desc->evaluationCounterName, 0, value * sizeof (*desc->evaluationCounterName));
+	
+	free (desc->evaluationCounterValue), desc->evaluationCounterValue = NULL;
+	desc->evaluationCounterValue = malloc ( value * sizeof (*desc->evaluationCounterValue));
+	assert (desc->evaluationCounterValue != NULL);
+	memset (desc->evaluationCounterValue, 0, value * sizeof (*desc->evaluationCounterValue));
+	
+	free (desc->evaluationReadCost), desc->evaluationReadCost = NULL;
+	desc->evaluationReadCost = malloc ( value * sizeof (*desc->evaluationReadCost));
+	assert (desc->evaluationReadCost != NULL);
+	memset (desc->evaluationReadCost, 0, value * sizeof (*desc->evaluationReadCost));
+	
 	free (desc->evalData), desc->evalData = NULL;
 	desc->evalData = malloc ( value * sizeof (*desc->evalData));
 	assert (desc->evalData != NULL);
@@ -0,0 +1,113 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "Description.h"
+#include "Driver.h"
+#include "Log.h"
+
+/* The kernel wrappers of BenchDescriptor.c handle up to this number of vectors */
+#define DRIVER_MAX_VECTORS 8
+
+int Driver_generate (SDescription *desc, const char *fileName, char *tag, size_t size)
+{
+	const char *func = Description_getDynamicFunctionName (desc);
+	int isMDL = Description_isNbSizeDefined (desc);
+	int nbVectors = Description_getNbVectors (desc);
+	unsigned w_size;
+	FILE *f;
+	int i;
+	
+	assert (fileName != NULL && tag != NULL);
+	
+	if (func == NULL || nbVectors > DRIVER_MAX_VECTORS)
+	{
+		Log_output (-1, "Warning: No fused driver for %d vectors, the kernel is called through its wrapper\n", nbVectors);
+		return -1;
+	}
+	
+	f = fopen (fileName, "w");
+	if (f == NULL)
+	{
+		perror ("Error: Cannot create the driver source ");
+		return -1;
+	}
+	
+	fprintf (f, "/* Generated by microlaunch: repetition loop of %s for %d vector(s)%s */\n", func, nbVectors, isMDL ? " of mixed sizes" : "");
+	fprintf (f, "#include \"Rdtsc.h\"\n\n");
+	
+	/* Same calling conventions as the kernel wrappers of BenchDescriptor.c */
+	if (isMDL)
+	{
+		fprintf (f, "extern unsigned long %s (unsigned long, unsigned long *, unsigned, void **);\n\n", func);
+	}
+	else
+	{
+		fprintf (f, "extern unsigned long %s (unsigned long, ", func);
+		for (i = 0; i < nbVectors || i == 0; i++)
+		{
+			fprintf (f, "void *, ");
+		}
+		fprintf (f, "unsigned);\n\n");
+	}
+	
+	fprintf (f, "unsigned long %s (unsigned long repetitions, unsigned long *vectorSizes, unsigned elemSize, void **vectors, unsigned long long *cycles)\n{\n", DRIVER_FUNCTION_NAME);
+	fprintf (f, "\tunsigned long long start, stop;\n\tunsigned long res = 0, r;\n");
+	
+	if (!isMDL)
+	{
+		fprintf (f, "\tunsigned long size = %s;\n", (nbVectors > 0) ? "vectorSizes[0]" : "0");
+		for (i = 0; i < nbVectors; i++)
+		{
+			fprintf (f, "\tvoid *v%d = vectors[%d];\n", i, i);
+		}
+		if (nbVectors == 0)
+		{
+			fprintf (f, "\tvoid *v0 = 0;\n\n\t(void) vectorSizes;\n\t(void) vectors;\n");
+		}
+	}
+	
+	/* The kernel is in another translation unit and the library is linked with -Bsymbolic: a direct call, no inlining */
+	fprintf (f, "\n\trdtscll_start (start);\n\tfor (r = 0; r < repetitions; r++)\n\t{\n");
+	if (isMDL)
+	{
+		fprintf (f, "\t\tres = %s (%d, vectorSizes, elemSize, vectors);\n", func, nbVectors);
+	}
+	else
+	{
+		fprintf (f, "\t\tres = %s (size, ", func);
+		for (i = 0; i < nbVectors || i == 0; i++)
+		{
+			fprintf (f, "v%d, ", i);
+		}
+		fprintf (f, "elemSize);\n");
+	}
+	fprintf (f, "\t}\n\trdtscpll_stop (stop);\n\n\t*cycles = stop - start;\n\treturn res;\n}\n");
+	
+	if (fclose (f) != 0)
+	{
+		return -1;
+	}
+	
+	w_size = snprintf (tag, size, "driver-%d:%s:%d:%d", DRIVER_VERSION, func, nbVectors, isMDL);
+	assert (w_size < size);
+	
+	return 0;
+}
@@ -0,0 +1,653 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <cpuid.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Description.h"
+#include "Dflush.h"
+#include "Flush.h"
+#include "Log.h"
+#include "Rdtsc.h"
+#include "Topology.h"
+
+/* Fraction of the distance between a L1 hit and a memory access under which a probed line
+	is counted as a hit, for each level: L2 hits are close to L1 ones, LLC hits are not */
+static const unsigned long flushThresholdDivisor[] = {32, 8, 2, 2};
+
+/* Keeps the eviction loads alive */
+static volatile unsigned long flushSink;
+
+/**
+ * @brief A slice of the eviction buffer streamed by one thread
+ */
+typedef struct sFlushSlice
+{
+	const unsigned long *buffer;	/**< @brief The eviction buffer */
+	size_t begin;					/**< @brief First word of the slice */
+	size_t end;						/**< @brief Word after the slice */
+	unsigned long sum;				/**< @brief Sum of the loaded words */
+	struct sFlushHelpers *helpers;	/**< @brief The helpers the slice belongs to (NULL for a single thread eviction) */
+} SFlushSlice;
+
+/**
+ * @brief struct sFlushHelpers holds the threads streaming over an LLC sized eviction buffer with the measuring one
+ */
+typedef struct sFlushHelpers
+{
+	SFlushSlice slices[FLUSH_MAX_HELPERS + 1];	/**< @brief The slices, the first one is streamed by the measuring thread */
+	pthread_t threads[FLUSH_MAX_HELPERS];		/**< @brief The helper threads */
+	int nbHelpers;								/**< @brief Number of helper threads */
+	volatile uint32_t generation;				/**< @brief Incremented to start a flush (futex) */
+	volatile uint32_t remaining;				/**< @brief Number of helpers still streaming (futex) */
+	volatile int quit;							/**< @brief Whether or not the helpers have to exit */
+} SFlushHelpers;
+
+/**
+ * @brief Gives the capacity of a cache level
+ */
+static size_t Flush_getLevelSize (EFlushLevel level)
+{
+	size_t size;
+	
+	switch (level)
+	{
+		case FLUSH_LEVEL_L1:
+			size = Topology_getCacheSize (1);
+			return (size != 0) ? size : FLUSH_DEFAULT_L1_SIZE;
+		case FLUSH_LEVEL_L2:
+			size = Topology_getCacheSize (2);
+			return (size != 0) ? size : FLUSH_DEFAULT_L2_SIZE;
+		case FLUSH_LEVEL_LLC:
+		case FLUSH_LEVEL_MEMORY:
+		default:
+			size = Topology_getCacheSize (0);
+			return (size != 0) ? size : FLUSH_DEFAULT_LLC_SIZE;
+	}
+}
+
+static inline void Flush_line (const volatile char *line, EFlushInstruction instruction)
+{
+	switch (instruction)
+	{
+		case FLUSH_INSN_CLWB:
+			asm volatile ("clwb %0" :: "m" (*line) : "memory");
+			break;
+		case FLUSH_INSN_CLFLUSHOPT:
+			asm volatile ("clflushopt %0" :: "m" (*line) : "memory");
+			break;
+		case FLUSH_INSN_CLFLUSH:
+		default:
+			asm volatile ("clflush %0" :: "m" (*line) : "memory");
+			break;
+	}
+}
+
+static void Flush_region (const char *base, size_t size, EFlushInstruction instruction)
+{
+	size_t offset;
+	
+	for (offset = 0; offset < size; offset += FLUSH_LINE_SIZE)
+	{
+		Flush_line (base + offset, instruction);
+	}
+	if (size != 0)
+	{
+		Flush_line (base + size - 1, instruction);
+	}
+	asm volatile ("mfence" ::: "memory");
+}
+
+static void Flush_vectors (SDescription *desc, void **arrays, EFlushInstruction instruction)
+{
+	unsigned i, nbVectors = Description_getNbVectors (desc);
+	size_t elemSize = Description_getVectorElementSize (desc);
+	
+	for (i = 0; i < nbVectors; i++)
+	{
+		Flush_region (arrays[i], desc->vectorSizes[i] * elemSize, instruction);
+	}
+}
+
+/**
+ * @brief Reads one word per line of a slice of the eviction buffer, with independent streams so that
+ * many misses are in flight at once (unlike the dependent sum of readDummyArray)
+ */
+static void Flush_evictSlice (SFlushSlice *slice)
+{
+	const unsigned long *buffer = slice->buffer;
+	size_t step = FLUSH_LINE_SIZE / sizeof (*buffer), i;
+	unsigned long s0 = 0, s1 = 0, s2 = 0, s3 = 0, s4 = 0, s5 = 0, s6 = 0, s7 = 0;
+	
+	for (i = slice->begin; i + 8 * step <= slice->end; i += 8 * step)
+	{
+		s0 += buffer[i];
+		s1 += buffer[i + step];
+		s2 += buffer[i + 2 * step];
+		s3 += buffer[i + 3 * step];
+		s4 += buffer[i + 4 * step];
+		s5 += buffer[i + 5 * step];
+		s6 += buffer[i + 6 * step];
+		s7 += buffer[i + 7 * step];
+	}
+	
+	slice->sum = s0 + s1 + s2 + s3 + s4 + s5 + s6 + s7;
+}
+
+static inline void Flush_futexWait (volatile uint32_t *word, uint32_t value)
+{
+	syscall (SYS_futex, word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+}
+
+static inline void Flush_futexWake (volatile uint32_t *word)
+{
+	syscall (SYS_futex, word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/**
+ * @brief Body of a helper thread: sleeps on the generation word, streams its slice each time it changes
+ */
+static void *Flush_helperLoop (void *arg)
+{
+	SFlushSlice *slice = arg;
+	SFlushHelpers *helpers = slice->helpers;
+	uint32_t seen = 0;
+	
+	while (1)
+	{
+		while (helpers->generation == seen)
+		{
+			Flush_futexWait (&helpers->generation, seen);
+		}
+		seen = helpers->generation;
+		
+		if (helpers->quit)
+		{
+			return NULL;
+		}
+		
+		Flush_evictSlice (slice);
+		
+		if (__sync_sub_and_fetch (&helpers->remaining, 1) == 0)
+		{
+			Flush_futexWake (&helpers->remaining);
+		}
+	}
+}
+
+/**
+ * @brief Stops and joins the helper threads
+ */
+static void Flush_destroyHelpers (SFlushHelpers *helpers, int nbStarted)
+{
+	int i;
+	
+	if (helpers == NULL)
+	{
+		return;
+	}
+	
+	helpers->quit = 1;
+	__sync_add_and_fetch (&helpers->generation, 1);
+	Flush_futexWake (&helpers->generation);
+	
+	for (i = 0; i < nbStarted; i++)
+	{
+		pthread_join (helpers->threads[i], NULL);
+	}
+	
+	free (helpers), helpers = NULL;
+}
+
+/**
+ * @brief Starts the threads streaming over an LLC sized buffer with the measuring thread, pinned on the available
+ * processors sharing the LLC with it. They sleep between the flushes, so that no thread is created before a measure
+ * @return the helpers, NULL if the buffer is streamed by the measuring thread alone
+ */
+static SFlushHelpers *Flush_createHelpers (SFlush *flush)
+{
+	const STopologyCache *llc = Topology_getCache (0);
+	const STopology *topo = Topology_get ();
+	SFlushHelpers *helpers;
+	cpu_set_t shared, set;
+	int cpu = sched_getcpu (), cpus[FLUSH_MAX_HELPERS], nbCpus = 0, i;
+	size_t end = flush->bufferSize / sizeof (unsigned long), lineWords = FLUSH_LINE_SIZE / sizeof (unsigned long);
+	size_t own, chunk;
+	
+	/* An unpinned measuring thread may move: the helpers could not be placed around it */
+	if (sched_getaffinity (0, sizeof (set), &set) != 0 || CPU_COUNT (&set) != 1 || cpu < 0
+		|| llc == NULL || Topology_getCacheSharing (cpu, llc->level, &shared) != 0)
+	{
+		return NULL;
+	}
+	
+	for (i = 0; i < topo->nbCpus && nbCpus < FLUSH_MAX_HELPERS; i++)
+	{
+		if (i != cpu && CPU_ISSET (i, &shared) && CPU_ISSET (i, &topo->available))
+		{
+			cpus[nbCpus++] = i;
+		}
+	}
+	
+	/* The measuring thread keeps a slice larger than its private caches, which only it can empty, the helpers share the rest */
+	own = end / (nbCpus + 1);
+	if (own < FLUSH_EVICT_FACTOR * Flush_getLevelSize (FLUSH_LEVEL_L2) / sizeof (unsigned long))
+	{
+		own = FLUSH_EVICT_FACTOR * Flush_getLevelSize (FLUSH_LEVEL_L2) / sizeof (unsigned long);
+	}
+	own -= own % lineWords;
+	
+	if (nbCpus == 0 || own >= end)
+	{
+		return NULL;
+	}
+	
+	helpers = malloc (sizeof (*helpers));
+	assert (helpers != NULL);
+	memset (helpers, 0, sizeof (*helpers));
+	
+	chunk = (end - own) / nbCpus;
+	chunk -= chunk % lineWords;
+	
+	for (i = 0; i <= nbCpus; i++)
+	{
+		helpers->slices[i].buffer = (const unsigned long *) flush->buffer;
+		helpers->slices[i].helpers = helpers;
+		helpers->slices[i].begin = (i == 0) ? 0 : own + (i - 1) * chunk;
+		helpers->slices[i].end = (i == 0) ? own : ((i == nbCpus) ? end : own + i * chunk);
+	}
+	
+	for (i = 0; i < nbCpus; i++)
+	{
+		pthread_attr_t attr;
+		int res;
+		
+		CPU_ZERO (&set);
+		CPU_SET (cpus[i], &set);
+		pthread_attr_init (&attr);
+		pthread_attr_setaffinity_np (&attr, sizeof (set), &set);
+		res = pthread_create (&helpers->threads[i], &attr, Flush_helperLoop, &helpers->slices[i + 1]);
+		pthread_attr_destroy (&attr);
+		
+		if (res != 0)
+		{
+			Log_output (5, "Info: Cannot start the flush helper thread on processor %d, the eviction is streamed by the measuring thread alone\n", cpus[i]);
+			Flush_destroyHelpers (helpers, i);
+			return NULL;
+		}
+	}
+	helpers->nbHelpers = nbCpus;
+	
+	Log_output (5, "Info: Flush eviction streamed by %d helper thread(s) besides processor %d\n", nbCpus, cpu);
+	return helpers;
+}
+
+/**
+ * @brief Streams over the eviction buffer, with the helper threads if any
+ */
+static void Flush_evict (SFlush *flush)
+{
+	SFlushHelpers *helpers = flush->helpers;
+	SFlushSlice whole;
+	uint32_t remaining;
+	unsigned long sum = 0;
+	int i;
+	
+	if (helpers == NULL)
+	{
+		whole.buffer = (const unsigned long *) flush->buffer;
+		whole.begin = 0;
+		whole.end = flush->bufferSize / sizeof (unsigned long);
+		whole.helpers = NULL;
+		Flush_evictSlice (&whole);
+		flushSink = whole.sum;
+		return;
+	}
+	
+	helpers->remaining = helpers->nbHelpers;
+	__sync_add_and_fetch (&helpers->generation, 1);
+	Flush_futexWake (&helpers->generation);
+	
+	Flush_evictSlice (&helpers->slices[0]);
+	
+	while ((remaining = helpers->remaining) != 0)
+	{
+		Flush_futexWait (&helpers->remaining, remaining);
+	}
+	
+	for (i = 0; i <= helpers->nbHelpers; i++)
+	{
+		sum += helpers->slices[i].sum;
+	}
+	flushSink = sum;
+}
+
+static void Flush_apply (SFlush *flush, SDescription *desc, void **arrays)
+{
+	switch (flush->strategy)
+	{
+		case FLUSH_READ:
+			readDummyArray (flush->dummy, flush->dummySize);
+			break;
+		case FLUSH_CLFLUSH:
+			/* Exec mode: there are no vectors to flush */
+			if (arrays != NULL)
+			{
+				Flush_vectors (desc, arrays, flush->instruction);
+			}
+			else
+			{
+				Flush_evict (flush);
+			}
+			break;
+		case FLUSH_CLWB:
+			/* Exec mode: there are no vectors to write back */
+			if (arrays != NULL)
+			{
+				Flush_vectors (desc, arrays, flush->instruction);
+			}
+			break;
+		case FLUSH_EVICT:
+			Flush_evict (flush);
+			if (flush->level == FLUSH_LEVEL_MEMORY && arrays != NULL)
+			{
+				Flush_vectors (desc, arrays, flush->evictInstruction);
+			}
+			break;
+		case FLUSH_NONE:
+		default:
+			break;
+	}
+}
+
+static inline unsigned long Flush_loadLatency (const volatile char *line)
+{
+	unsigned long start, stop;
+	
+	rdtscll_start (start);
+	(void) *line;
+	rdtscpll_stop (stop);
+	
+	return stop - start;
+}
+
+static unsigned Flush_gcd (unsigned a, unsigned b)
+{
+	while (b != 0)
+	{
+		unsigned t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+/**
+ * @brief Times the load of evenly spread lines of a region, in a scattered order so that the prefetchers do not hide the misses
+ */
+static void Flush_probe (SFlush *flush, const char *base, size_t size)
+{
+	unsigned nbLines = size / FLUSH_LINE_SIZE;
+	unsigned count = (nbLines < FLUSH_PROBED_LINES) ? nbLines : FLUSH_PROBED_LINES;
+	unsigned step = 61, k, idx;
+	
+	if (count == 0)
+	{
+		return;
+	}
+	
+	while (Flush_gcd (step, count) != 1)
+	{
+		step++;
+	}
+	
+	for (k = 0, idx = 0; k < count; k++, idx = (idx + step) % count)
+	{
+		unsigned long line = (unsigned long) idx * nbLines / count;
+		
+		if (Flush_loadLatency (base + line * FLUSH_LINE_SIZE) < flush->threshold)
+		{
+			flush->hits++;
+		}
+		flush->probed++;
+	}
+}
+
+static int Flush_compareUL (const void *a, const void *b)
+{
+	unsigned long ua = *(const unsigned long *) a;
+	unsigned long ub = *(const unsigned long *) b;
+	
+	return (ua > ub) - (ua < ub);
+}
+
+/**
+ * @brief Measures the latency of a L1 hit and of a memory access to place the hit threshold
+ */
+static void Flush_calibrate (SFlush *flush)
+{
+	unsigned long overhead = ~0UL, hot = ~0UL, start, stop, lat;
+	unsigned long cold[64];
+	unsigned i, nbLines = flush->canarySize / FLUSH_LINE_SIZE;
+	
+	if (nbLines > 64)
+	{
+		nbLines = 64;
+	}
+	
+	for (i = 0; i < 64; i++)
+	{
+		rdtscll_start (start);
+		rdtscpll_stop (stop);
+		if (stop - start < overhead)
+		{
+			overhead = stop - start;
+		}
+	}
+	
+	flush->canary[0] = 1;
+	for (i = 0; i < 64; i++)
+	{
+		lat = Flush_loadLatency (flush->canary);
+		if (lat < hot)
+		{
+			hot = lat;
+		}
+	}
+	
+	for (i = 0; i < nbLines; i++)
+	{
+		const char *line = flush->canary + i * FLUSH_LINE_SIZE;
+		
+		Flush_line (line, FLUSH_INSN_CLFLUSH);
+		asm volatile ("mfence" ::: "memory");
+		cold[i] = Flush_loadLatency (line);
+	}
+	qsort (cold, nbLines, sizeof (*cold), Flush_compareUL);
+	
+	hot = (hot > overhead) ? hot - overhead : 0;
+	lat = (cold[nbLines / 2] > overhead) ? cold[nbLines / 2] - overhead : 0;
+	if (lat < hot)
+	{
+		lat = hot;
+	}
+	
+	flush->threshold = overhead + hot + (lat - hot) / flushThresholdDivisor[flush->level];
+	Log_output (5, "Info: Flush verification: L1 hit in %lu cycles, memory access in %lu cycles, hit threshold at %lu cycles\n",
+				hot, lat, flush->threshold - overhead);
+}
+
+SFlush *Flush_create (SDescription *desc)
+{
+	SFlush *flush = malloc (sizeof (*flush));
+	unsigned eax, ebx, ecx, edx;
+	
+	assert (flush != NULL);
+	memset (flush, 0, sizeof (*flush));
+	
+	flush->strategy = Description_getFlushStrategy (desc);
+	flush->level = Description_getFlushLevel (desc);
+	flush->verify = Description_isFlushVerifyEnabled (desc);
+	
+	/* CPUID.(EAX=7,ECX=0):EBX bit 23 is clflushopt, bit 24 is clwb */
+	if (__get_cpuid_count (7, 0, &eax, &ebx, &ecx, &edx) == 0)
+	{
+		ebx = 0;
+	}
+	flush->evictInstruction = ((ebx & (1 << 23)) != 0) ? FLUSH_INSN_CLFLUSHOPT : FLUSH_INSN_CLFLUSH;
+	flush->instruction = flush->evictInstruction;
+	
+	if (flush->strategy == FLUSH_CLWB)
+	{
+		if ((ebx & (1 << 24)) != 0)
+		{
+			flush->instruction = FLUSH_INSN_CLWB;
+		}
+		else
+		{
+			Log_output (-1, "Warning: The processor has no clwb, the vectors are flushed with clflush instead and the measures are cold\n");
+			flush->strategy = FLUSH_CLFLUSH;
+		}
+	}
+	
+	if (flush->strategy == FLUSH_READ)
+	{
+		flush->dummy = Description_getDummyArrayAligned (desc);
+		flush->dummySize = Description_getDummySize (desc);
+	}
+	
+	/* Exec mode falls back to the eviction buffer for the clflush strategy */
+	if (flush->strategy == FLUSH_EVICT || flush->strategy == FLUSH_CLFLUSH)
+	{
+		EFlushLevel level = (flush->strategy == FLUSH_EVICT) ? flush->level : FLUSH_LEVEL_LLC;
+		
+		flush->bufferSize = FLUSH_EVICT_FACTOR * Flush_getLevelSize (level);
+		flush->buffer = malloc (flush->bufferSize);
+		assert (flush->buffer != NULL);
+		
+		/* Real pages allocation is done while writing in memory space */
+		memset (flush->buffer, 1, flush->bufferSize);
+		Log_output (5, "Info: Flush eviction buffer of %lu octets\n", (unsigned long) flush->bufferSize);
+		
+		/* Only the LLC is shared with the processors the helpers run on, and they would disturb the other benchmark processes */
+		if ((level == FLUSH_LEVEL_LLC || level == FLUSH_LEVEL_MEMORY) && Description_getNbProcess (desc) == 1)
+		{
+			flush->helpers = Flush_createHelpers (flush);
+		}
+	}
+	
+	if (flush->verify && (flush->strategy == FLUSH_NONE || flush->strategy == FLUSH_CLWB))
+	{
+		Log_output (5, "Info: Nothing to verify without eviction\n");
+		flush->verify = 0;
+	}
+	
+	if (flush->verify)
+	{
+		/* Half of the targeted level: it is fully cached before the flush */
+		flush->canarySize = Flush_getLevelSize (flush->level) / 2;
+		flush->canary = malloc (flush->canarySize);
+		assert (flush->canary != NULL);
+		memset (flush->canary, 1, flush->canarySize);
+		
+		Flush_calibrate (flush);
+	}
+	
+	return flush;
+}
+
+void Flush_destroy (SFlush *flush)
+{
+	if (flush == NULL)
+	{
+		return;
+	}
+	
+	if (flush->helpers != NULL)
+	{
+		Flush_destroyHelpers (flush->helpers, flush->helpers->nbHelpers), flush->helpers = NULL;
+	}
+	free (flush->canary), flush->canary = NULL;
+	free (flush->buffer), flush->buffer = NULL;
+	free (flush), flush = NULL;
+}
+
+void Flush_caches (SFlush *flush, SDescription *desc, void **arrays)
+{
+	unsigned i;
+	/* The clflush strategy only targets the vectors */
+	int isCanaryUsed = !(flush != NULL && flush->strategy == FLUSH_CLFLUSH && arrays != NULL);
+	
+	if (flush == NULL)
+	{
+		return;
+	}
+	
+	if (flush->verify && isCanaryUsed)
+	{
+		memset (flush->canary, 1, flush->canarySize);
+	}
+	
+	Flush_apply (flush, desc, arrays);
+	
+	if (flush->verify)
+	{
+		if (isCanaryUsed)
+		{
+			Flush_probe (flush, flush->canary, flush->canarySize);
+		}
+		
+		for (i = 0; arrays != NULL && i < (unsigned) Description_getNbVectors (desc); i++)
+		{
+			Flush_probe (flush, arrays[i], desc->vectorSizes[i] * Description_getVectorElementSize (desc));
+		}
+		
+		/* The probe itself brought lines back */
+		Flush_apply (flush, desc, arrays);
+	}
+}
+
+void Flush_report (SFlush *flush, int isPrintingProcess)
+{
+	double percent;
+	
+	if (flush == NULL || flush->probed == 0)
+	{
+		return;
+	}
+	
+	percent = 100. * flush->hits / flush->probed;
+	
+	if (isPrintingProcess)
+	{
+		Log_output ((percent > FLUSH_RESIDUAL_WARNING) ? -1 : 5, "%s: %.1f%% of the probed cache lines were still cached after the flush (%lu/%lu)\n",
+					(percent > FLUSH_RESIDUAL_WARNING) ? "Warning" : "Info", percent, flush->hits, flush->probed);
+	}
+	
+	flush->probed = flush->hits = 0;
+}
@@ -0,0 +1,189 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "BenchmarkExec.h"
+#include "Defines.h"
+#include "Description.h"
+#include "ForkServer.h"
+#include "Log.h"
+
+static int ForkServer_read (int fd, int *value)
+{
+	ssize_t size;
+	
+	do
+	{
+		size = read (fd, value, sizeof (*value));
+	} while (size == -1 && errno == EINTR);
+	
+	return size == sizeof (*value);
+}
+
+static int ForkServer_readUsage (int fd, struct rusage *usage)
+{
+	ssize_t size;
+	
+	do
+	{
+		size = read (fd, usage, sizeof (*usage));
+	} while (size == -1 && errno == EINTR);
+	
+	return size == sizeof (*usage);
+}
+
+static int ForkServer_write (int fd, int value)
+{
+	ssize_t size;
+	
+	do
+	{
+		size = write (fd, &value, sizeof (value));
+	} while (size == -1 && errno == EINTR);
+	
+	return size == sizeof (value);
+}
+
+/**
+ * @brief Adds the fork server stub in front of the libraries already preloaded (thread pinner)
+ */
+static void ForkServer_setPreload (void)
+{
+	char buf[STRBUF_MAXLEN];
+	char *preload = getenv ("LD_PRELOAD");
+	unsigned size;
+	
+	if (preload != NULL && preload[0] != '\0')
+	{
+		size = snprintf (buf, sizeof (buf), "%s/%s:%s", MLDIR, FORKSERVER_LIB_PATH, preload);
+	}
+	else
+	{
+		size = snprintf (buf, sizeof (buf), "%s/%s", MLDIR, FORKSERVER_LIB_PATH);
+	}
+	assert (size < sizeof (buf));
+	
+	if (setenv ("LD_PRELOAD", buf, 1) == -1)
+	{
+		perror ("Error while setting LD_PRELOAD environment variable");
+		abort ();
+	}
+}
+
+SForkServer *ForkServer_start (SDescription *desc, char *fileName, int overhead, int isPrintingProcess)
+{
+	SForkServer *server;
+	int ctlPipe[2], statusPipe[2];
+	int ready;
+	char buf[STRBUF_MAXLEN];
+	
+	assert (fileName != NULL);
+	
+	server = malloc (sizeof (*server));
+	assert (server != NULL);
+	memset (server, 0, sizeof (*server));
+	
+	if (pipe (ctlPipe) == -1 || pipe (statusPipe) == -1)
+	{
+		perror ("Error: fork server pipes creation");
+		exit (EXIT_FAILURE);
+	}
+	
+	switch (server->pid = fork ())
+	{
+		case -1:
+		{
+			perror ("Error when forking the fork server");
+			exit (EXIT_FAILURE);
+		}
+		case 0:
+		{
+			close (ctlPipe[1]);
+			close (statusPipe[0]);
+			
+			snprintf (buf, sizeof (buf), "%d", ctlPipe[0]);
+			setenv (FORKSERVER_ENV_CTL, buf, 1);
+			snprintf (buf, sizeof (buf), "%d", statusPipe[1]);
+			setenv (FORKSERVER_ENV_STATUS, buf, 1);
+			ForkServer_setPreload ();
+			
+			BenchmarkExec_prepareChildOutput (desc, overhead, isPrintingProcess);
+			BenchmarkExec_executeChild (desc, fileName);
+			break;
+		}
+		default:
+			break;
+	}
+	
+	close (ctlPipe[0]);
+	close (statusPipe[1]);
+	server->ctl = ctlPipe[1];
+	server->status = statusPipe[0];
+	
+	/* The stub tells us when the target reached main */
+	if (!ForkServer_read (server->status, &ready))
+	{
+		int status;
+		
+		Log_output (-1, "Error: \"%s\" did not start in fork-server mode (statically linked executables are not supported).\n", fileName);
+		waitpid (server->pid, &status, 0);
+		exit (EXIT_FAILURE);
+	}
+	
+	return server;
+}
+
+int ForkServer_run (SForkServer *server)
+{
+	int pid, status;
+	
+	assert (server != NULL);
+	
+	if (!ForkServer_write (server->ctl, FORKSERVER_RUN) || !ForkServer_read (server->status, &pid) || !ForkServer_read (server->status, &status) || !ForkServer_readUsage (server->status, &server->usage))
+	{
+		Log_output (-1, "Error: The fork server stopped unexpectedly.\n");
+		exit (EXIT_FAILURE);
+	}
+	server->lastChild = pid;
+	
+	return BenchmarkExec_checkChildStatus (status);
+}
+
+void ForkServer_stop (SForkServer *server)
+{
+	int status;
+	
+	if (server == NULL)
+	{
+		return;
+	}
+	
+	ForkServer_write (server->ctl, FORKSERVER_QUIT);
+	close (server->ctl);
+	close (server->status);
+	waitpid (server->pid, &status, 0);
+	
+	free (server), server = NULL;
+}
@@ -30,6 +30,41 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "Resume.h"
 #include "Toolkit.h"
 
+/* Long options without a short equivalent */
+enum LongOnlyOptions
+{
+	OPT_ADAPTIVE_PRECISION = 256,
+	OPT_ADAPTIVE_CRITERION,
+	OPT_MIN_META_REPETITION,
+	OPT_AUTO_REPETITION,
+	OPT_FORK_SERVER,
+	OPT_ROI,
+	OPT_CHILD_EVENTS,
+	OPT_RUSAGE,
+	OPT_BARRIER,
+	OPT_ARENA,
+	OPT_FLUSH,
+	OPT_FLUSH_LEVEL,
+	OPT_FLUSH_VERIFY,
+	OPT_PIN_POLICY,
+	OPT_NO_COMPILE_CACHE,
+	OPT_COMPILE_JOBS,
+	OPT_COMPILE_AHEAD,
+	OPT_BATCH,
+	OPT_FUSED_DRIVER,
+	OPT_AUDIT,
+	OPT_BINARY_OUTPUT,
+	OPT_SWEEP,
+	OPT_ALIGNMENT_SAMPLING,
+	OPT_ALIGNMENT_SAMPLES,
+	OPT_ALIGNMENT_SEED,
+	OPT_ALIGNMENT_THRESHOLD,
+	OPT_VECTOR_STEPPING,
+	OPT_VECTOR_RATIO,
+	OPT_VECTOR_POINTS,
+	OPT_VECTOR_THRESHOLD
+};
+
 static struct option option_list[] = {
 	{"summary", 0, 0, 'a'},
 	{"alloclib", 1, 0, 'A'},
@@ -77,6 +112,36 @@ static struct option option_list[] = {
     {"all-print-out", 0, 0, 'y'},
 	{"all-metric-output", 0, 0, 'Y'},
 	{"resumeid", 1, 0, 'z'},
+	{"adaptive-precision", 1, 0, OPT_ADAPTIVE_PRECISION},
+	{"adaptive-criterion", 1, 0, OPT_ADAPTIVE_CRITERION},
+	{"min-metarepetition", 1, 0, OPT_MIN_META_REPETITION},
+	{"auto-repetition", 1, 0, OPT_AUTO_REPETITION},
+	{"fork-server", 0, 0, OPT_FORK_SERVER},
+	{"roi", 0, 0, OPT_ROI},
+	{"child-events", 1, 0, OPT_CHILD_EVENTS},
+	{"rusage", 0, 0, OPT_RUSAGE},
+	{"barrier", 1, 0, OPT_BARRIER},
+	{"arena", 0, 0, OPT_ARENA},
+	{"flush", 1, 0, OPT_FLUSH},
+	{"flush-level", 1, 0, OPT_FLUSH_LEVEL},
+	{"flush-verify", 0, 0, OPT_FLUSH_VERIFY},
+	{"pin-policy", 1, 0, OPT_PIN_POLICY},
+	{"no-compile-cache", 0, 0, OPT_NO_COMPILE_CACHE},
+	{"compile-jobs", 1, 0, OPT_COMPILE_JOBS},
+	{"compile-ahead", 1, 0, OPT_COMPILE_AHEAD},
+	{"batch", 0, 0, OPT_BATCH},
+	{"fused-driver", 0, 0, OPT_FUSED_DRIVER},
+	{"audit", 0, 0, OPT_AUDIT},
+	{"binary-output", 0, 0, OPT_BINARY_OUTPUT},
+	{"sweep", 1, 0, OPT_SWEEP},
+	{"alignment-sampling", 1, 0, OPT_ALIGNMENT_SAMPLING},
+	{"alignment-samples", 1, 0, OPT_ALIGNMENT_SAMPLES},
+	{"alignment-seed", 1, 0, OPT_ALIGNMENT_SEED},
+	{"alignment-threshold", 1, 0, OPT_ALIGNMENT_THRESHOLD},
+	{"vector-stepping", 1, 0, OPT_VECTOR_STEPPING},
+	{"vector-ratio", 1, 0, OPT_VECTOR_RATIO},
+	{"vector-points", 1, 0, OPT_VECTOR_POINTS},
+	{"vector-threshold", 1, 0, OPT_VECTOR_THRESHOLD},
 	{0, 0, 0, 0}
 	};
 
@@ -108,6 +173,19 @@ static inline long Option_transformArgument (char *optarg)
 	return res;
 }
 
+/**
+  * @brief Transform a character chain into a double
+  * @param optarg the character chain
+  * @return returns the double version of it
+  */
+static inline double Option_transformDoubleArgument (char *optarg)
+{
+	char *end;
+	double res = strtod (optarg, &end);
+	assert (end != optarg && *end != '\n' && *optarg != '\0');
+	return res;
+}
+
 /**
  * @brief Some arguments must be handled before other, for allocation or specific purpose ; here is their handling
  *
@@ -416,6 +494,102 @@ static inline void Option_handleArguments (SDescription *desc, int argc, char *a
 			val = Option_transformArgument (optarg);
 			Description_setResumeId (desc, val);
 			break;
+		case OPT_ADAPTIVE_PRECISION: // --adaptive-precision
+			Description_setAdaptivePrecision (desc, Option_transformDoubleArgument (optarg));
+			break;
+		case OPT_ADAPTIVE_CRITERION: // --adaptive-criterion
+			Description_parseAdaptiveCriterion (desc, optarg);
+			break;
+		case OPT_MIN_META_REPETITION: // --min-metarepetition
+			val = Option_transformArgument (optarg);
+			Description_setMinMetaRepetition (desc, val);
+			break;
+		case OPT_AUTO_REPETITION: // --auto-repetition
+			Description_parseAutoRepetition (desc, optarg);
+			break;
+		case OPT_FORK_SERVER: // --fork-server
+			Description_forkServerEnable (desc);
+			break;
+		case OPT_ROI: // --roi
+			Description_roiEnable (desc);
+			break;
+		case OPT_CHILD_EVENTS: // --child-events
+			Description_setChildEvents (desc, optarg);
+			break;
+		case OPT_RUSAGE: // --rusage
+			Description_rusageEnable (desc);
+			break;
+		case OPT_BARRIER: // --barrier
+			Description_parseBarrierMode (desc, optarg);
+			break;
+		case OPT_ARENA: // --arena
+			Description_arenaEnable (desc);
+			break;
+		case OPT_FLUSH: // --flush
+			Description_parseFlushStrategy (desc, optarg);
+			break;
+		case OPT_FLUSH_LEVEL: // --flush-level
+			Description_parseFlushLevel (desc, optarg);
+			break;
+		case OPT_FLUSH_VERIFY: // --flush-verify
+			Description_flushVerifyEnable (desc);
+			break;
+		case OPT_PIN_POLICY: // --pin-policy
+			Description_parsePinPolicy (desc, optarg);
+			break;
+		case OPT_NO_COMPILE_CACHE: // --no-compile-cache
+			Description_compileCacheDisable (desc);
+			break;
+		case OPT_COMPILE_JOBS: // --compile-jobs
+			val = Option_transformArgument (optarg);
+			Description_setCompileJobs (desc, val);
+			break;
+		case OPT_COMPILE_AHEAD: // --compile-ahead
+			val = Option_transformArgument (optarg);
+			Description_setCompileAhead (desc, val);
+			break;
+		case OPT_BATCH: // --batch
+			Description_batchEnable (desc);
+			break;
+		case OPT_FUSED_DRIVER: // --fused-driver
+			Description_fusedDriverEnable (desc);
+			break;
+		case OPT_AUDIT: // --audit
+			Description_auditEnable (desc);
+			break;
+		case OPT_BINARY_OUTPUT: // --binary-output
+			Description_binaryOutputEnable (desc);
+			break;
+		case OPT_SWEEP: // --sweep
+			Description_parseSweepIsolation (desc, optarg);
+			break;
+		case OPT_ALIGNMENT_SAMPLING: // --alignment-sampling
+			Description_parseAlignmentSampling (desc, optarg);
+			break;
+		case OPT_ALIGNMENT_SAMPLES: // --alignment-samples
+			val = Option_transformArgument (optarg);
+			Description_setAlignmentSamples (desc, val);
+			break;
+		case OPT_ALIGNMENT_SEED: // --alignment-seed
+			val = Option_transformArgument (optarg);
+			Description_setAlignmentSeed (desc, val);
+			break;
+		case OPT_ALIGNMENT_THRESHOLD: // --alignment-threshold
+			Description_setAlignmentThreshold (desc, Option_transformDoubleArgument (optarg));
+			break;
+		case OPT_VECTOR_STEPPING: // --vector-stepping
+			Description_parseVectorStepping (desc, optarg);
+			break;
+		case OPT_VECTOR_RATIO: // --vector-ratio
+			Description_setVectorRatio (desc, Option_transformDoubleArgument (optarg));
+			break;
+		case OPT_VECTOR_POINTS: // --vector-points
+			val = Option_transformArgument (optarg);
+			Description_setVectorPoints (desc, val);
+			break;
+		case OPT_VECTOR_THRESHOLD: // --vector-threshold
+			Description_setVectorThreshold (desc, Option_transformDoubleArgument (optarg));
+			break;
 		default:
 			assert (argv != NULL && argv[0] != 0);
 			break;
@@ -474,9 +648,17 @@ void Option_printOptions (char *name)
 		"- \033[4mOptional Arguments\033[0m\n",
 		"\t--endvector <value> : Sets the end vector size (in elements)\n",
 		"\t--stepvector <value> : Sets the step between each vector size computation\n",
+		"\t--vector-stepping <linear|geometric|adaptive> : How the vector sizes are chosen (linear: every --stepvector; geometric: each size is the previous one times --vector-ratio, rounded to --stepvector; adaptive: the geometric sizes, then bisections of the intervals whose measures differ the most, e.g. around the cache capacities, one benchmark process only)\n",
+		"\t--vector-ratio <value> : Ratio between two consecutive sizes of the geometric progression (default 1.25)\n",
+		"\t--vector-points <value> : Number of vector sizes measured by the adaptive stepping (default twice the geometric progression)\n",
+		"\t--vector-threshold <value> : Relative difference between the measures of consecutive sizes above which the adaptive stepping bisects their interval first (default 0.1)\n",
 		"\t--data-size <value> : Sets the size of each vector(s) elements (float, double or customed numeric value)\n",
 		"\t--repetition <value> : Change the number of repetition to execute\n",
+		"\t--auto-repetition <value[ns|us|ms|cycles]> : Calibrate the repetitions before each measure so that it spans this duration, --repetition becomes the minimum\n",
 		"\t--metarepetition <value> : Change the number of meta-repetition to execute\n",
+		"\t--adaptive-precision <value> : Stop the meta-repetitions once this relative precision is reached (e.g. 0.01), --metarepetition becomes the maximum\n",
+		"\t--adaptive-criterion <ci|mad> : Precision criterion of the adaptive mode (95% confidence interval of the mean or median absolute deviation)\n",
+		"\t--min-metarepetition <value> : Minimum number of meta-repetitions in adaptive mode\n",
 		"\t--executerepetition <value> : Change the number of Microlauncher executions to be done\n",
 		"\t--initfunction <value> : Sets the function to initialize arrays in the input kernel file\n",
 		"\t--cpupin <value> : Change the processor we wish to be pinned on\n",
@@ -487,10 +669,23 @@ void Option_printOptions (char *name)
 		"\t--nbvector <value[1,8]> : Change the maximum of allocated vectors\n",
 		"\t--no-output : Disable the output csv file creation\n",
 		"\t--vectsurveyor \"{(start,stop,step);...}\": Change the alignment of allocated vectors\n",
+		"\t--alignment-sampling <full|random|lhs|adaptive> : How the alignment configurations of each vector size are chosen (full: every configuration; random: uniform draws without replacement; lhs: Latin hypercube covering each vector range evenly; adaptive: a Latin hypercube of half the samples, then the neighbours of the configurations deviating from theirs, one benchmark process only)\n",
+		"\t--alignment-samples <value> : Number of alignment configurations measured per vector size when sampling (default 1/20 of the configurations)\n",
+		"\t--alignment-seed <value> : Seed of the alignment sampling, the same seed draws the same configurations (default 1)\n",
+		"\t--alignment-threshold <value> : Relative deviation from the neighbour median above which the adaptive sampling measures the neighbours of a configuration (default 0.1)\n",
 		"\t--vectorspacing <value> : change the space (in octet) between two consecutive allocated vector\n",
+		"\t--arena : Allocate and prefault the vectors once for the largest size and alignment, then reuse them for every configuration\n",
 		"\t--omppath <value> : enables the OpenMP mode and sets the OMP library path (typically /usr/lib)\n",
+		"\t--no-compile-cache : Compile the sources at each launch instead of reusing the compilation cache kept in " MLDIR "/cache\n",
+		"\t--compile-jobs <value> : Number of compiler processes compiling the next kernels of --kernelname while the current one is measured, on the processors left free by the benchmark (default 0: compile in series)\n",
+		"\t--compile-ahead <value> : Maximum number of kernels compiled ahead of the measured one (default twice --compile-jobs)\n",
+		"\t--batch : The benchmark processes are launched once for the whole --kernelname list and load each kernel in turn, keeping the evaluation libraries, the allocator and the arrays\n",
+		"\t--fused-driver : Link a generated driver in the compiled kernel library: the repetitions are a direct loop around the kernel, timed with inline time stamp counter reads (\"Fused loop (cycles)\" column)\n",
+		"\t--audit : Counts the context switches, page faults and syscalls of each measurement window (perf software events) and flags the contaminated samples in the CSV\n",
+		"\t--pin-policy <linear|compact|scatter|physical|socket|list> : Places the OpenMP threads through OMP_PLACES and GOMP_CPU_AFFINITY (list is a processor list such as \"0,2,4-7\")\n",
 		"\t--output-dir <value> : Change the directory where output files will be stored.\n",
 		"\t--output-same-dir : Output files will be stored in the current directory.\n",
+		"\t--binary-output : Write the results in a binary columnar file (.mlr) instead of a CSV, Tools/mlr2csv/mlr2csv converts it back\n",
 		"\t--resume : Resumes a cancelled run\n",
 		"\t--resumeid : Changes the integer suffix for resume data files\n",
 		"\t--iteration-count <value> : Set a fixed number of iterations of the benchmark loop\n",
@@ -498,6 +693,9 @@ void Option_printOptions (char *name)
 		"\t--info \"type1;type2;...\" : Change the information in the output file\n",
 		"\t--no-eval-stack : Tells microlaunch to not reverse the stop evaluation library function call order\n",
 		"\t--sizedummy <value> : Change the size of the dummy array used to flush caches\n",
+		"\t--flush <read|clflush|clwb|evict|none> : How the caches are flushed before each meta-repetition (default read: dummy array; clflush: flush the lines of the vectors; clwb: write the lines of the vectors back to memory, they stay cached; evict: stream over a buffer sized from the --flush-level cache, with helper threads on the processors sharing the LLC)\n",
+		"\t--flush-level <l1|l2|llc|mem> : Cache level the evict flush empties (default llc; mem also flushes the vectors to memory)\n",
+		"\t--flush-verify : After each flush, probe the latency of sample lines and report the ones still cached\n",
 		"\t--log-output <value> : Redirect the Microlaunch log output in a file\n",
 		"\t--summary : Gives a summary of the execution with several information dealing with the current files in the output directory.\n",
 		"\t--logverbosity <value> : Change the Microlaunch log verbosity\n",
@@ -505,6 +703,8 @@ void Option_printOptions (char *name)
 		"- \033[4mMulti-process Arguments\033[0m\n",
 		"\t--kernelnames <value> : file containing the path of the benchmarks\n",
 		"\t--nbprocess <value> : number of benchmark process you want to launch\n",
+		"\t--barrier <futex|spin|pipe> : Synchronisation of the processes before each measure (default futex; spin releases them at a common TSC deadline but needs a core per process)\n",
+		"\t--sweep <cpu|core|l2> : Spread the size and alignment points on independent pinned processes taking them from a shared work-stealing queue, merged in one kernel_<name>_sweep output file (cpu: every processor; core: no shared SMT sibling; l2: no shared L2 cache; --nbprocess limits the number of processes)\n",
 		"\t--all-metric-output : Make all the processes defines by --nbprocess generate an output file\n\n",
 		//"- \033[4mUntested Arguments\033[0m\n",
 		"\033[1m STAND-ALONE EXECUTION MODE\n****************************\033[0m\n",
@@ -515,15 +715,27 @@ void Option_printOptions (char *name)
 		"\t--execargs <value> : Add your executable arguments (must be between quotes)\n",
 		"\t--repetition <value> : Change the number of repetition to execute\n",
 		"\t--metarepetition <value> : Change the number of meta-repetition to execute\n",
+		"\t--adaptive-precision <value> : Stop the meta-repetitions once this relative precision is reached (e.g. 0.01), --metarepetition becomes the maximum\n",
+		"\t--adaptive-criterion <ci|mad> : Precision criterion of the adaptive mode (95% confidence interval of the mean or median absolute deviation)\n",
+		"\t--min-metarepetition <value> : Minimum number of meta-repetitions in adaptive mode\n",
 		"\t--executerepetition <value> : Change the number of Microlauncher executions to be done\n",
 		"\t--execoutput <value> : Redirect the executable output in a file (stdout and stderr redirected)\n",
 		"\t--suppress-output : The input executable doesn't print anything\n",
+		"\t--fork-server : Start the executable once, stop it before main and fork a fresh copy of it for each measure (dynamically linked executables only)\n",
+		"\t--roi : Only measure the region between the ml_roi_begin () and ml_roi_end () calls of the executable (see Libraries/roi/roi.h)\n",
+		"\t--child-events <value> : Comma separated perf events (cycles,instructions,page-faults...) counted on the executable and its threads only, from its exec to its end\n",
+		"\t--rusage : Report the resource usage of the executable (faults, context switches, max RSS)\n",
+		"\t--flush <read|evict|none> : How the caches are flushed before each meta-repetition (default read: dummy array; evict: stream over a buffer sized from the --flush-level cache)\n",
+		"\t--flush-level <l1|l2|llc|mem> : Cache level the evict flush empties (default llc)\n",
+		"\t--flush-verify : After each flush, probe the latency of sample lines and report the ones still cached\n",
 		"\t--no-thread-pin : If the program is using pthreads, Microlaunch pins them by default. This option disable this feature.\n",
+		"\t--pin-policy <linear|compact|scatter|physical|socket|list> : Order of the processors the threads are pinned on (default linear: processor identifiers; compact: SMT siblings first; scatter: packages in turn; physical: one thread per core; socket: the package of --cpupin; list: a processor list such as \"0,2,4-7\")\n",
 		"\t--log-output <value> : Redirect the Microlaunch log output in a file\n",
 		"\t--logverbosity <value> : Change the Microlaunch log verbosity\n",
 		"\t--config <value> : Set a XML configuration file\n",
 		"- \033[4mMulti-process Arguments\033[0m\n",
 		"\t--nbprocess <value> : number of benchmark process you want to launch\n",
+		"\t--barrier <futex|spin|pipe> : Synchronisation of the processes before each measure (default futex; spin releases them at a common TSC deadline but needs a core per process)\n",
 		"\t--all-metric-output : Make all the processes defines by --nbprocess generate an output file\n",
 	};
 
@@ -0,0 +1,172 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "PerfEvents.h"
+
+#define PERF_CACHE_EVENT(cache, op, result) ((cache) | ((op) << 8) | ((result) << 16))
+
+/**
+ * @brief Association between an event name and its perf type/config
+ */
+typedef struct sPerfEventName
+{
+	const char *name;	/**< @brief Name of the event, as perf lists it */
+	uint32_t type;		/**< @brief perf_event_attr type */
+	uint64_t config;	/**< @brief perf_event_attr config */
+}SPerfEventName;
+
+static const SPerfEventName perfEventNames[] =
+{
+	{"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+	{"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+	{"cache-references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+	{"cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+	{"branches", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+	{"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+	{"bus-cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BUS_CYCLES},
+	{"stalled-cycles-frontend", PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+	{"stalled-cycles-backend", PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+	{"ref-cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_REF_CPU_CYCLES},
+	
+	{"cpu-clock", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_CLOCK},
+	{"task-clock", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+	{"page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+	{"minor-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MIN},
+	{"major-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MAJ},
+	{"context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+	{"cpu-migrations", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS},
+	{"alignment-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_ALIGNMENT_FAULTS},
+	{"emulation-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_EMULATION_FAULTS},
+	
+	{"L1-dcache-loads", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+	{"L1-dcache-load-misses", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+	{"L1-dcache-stores", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_WRITE, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+	{"L1-icache-load-misses", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_L1I, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+	{"LLC-loads", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+	{"LLC-load-misses", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+	{"LLC-stores", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_WRITE, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+	{"LLC-store-misses", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_WRITE, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+	{"dTLB-loads", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+	{"dTLB-load-misses", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+	{"iTLB-load-misses", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_ITLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+	{"branch-loads", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_BPU, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+	{"branch-load-misses", PERF_TYPE_HW_CACHE, PERF_CACHE_EVENT (PERF_COUNT_HW_CACHE_BPU, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+};
+
+int PerfEvents_parseEvent (const char *name, struct perf_event_attr *attr)
+{
+	char buf[128];
+	char *modifiers;
+	unsigned i;
+	int found = 0;
+	
+	assert (name != NULL && attr != NULL);
+	
+	memset (attr, 0, sizeof (*attr));
+	attr->size = sizeof (*attr);
+	
+	strncpy (buf, name, sizeof (buf) - 1);
+	buf[sizeof (buf) - 1] = '\0';
+	
+	/* Privilege level modifiers */
+	modifiers = strchr (buf, ':');
+	if (modifiers != NULL)
+	{
+		*modifiers = '\0';
+		modifiers++;
+	}
+	
+	/* Raw event: r followed by an hexadecimal code */
+	if (buf[0] == 'r' && buf[1] != '\0' && strspn (buf + 1, "0123456789abcdefABCDEF") == strlen (buf + 1))
+	{
+		attr->type = PERF_TYPE_RAW;
+		attr->config = strtoull (buf + 1, NULL, 16);
+		found = 1;
+	}
+	
+	for (i = 0; i < sizeof (perfEventNames) / sizeof (*perfEventNames) && !found; i++)
+	{
+		if (strcmp (buf, perfEventNames[i].name) == 0)
+		{
+			attr->type = perfEventNames[i].type;
+			attr->config = perfEventNames[i].config;
+			found = 1;
+		}
+	}
+	
+	if (!found)
+	{
+		return -1;
+	}
+	
+	/* By default, we only count the user level */
+	attr->exclude_kernel = 1;
+	attr->exclude_hv = 1;
+	
+	if (modifiers != NULL)
+	{
+		attr->exclude_user = (strchr (modifiers, 'u') == NULL);
+		attr->exclude_kernel = (strchr (modifiers, 'k') == NULL);
+		attr->exclude_hv = (strchr (modifiers, 'h') == NULL);
+	}
+	
+	return 0;
+}
+
+int PerfEvents_open (struct perf_event_attr *attr, pid_t pid, int cpu, int groupFd, unsigned long flags)
+{
+	return syscall (__NR_perf_event_open, attr, pid, cpu, groupFd, flags);
+}
+
+unsigned PerfEvents_splitList (char *list, char separator, char **tokens, unsigned max)
+{
+	unsigned nb = 0;
+	char *start = list, *ptr;
+	
+	assert (list != NULL);
+	
+	while (start != NULL)
+	{
+		ptr = strchr (start, separator);
+		if (ptr != NULL)
+		{
+			*ptr = '\0';
+		}
+		
+		/* Empty tokens are ignored */
+		if (*start != '\0')
+		{
+			if (tokens != NULL && nb < max)
+			{
+				tokens[nb] = start;
+			}
+			nb++;
+		}
+		
+		start = (ptr == NULL) ? NULL : ptr + 1;
+	}
+	
+	return nb;
+}
@@ -0,0 +1,542 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Log.h"
+#include "ResultSink.h"
+
+/* The CSV is written by large blocks too */
+#define RESULTSINK_CSV_BUFFER (1 << 20)
+
+/**
+ * @brief Prints the CSV header of a schema
+ */
+static void ResultSink_printCsvHeader (const SResultColumn *columns, unsigned nbColumns, FILE *csv)
+{
+	unsigned c;
+	
+	for (c = 0; c < nbColumns; c++)
+	{
+		if (columns[c].kind != RESULT_COLUMN_ERROR)
+		{
+			fprintf (csv, "\"%s\",", columns[c].name);
+		}
+	}
+	fprintf (csv, "\n");
+}
+
+/**
+ * @brief Prints the CSV lines of a block
+ * @param values the block, column by column
+ * @param stride the number of values between two columns
+ */
+static void ResultSink_printCsvRows (const SResultColumn *columns, unsigned nbColumns, const double *values, unsigned stride, unsigned nbRows, FILE *csv)
+{
+	unsigned c, r;
+	double value;
+	
+	for (r = 0; r < nbRows; r++)
+	{
+		for (c = 0; c < nbColumns; c++)
+		{
+			value = values[c * stride + r];
+			
+			switch (columns[c].kind)
+			{
+				case RESULT_COLUMN_INTEGER:
+					fprintf (csv, "%0.0f,", value);
+					break;
+				case RESULT_COLUMN_ERROR:
+					if (value != 0)
+					{
+						fprintf (csv, "%0.0f,", value);
+					}
+					break;
+				default:
+					fprintf (csv, "%0.6f,", value);
+					break;
+			}
+		}
+		fprintf (csv, "\n");
+	}
+}
+
+/**
+ * @brief Writes the header of the file
+ */
+static void ResultSink_writeHeader (SResultSink *sink)
+{
+	uint32_t header[2];
+	unsigned c;
+	
+	if (!sink->binary)
+	{
+		ResultSink_printCsvHeader (sink->columns, sink->nbColumns, sink->file);
+		return;
+	}
+	
+	header[0] = RESULTSINK_VERSION;
+	header[1] = sink->nbColumns;
+	if (fwrite (RESULTSINK_MAGIC, 1, strlen (RESULTSINK_MAGIC), sink->file) != strlen (RESULTSINK_MAGIC)
+		|| fwrite (header, sizeof (*header), 2, sink->file) != 2)
+	{
+		sink->error = 1;
+	}
+	
+	for (c = 0; c < sink->nbColumns; c++)
+	{
+		header[0] = sink->columns[c].kind;
+		header[1] = strlen (sink->columns[c].name);
+		if (fwrite (header, sizeof (*header), 2, sink->file) != 2
+			|| fwrite (sink->columns[c].name, 1, header[1], sink->file) != header[1])
+		{
+			sink->error = 1;
+		}
+	}
+}
+
+SResultSink *ResultSink_create (const char *fileName, int binary)
+{
+	SResultSink *sink;
+	
+	assert (fileName != NULL);
+	
+	sink = malloc (sizeof (*sink));
+	assert (sink != NULL);
+	memset (sink, 0, sizeof (*sink));
+	
+	sink->binary = binary;
+	sink->capacity = RESULTSINK_ROWS;
+	sink->file = fopen (fileName, binary ? "wb" : "w");
+	if (sink->file == NULL)
+	{
+		Log_output (-1, "Error: Cannot open file %s\n", fileName);
+		perror ("");
+		free (sink), sink = NULL;
+		return NULL;
+	}
+	
+	/* A block is written with a few system calls, whatever the number of rows */
+	setvbuf (sink->file, NULL, _IOFBF, RESULTSINK_CSV_BUFFER);
+	
+	return sink;
+}
+
+void ResultSink_addColumn (SResultSink *sink, const char *name, EResultColumnKind kind)
+{
+	assert (sink != NULL && name != NULL);
+	assert (sink->values == NULL); /* The schema cannot change once values are given */
+	
+	sink->columns = realloc (sink->columns, (sink->nbColumns + 1) * sizeof (*sink->columns));
+	assert (sink->columns != NULL);
+	
+	sink->columns[sink->nbColumns].name = strdup (name);
+	assert (sink->columns[sink->nbColumns].name != NULL);
+	sink->columns[sink->nbColumns].kind = kind;
+	sink->nbColumns++;
+}
+
+void ResultSink_put (SResultSink *sink, double value)
+{
+	assert (sink != NULL);
+	assert (sink->current < sink->nbColumns);
+	
+	/* The buffer is allocated once the schema is known */
+	if (sink->values == NULL)
+	{
+		sink->values = malloc (sink->capacity * sink->nbColumns * sizeof (*sink->values));
+		assert (sink->values != NULL);
+	}
+	
+	sink->values[sink->current * sink->capacity + sink->nbRows] = value;
+	sink->current++;
+}
+
+void ResultSink_endRow (SResultSink *sink)
+{
+	assert (sink != NULL);
+	assert (sink->current == sink->nbColumns);
+	
+	sink->current = 0;
+	sink->nbRows++;
+	
+	if (sink->nbRows == sink->capacity)
+	{
+		ResultSink_flush (sink);
+	}
+}
+
+int ResultSink_flush (SResultSink *sink)
+{
+	uint32_t nbRows;
+	unsigned c;
+	
+	assert (sink != NULL);
+	
+	if (!sink->headerWritten)
+	{
+		ResultSink_writeHeader (sink);
+		sink->headerWritten = 1;
+	}
+	
+	if (sink->nbRows > 0)
+	{
+		if (sink->binary)
+		{
+			nbRows = sink->nbRows;
+			if (fwrite (&nbRows, sizeof (nbRows), 1, sink->file) != 1)
+			{
+				sink->error = 1;
+			}
+			
+			for (c = 0; c < sink->nbColumns; c++)
+			{
+				if (fwrite (sink->values + c * sink->capacity, sizeof (*sink->values), nbRows, sink->file) != nbRows)
+				{
+					sink->error = 1;
+				}
+			}
+		}
+		else
+		{
+			ResultSink_printCsvRows (sink->columns, sink->nbColumns, sink->values, sink->capacity, sink->nbRows, sink->file);
+		}
+		sink->nbRows = 0;
+	}
+	
+	if (fflush (sink->file) != 0)
+	{
+		sink->error = 1;
+	}
+	
+	return sink->error ? -1 : 0;
+}
+
+int ResultSink_destroy (SResultSink *sink)
+{
+	unsigned c;
+	int res;
+	
+	if (sink == NULL)
+	{
+		return 0;
+	}
+	
+	res = ResultSink_flush (sink);
+	if (fclose (sink->file) != 0)
+	{
+		res = -1;
+	}
+	sink->file = NULL;
+	
+	if (res == -1)
+	{
+		Log_output (-1, "Error: The results could not be completely written\n");
+	}
+	
+	for (c = 0; c < sink->nbColumns; c++)
+	{
+		free (sink->columns[c].name), sink->columns[c].name = NULL;
+	}
+	free (sink->columns), sink->columns = NULL;
+	free (sink->values), sink->values = NULL;
+	free (sink), sink = NULL;
+	
+	return res;
+}
+
+/**
+ * @brief Releases a schema read from a binary result file
+ */
+static void ResultSink_freeSchema (SResultColumn *columns, unsigned nbColumns)
+{
+	unsigned c;
+	
+	for (c = 0; c < nbColumns; c++)
+	{
+		free (columns[c].name), columns[c].name = NULL;
+	}
+	free (columns), columns = NULL;
+}
+
+/**
+ * @brief Reads the header and the schema of a binary result file
+ * @param file the binary result file
+ * @param fileName its name, for the error messages
+ * @param nbColumns filled with the number of columns
+ * @return the schema, NULL if the file is not a valid binary result file
+ */
+static SResultColumn *ResultSink_readSchema (FILE *file, const char *fileName, unsigned *nbColumns)
+{
+	char magic[sizeof (RESULTSINK_MAGIC)];
+	uint32_t header[2];
+	SResultColumn *columns;
+	unsigned c;
+	
+	memset (magic, 0, sizeof (magic));
+	if (fread (magic, 1, strlen (RESULTSINK_MAGIC), file) != strlen (RESULTSINK_MAGIC) || strcmp (magic, RESULTSINK_MAGIC) != 0
+		|| fread (header, sizeof (*header), 2, file) != 2)
+	{
+		Log_output (-1, "Error: %s is not a microlaunch result file\n", fileName);
+		return NULL;
+	}
+	
+	if (header[0] != RESULTSINK_VERSION)
+	{
+		Log_output (-1, "Error: %s has the version %u of the result files, %u is expected\n", fileName, header[0], RESULTSINK_VERSION);
+		return NULL;
+	}
+	*nbColumns = header[1];
+	
+	columns = malloc ((*nbColumns + 1) * sizeof (*columns));
+	assert (columns != NULL);
+	
+	for (c = 0; c < *nbColumns; c++)
+	{
+		columns[c].name = NULL;
+		if (fread (header, sizeof (*header), 2, file) == 2 && header[0] < RESULT_COLUMN_NB_KINDS)
+		{
+			columns[c].kind = header[0];
+			columns[c].name = malloc (header[1] + 1);
+			assert (columns[c].name != NULL);
+			if (fread (columns[c].name, 1, header[1], file) != header[1])
+			{
+				free (columns[c].name), columns[c].name = NULL;
+			}
+		}
+		
+		if (columns[c].name == NULL)
+		{
+			Log_output (-1, "Error: %s has a corrupted schema\n", fileName);
+			ResultSink_freeSchema (columns, c);
+			return NULL;
+		}
+		columns[c].name[header[1]] = '\0';
+	}
+	
+	return columns;
+}
+
+int ResultSink_convert (const char *fileName, FILE *csv)
+{
+	FILE *file;
+	SResultColumn *columns;
+	unsigned nbColumns;
+	uint32_t nbRows;
+	size_t nbValues;
+	double *values = NULL;
+	int res = 0;
+	
+	assert (fileName != NULL && csv != NULL);
+	
+	file = fopen (fileName, "rb");
+	if (file == NULL)
+	{
+		Log_output (-1, "Error: Cannot open file %s\n", fileName);
+		perror ("");
+		return -1;
+	}
+	
+	columns = ResultSink_readSchema (file, fileName, &nbColumns);
+	if (columns == NULL)
+	{
+		fclose (file), file = NULL;
+		return -1;
+	}
+	
+	ResultSink_printCsvHeader (columns, nbColumns, csv);
+	
+	/* Each block is printed as it is read */
+	while (fread (&nbRows, sizeof (nbRows), 1, file) == 1)
+	{
+		nbValues = (size_t) nbRows * nbColumns;
+		values = realloc (values, (nbValues + 1) * sizeof (*values));
+		assert (values != NULL);
+		
+		if (fread (values, sizeof (*values), nbValues, file) != nbValues)
+		{
+			Log_output (-1, "Error: %s is truncated\n", fileName);
+			res = -1;
+			break;
+		}
+		
+		ResultSink_printCsvRows (columns, nbColumns, values, nbRows, nbRows, csv);
+	}
+	
+	ResultSink_freeSchema (columns, nbColumns);
+	free (values), values = NULL;
+	fclose (file), file = NULL;
+	
+	return res;
+}
+
+/**
+ * @brief A row of the merged files
+ */
+typedef struct sResultSinkRow
+{
+	double key;			/**< @brief Value of the key column */
+	size_t position;	/**< @brief Position of the row in the files */
+} SResultSinkRow;
+
+static int ResultSink_compareRows (const void *a, const void *b)
+{
+	const SResultSinkRow *ra = a, *rb = b;
+	
+	if (ra->key != rb->key)
+	{
+		return (ra->key > rb->key) - (ra->key < rb->key);
+	}
+	return (ra->position > rb->position) - (ra->position < rb->position);
+}
+
+/**
+ * @brief Appends the rows of a binary result file, row by row
+ * @param fileName the binary result file
+ * @param output the merge output, its schema is taken from the file if it has none
+ * @param rows the rows read so far (reallocated)
+ * @param nbRows the number of rows read so far (updated)
+ * @return 0 on success, -1 otherwise
+ */
+static int ResultSink_loadRows (const char *fileName, SResultSink *output, double **rows, size_t *nbRows)
+{
+	FILE *file;
+	SResultColumn *columns;
+	unsigned nbColumns, c;
+	uint32_t blockRows, r;
+	size_t nbValues;
+	double *block = NULL;
+	int res = 0;
+	
+	file = fopen (fileName, "rb");
+	if (file == NULL)
+	{
+		Log_output (-1, "Error: Cannot open file %s\n", fileName);
+		perror ("");
+		return -1;
+	}
+	
+	columns = ResultSink_readSchema (file, fileName, &nbColumns);
+	if (columns == NULL)
+	{
+		fclose (file), file = NULL;
+		return -1;
+	}
+	
+	if (output->nbColumns == 0)
+	{
+		for (c = 0; c < nbColumns; c++)
+		{
+			ResultSink_addColumn (output, columns[c].name, columns[c].kind);
+		}
+	}
+	
+	if (nbColumns != output->nbColumns)
+	{
+		Log_output (-1, "Error: %s does not have the schema of the merged files\n", fileName);
+		res = -1;
+	}
+	
+	while (res == 0 && fread (&blockRows, sizeof (blockRows), 1, file) == 1)
+	{
+		nbValues = (size_t) blockRows * nbColumns;
+		block = realloc (block, (nbValues + 1) * sizeof (*block));
+		assert (block != NULL);
+		
+		if (fread (block, sizeof (*block), nbValues, file) != nbValues)
+		{
+			Log_output (-1, "Error: %s is truncated\n", fileName);
+			res = -1;
+			break;
+		}
+		
+		*rows = realloc (*rows, ((*nbRows + blockRows) * nbColumns + 1) * sizeof (**rows));
+		assert (*rows != NULL);
+		
+		for (r = 0; r < blockRows; r++)
+		{
+			for (c = 0; c < nbColumns; c++)
+			{
+				(*rows)[(*nbRows + r) * nbColumns + c] = block[c * blockRows + r];
+			}
+		}
+		*nbRows += blockRows;
+	}
+	
+	ResultSink_freeSchema (columns, nbColumns);
+	free (block), block = NULL;
+	fclose (file), file = NULL;
+	
+	return res;
+}
+
+int ResultSink_merge (char **fileNames, unsigned nbFiles, const char *key, SResultSink *output)
+{
+	double *rows = NULL;
+	size_t nbRows = 0, r;
+	SResultSinkRow *order;
+	unsigned f, c;
+	int keyColumn = -1;
+	
+	assert (fileNames != NULL && key != NULL && output != NULL);
+	
+	for (f = 0; f < nbFiles; f++)
+	{
+		if (ResultSink_loadRows (fileNames[f], output, &rows, &nbRows) == -1)
+		{
+			free (rows), rows = NULL;
+			return -1;
+		}
+	}
+	
+	for (c = 0; c < output->nbColumns; c++)
+	{
+		if (strcmp (output->columns[c].name, key) == 0)
+		{
+			keyColumn = c;
+			break;
+		}
+	}
+	
+	order = malloc ((nbRows + 1) * sizeof (*order));
+	assert (order != NULL);
+	
+	for (r = 0; r < nbRows; r++)
+	{
+		order[r].key = (keyColumn >= 0) ? rows[r * output->nbColumns + keyColumn] : 0;
+		order[r].position = r;
+	}
+	qsort (order, nbRows, sizeof (*order), ResultSink_compareRows);
+	
+	for (r = 0; r < nbRows; r++)
+	{
+		for (c = 0; c < output->nbColumns; c++)
+		{
+			ResultSink_put (output, rows[order[r].position * output->nbColumns + c]);
+		}
+		ResultSink_endRow (output);
+	}
+	
+	free (order), order = NULL;
+	free (rows), rows = NULL;
+	
+	return 0;
+}
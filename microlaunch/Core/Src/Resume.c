@@ -86,6 +86,11 @@ int resumeLoad (struct sDescription *desc)
 	if(fscanf(file, "vectorSizeStep= %d\n", &desc->vectorSizeStep) != 1) return -1;
 	if(fscanf(file, "repetition= %d\n", &desc->repetition) != 1) return -1;
 	if(fscanf(file, "metaRepetition= %d\n", &desc->metaRepetition) != 1) return -1;
+	if(fscanf(file, "minMetaRepetition= %d\n", &desc->minMetaRepetition) != 1) return -1;
+	if(fscanf(file, "adaptivePrecision= %lf\n", &desc->adaptivePrecision) != 1) return -1;
+	if(fscanf(file, "adaptiveCriterion= %d\n", &desc->adaptiveCriterion) != 1) return -1;
+	if(fscanf(file, "autoRepetitionTarget= %lf\n", &desc->autoRepetitionTarget) != 1) return -1;
+	if(fscanf(file, "autoRepetitionUnit= %d\n", (int*)&desc->autoRepetitionUnit) != 1) return -1;
 	if(fscanf(file, "executeRepet= %d\n", &desc->executeRepet) != 1) return -1;
 	if(fscanf(file, "maxStride= %d\n", &desc->maxStride) != 1) return -1;
 	if(fscanf(file, "pageSize= %d\n", &desc->pageSize) != 1) return -1;
@@ -191,6 +196,50 @@ int resumeLoad (struct sDescription *desc)
 	if(fscanf(file, "resuming= %d\n", &desc->resuming) != 1) return -1;
 	if(fscanf(file, "number_of_resumes= %d\n", &desc->number_of_resumes) != 1) return -1;
 	if(fscanf(file, "resumeId= %d\n", &desc->resumeId) != 1) return -1;
+	if(fscanf(file, "alignmentSampling= %d\n", &desc->alignmentSampling) != 1) return -1;
+	if(fscanf(file, "alignmentSamples= %d\n", &desc->alignmentSamples) != 1) return -1;
+	if(fscanf(file, "alignmentSeed= %lu\n", &desc->alignmentSeed) != 1) return -1;
+	if(fscanf(file, "alignmentThreshold= %lf\n", &desc->alignmentThreshold) != 1) return -1;
+	// not relevant to save or load because the values do not need (or need not) to be saved from an execution to the other: sampler
+	if(fscanf(file, "vectorStepping= %d\n", &desc->vectorStepping) != 1) return -1;
+	if(fscanf(file, "vectorRatio= %lf\n", &desc->vectorRatio) != 1) return -1;
+	if(fscanf(file, "vectorPoints= %d\n", &desc->vectorPoints) != 1) return -1;
+	if(fscanf(file, "vectorThreshold= %lf\n", &desc->vectorThreshold) != 1) return -1;
+	// not relevant to save or load because the values do not need (or need not) to be saved from an execution to the other: stepping
+	if(fscanf(file, "flushStrategy= %d\n", &desc->flushStrategy) != 1) return -1;
+	if(fscanf(file, "flushLevel= %d\n", &desc->flushLevel) != 1) return -1;
+	if(fscanf(file, "flushVerify= %d\n", &desc->flushVerify) != 1) return -1;
+	// not relevant to save or load because the values do not need (or need not) to be saved from an execution to the other: flush
+	if(fscanf(file, "forkServer= %d\n", &desc->forkServer) != 1) return -1;
+	if(fscanf(file, "roi= %d\n", &desc->roi) != 1) return -1;
+	if(fscanf(file, "childEvents= %s\n", tmp) != 1) return -1;
+	if(strcmp(tmp, "(null)") == 0)
+	{
+		Description_setChildEvents (desc, NULL);
+	}
+	else Description_setChildEvents (desc, tmp);
+	if(fscanf(file, "rusage= %d\n", &desc->rusage) != 1) return -1;
+	if(fscanf(file, "barrierMode= %d\n", &desc->barrierMode) != 1) return -1;
+	// not relevant to save or load because the values do not need (or need not) to be saved from an execution to the other: barrier
+	if(fscanf(file, "arena= %d\n", &desc->arena) != 1) return -1;
+	if(fscanf(file, "pinPolicy= %d\n", &desc->pinPolicy) != 1) return -1;
+	if(fscanf(file, "pinList= %s\n", tmp) != 1) return -1;
+	if(strcmp(tmp, "(null)") == 0)
+	{
+		Description_setPinList (desc, NULL);
+	}
+	else Description_setPinList (desc, tmp);
+	if(fscanf(file, "compileCache= %d\n", &desc->compileCache) != 1) return -1;
+	if(fscanf(file, "compileJobs= %d\n", &desc->compileJobs) != 1) return -1;
+	if(fscanf(file, "compileAhead= %d\n", &desc->compileAhead) != 1) return -1;
+	if(fscanf(file, "batch= %d\n", &desc->batch) != 1) return -1;
+	if(fscanf(file, "fusedDriver= %d\n", &desc->fusedDriver) != 1) return -1;
+	if(fscanf(file, "auditMode= %d\n", &desc->auditMode) != 1) return -1;
+	// not relevant to save or load because the values do not need (or need not) to be saved from an execution to the other: audit
+	if(fscanf(file, "binaryOutput= %d\n", &desc->binaryOutput) != 1) return -1;
+	if(fscanf(file, "sweep= %d\n", &desc->sweep) != 1) return -1;
+	if(fscanf(file, "sweepIsolation= %d\n", &desc->sweepIsolation) != 1) return -1;
+	// not relevant to save or load because the values do not need (or need not) to be saved from an execution to the other: sweepQueue
 
 
 	fclose(file);
@@ -230,6 +279,8 @@ int resumeLoadCounters (struct sDescription *desc)
 	if(fscanf(file, "current_meta_repet= %d\n", &desc->temp_values.current_meta_repet) != 1) return -1;
 	if(fscanf(file, "current_execute_repets= %d\n", &desc->temp_values.current_execute_repet) != 1) return -1;
 	if(fscanf(file, "curruns= %d\n", &desc->temp_values.curruns) != 1) return -1;
+	if(fscanf(file, "current_sample= %d\n", &desc->temp_values.current_sample) != 1) return -1;
+	if(fscanf(file, "current_size_step= %d\n", &desc->temp_values.current_size_step) != 1) return -1;
 	
 	fclose(file);
 
@@ -260,6 +311,11 @@ int resumeSave(struct sDescription *desc)
 	fprintf(file, "vectorSizeStep= %d\n", desc->vectorSizeStep);
 	fprintf(file, "repetition= %d\n", desc->repetition);
 	fprintf(file, "metaRepetition= %d\n", desc->metaRepetition);
+	fprintf(file, "minMetaRepetition= %d\n", desc->minMetaRepetition);
+	fprintf(file, "adaptivePrecision= %lf\n", desc->adaptivePrecision);
+	fprintf(file, "adaptiveCriterion= %d\n", desc->adaptiveCriterion);
+	fprintf(file, "autoRepetitionTarget= %lf\n", desc->autoRepetitionTarget);
+	fprintf(file, "autoRepetitionUnit= %d\n", desc->autoRepetitionUnit);
 	fprintf(file, "executeRepet= %d\n", desc->executeRepet);
 	fprintf(file, "maxStride= %d\n", desc->maxStride);
 	fprintf(file, "pageSize= %d\n", desc->pageSize);
@@ -307,6 +363,34 @@ int resumeSave(struct sDescription *desc)
 	fprintf(file, "resuming= %d\n", 1);
 	fprintf(file, "number_of_resumes= %d\n", desc->number_of_resumes);
 	fprintf(file, "resumeId= %d\n", desc->resumeId);
+	fprintf(file, "alignmentSampling= %d\n", desc->alignmentSampling);
+	fprintf(file, "alignmentSamples= %d\n", desc->alignmentSamples);
+	fprintf(file, "alignmentSeed= %lu\n", desc->alignmentSeed);
+	fprintf(file, "alignmentThreshold= %.17g\n", desc->alignmentThreshold);
+	fprintf(file, "vectorStepping= %d\n", desc->vectorStepping);
+	fprintf(file, "vectorRatio= %.17g\n", desc->vectorRatio);
+	fprintf(file, "vectorPoints= %d\n", desc->vectorPoints);
+	fprintf(file, "vectorThreshold= %.17g\n", desc->vectorThreshold);
+	fprintf(file, "flushStrategy= %d\n", desc->flushStrategy);
+	fprintf(file, "flushLevel= %d\n", desc->flushLevel);
+	fprintf(file, "flushVerify= %d\n", desc->flushVerify);
+	fprintf(file, "forkServer= %d\n", desc->forkServer);
+	fprintf(file, "roi= %d\n", desc->roi);
+	fprintf(file, "childEvents= %s\n", desc->childEvents);
+	fprintf(file, "rusage= %d\n", desc->rusage);
+	fprintf(file, "barrierMode= %d\n", desc->barrierMode);
+	fprintf(file, "arena= %d\n", desc->arena);
+	fprintf(file, "pinPolicy= %d\n", desc->pinPolicy);
+	fprintf(file, "pinList= %s\n", desc->pinList);
+	fprintf(file, "compileCache= %d\n", desc->compileCache);
+	fprintf(file, "compileJobs= %d\n", desc->compileJobs);
+	fprintf(file, "compileAhead= %d\n", desc->compileAhead);
+	fprintf(file, "batch= %d\n", desc->batch);
+	fprintf(file, "fusedDriver= %d\n", desc->fusedDriver);
+	fprintf(file, "auditMode= %d\n", desc->auditMode);
+	fprintf(file, "binaryOutput= %d\n", desc->binaryOutput);
+	fprintf(file, "sweep= %d\n", desc->sweep);
+	fprintf(file, "sweepIsolation= %d\n", desc->sweepIsolation);
 
 	fprintf(file, "#Saving was successful if this line ends with a dot.");
 	fclose(file);
@@ -340,6 +424,8 @@ int resumeSaveCounters(struct sDescription *desc)
 	fprintf(file, "current_meta_repet= %d\n", desc->temp_values.current_meta_repet);
 	fprintf(file, "current_execute_repets= %d\n", desc->temp_values.current_execute_repet);
 	fprintf(file, "curruns= %d\n", desc->temp_values.curruns);
+	fprintf(file, "current_sample= %d\n", desc->temp_values.current_sample);
+	fprintf(file, "current_size_step= %d\n", desc->temp_values.current_size_step);
 
 	fprintf(file, "#Saving was successful if this line ends with a dot.");
 	fclose(file);
@@ -0,0 +1,204 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Defines.h"
+#include "Description.h"
+#include "Log.h"
+#include "Roi.h"
+
+static void Roi_setEnv (const char *name, const char *value)
+{
+	if (setenv (name, value, 1) == -1)
+	{
+		perror ("Error while setting a region of interest environment variable");
+		exit (EXIT_FAILURE);
+	}
+}
+
+/**
+ * @brief Gives the target the evaluation libraries it has to load, with absolute paths as it may change its directory
+ */
+static void Roi_setEvaluationLibraries (SDescription *desc)
+{
+	unsigned nbEvalLibs = Description_getNbEvaluationLibrairies (desc);
+	char buf[STRBUF_MAXLEN * ROI_MAX_EVALLIBS];
+	char path[PATH_MAX];
+	unsigned i, size = 0;
+	
+	buf[0] = '\0';
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		const char *name = Description_getEvaluationLibraryName (desc, i);
+		
+		if (realpath (name, path) != NULL)
+		{
+			name = path;
+		}
+		
+		size += snprintf (buf + size, sizeof (buf) - size, "%s%s", (i == 0) ? "" : ":", name);
+		assert (size < sizeof (buf));
+	}
+	
+	Roi_setEnv (ROI_ENV_EVALLIBS, buf);
+}
+
+/**
+ * @brief Adds the ROI library in front of the libraries already preloaded (thread pinner)
+ */
+static void Roi_setPreload (SRoi *roi)
+{
+	char buf[STRBUF_MAXLEN];
+	char *preload = getenv ("LD_PRELOAD");
+	unsigned size;
+	
+	if (preload != NULL && preload[0] != '\0')
+	{
+		roi->previousPreload = strdup (preload);
+		assert (roi->previousPreload != NULL);
+		size = snprintf (buf, sizeof (buf), "%s/%s:%s", MLDIR, ROI_LIB_PATH, preload);
+	}
+	else
+	{
+		size = snprintf (buf, sizeof (buf), "%s/%s", MLDIR, ROI_LIB_PATH);
+	}
+	assert (size < sizeof (buf));
+	
+	Roi_setEnv ("LD_PRELOAD", buf);
+}
+
+SRoi *Roi_create (SDescription *desc)
+{
+	SRoi *roi;
+	char buf[STRBUF_MAXLEN];
+	
+	if (Description_getNbEvaluationLibrairies (desc) > ROI_MAX_EVALLIBS)
+	{
+		Log_output (-1, "Error: The region of interest mode supports at most %d evaluation libraries.\n", ROI_MAX_EVALLIBS);
+		exit (EXIT_FAILURE);
+	}
+	
+	roi = malloc (sizeof (*roi));
+	assert (roi != NULL);
+	memset (roi, 0, sizeof (*roi));
+	
+	/* An anonymous file: it is inherited through fork and exec, and disappears with its last user */
+	roi->fd = syscall (SYS_memfd_create, "microlaunch-roi", 0);
+	if (roi->fd == -1)
+	{
+		perror ("Error: region of interest channel creation");
+		exit (EXIT_FAILURE);
+	}
+	
+	if (ftruncate (roi->fd, sizeof (*roi->channel)) == -1)
+	{
+		perror ("Error: region of interest channel sizing");
+		exit (EXIT_FAILURE);
+	}
+	
+	roi->channel = mmap (NULL, sizeof (*roi->channel), PROT_READ | PROT_WRITE, MAP_SHARED, roi->fd, 0);
+	if (roi->channel == MAP_FAILED)
+	{
+		perror ("Error: region of interest channel mapping");
+		exit (EXIT_FAILURE);
+	}
+	
+	snprintf (buf, sizeof (buf), "%d", roi->fd);
+	Roi_setEnv (ROI_ENV_FD, buf);
+	Roi_setEvaluationLibraries (desc);
+	Roi_setPreload (roi);
+	
+	Roi_reset (roi);
+	
+	return roi;
+}
+
+void Roi_reset (SRoi *roi)
+{
+	assert (roi != NULL);
+	memset (roi->channel, 0, sizeof (*roi->channel));
+}
+
+void Roi_setEmpty (SRoi *roi, int empty)
+{
+	assert (roi != NULL);
+	
+	if (empty)
+	{
+		Roi_setEnv (ROI_ENV_EMPTY, "1");
+	}
+	else
+	{
+		unsetenv (ROI_ENV_EMPTY);
+	}
+}
+
+unsigned Roi_store (SRoi *roi, BenchResult **res, unsigned nbEvalLibs, unsigned idX)
+{
+	SRoiChannel *channel;
+	unsigned i, c;
+	
+	assert (roi != NULL && res != NULL);
+	channel = roi->channel;
+	
+	for (i = 0; i < nbEvalLibs; i++)
+	{
+		res[i]->time[idX] = channel->values[i];
+		
+		for (c = 0; c < res[i]->nbCounters; c++)
+		{
+			res[i]->counters[c][idX] = (c < channel->nbCounters[i]) ? channel->counters[i][c] : 0.;
+		}
+	}
+	
+	return channel->nbRegions;
+}
+
+void Roi_destroy (SRoi *roi)
+{
+	if (roi == NULL)
+	{
+		return;
+	}
+	
+	munmap (roi->channel, sizeof (*roi->channel));
+	close (roi->fd);
+	
+	unsetenv (ROI_ENV_FD);
+	unsetenv (ROI_ENV_EVALLIBS);
+	unsetenv (ROI_ENV_EMPTY);
+	if (roi->previousPreload != NULL)
+	{
+		Roi_setEnv ("LD_PRELOAD", roi->previousPreload);
+		free (roi->previousPreload), roi->previousPreload = NULL;
+	}
+	else
+	{
+		unsetenv ("LD_PRELOAD");
+	}
+	
+	free (roi), roi = NULL;
+}
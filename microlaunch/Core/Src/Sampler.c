@@ -0,0 +1,538 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Description.h"
+#include "Sampler.h"
+#include "Statistics.h"
+
+/**
+ * @brief A measured configuration and its distance to the one being examined
+ */
+typedef struct sSamplerNeighbour
+{
+	unsigned distance;	/**< @brief Number of alignment steps between both configurations */
+	double timing;		/**< @brief Measure of the configuration */
+} SSamplerNeighbour;
+
+/**
+ * @brief A configuration examined by the refinement
+ */
+typedef struct sSamplerCandidate
+{
+	double deviation;	/**< @brief Relative deviation from the neighbours */
+	unsigned idx;		/**< @brief Index in the configuration list */
+} SSamplerCandidate;
+
+/**
+ * @brief splitmix64: small, and the draws only depend on the seed
+ */
+static inline uint64_t Sampler_random (SSampler *sampler)
+{
+	uint64_t z = (sampler->rng += 0x9e3779b97f4a7c15ULL);
+	
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+/**
+ * @brief Draws a real number in [0, 1)
+ */
+static inline double Sampler_uniform (SSampler *sampler)
+{
+	return (Sampler_random (sampler) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Adds a configuration to the set of the drawn ones
+ * @return 1 if it was added, 0 if it was already drawn
+ */
+static int Sampler_insert (SSampler *sampler, uint64_t point)
+{
+	unsigned mask = sampler->drawnSize - 1;
+	unsigned slot = (unsigned) ((point * 0x9e3779b97f4a7c15ULL) >> 32) & mask;
+	
+	while (sampler->drawn[slot] != 0)
+	{
+		if (sampler->drawn[slot] == point + 1)
+		{
+			return 0;
+		}
+		slot = (slot + 1) & mask;
+	}
+	
+	sampler->drawn[slot] = point + 1;
+	return 1;
+}
+
+/**
+ * @brief Appends a configuration to the list, if it was not drawn yet and the budget allows it
+ * @return 1 if it was appended, 0 otherwise
+ */
+static int Sampler_append (SSampler *sampler, uint64_t point)
+{
+	if (sampler->nbPoints >= sampler->budget || Sampler_insert (sampler, point) == 0)
+	{
+		return 0;
+	}
+	
+	sampler->points[sampler->nbPoints] = point;
+	sampler->timings[sampler->nbPoints] = NAN;
+	sampler->refined[sampler->nbPoints] = 0;
+	sampler->nbPoints++;
+	return 1;
+}
+
+/**
+ * @brief Appends uniform random configurations until the list holds count of them
+ */
+static void Sampler_drawRandom (SSampler *sampler, unsigned count)
+{
+	while (sampler->nbPoints < count)
+	{
+		Sampler_append (sampler, Sampler_random (sampler) % sampler->nbConfigurations);
+	}
+}
+
+/**
+ * @brief Appends a Latin hypercube of count configurations: the range of each vector is cut in count strata, each one used once
+ */
+static void Sampler_drawLatinHypercube (SSampler *sampler, unsigned count)
+{
+	unsigned *permutations = malloc ((size_t) sampler->nbVectors * count * sizeof (*permutations));
+	unsigned d, k, j, tmp;
+	uint64_t point;
+	
+	assert (permutations != NULL);
+	
+	/* One shuffled stratum order per vector (Fisher-Yates) */
+	for (d = 0; d < sampler->nbVectors; d++)
+	{
+		unsigned *perm = permutations + (size_t) d * count;
+		
+		for (k = 0; k < count; k++)
+		{
+			perm[k] = k;
+		}
+		for (k = count - 1; k > 0; k--)
+		{
+			j = Sampler_random (sampler) % (k + 1);
+			tmp = perm[k], perm[k] = perm[j], perm[j] = tmp;
+		}
+	}
+	
+	for (k = 0; k < count; k++)
+	{
+		point = 0;
+		for (d = 0; d < sampler->nbVectors; d++)
+		{
+			unsigned level = (unsigned) ((permutations[(size_t) d * count + k] + Sampler_uniform (sampler)) * sampler->nbLevels[d] / count);
+			
+			point = point * sampler->nbLevels[d] + (level < sampler->nbLevels[d] ? level : sampler->nbLevels[d] - 1);
+		}
+		Sampler_append (sampler, point);
+	}
+	free (permutations), permutations = NULL;
+	
+	/* Vectors with fewer alignments than strata give duplicates: they are replaced by random configurations */
+	Sampler_drawRandom (sampler, count);
+}
+
+/**
+ * @brief Gives the alignment level of each vector of a configuration
+ */
+static void Sampler_decode (const SSampler *sampler, uint64_t point, unsigned *levels)
+{
+	int d;
+	
+	for (d = sampler->nbVectors - 1; d >= 0; d--)
+	{
+		levels[d] = point % sampler->nbLevels[d];
+		point /= sampler->nbLevels[d];
+	}
+}
+
+static int Sampler_compareCandidates (const void *a, const void *b)
+{
+	const SSamplerCandidate *ca = a, *cb = b;
+	
+	return (ca->deviation < cb->deviation) - (ca->deviation > cb->deviation);
+}
+
+/**
+ * @brief Gives the relative deviation of a measured configuration from the median of its nearest measured ones
+ * @param nearest buffer of 2 * nbVectors neighbours
+ * @param timings buffer of 2 * nbVectors values
+ * @param levels buffer of 2 * nbVectors levels
+ * @return the deviation, NAN if it has no measured neighbour
+ */
+static double Sampler_score (const SSampler *sampler, unsigned idx, SSamplerNeighbour *nearest, double *timings, unsigned *levels)
+{
+	unsigned nbVectors = sampler->nbVectors;
+	unsigned nbNeighbours = 2 * nbVectors;
+	unsigned *other = levels + nbVectors;
+	unsigned j, d, k, n = 0, distance;
+	double reference;
+	
+	/* The nearest measured configurations in alignment steps, kept sorted in a bounded buffer */
+	Sampler_decode (sampler, sampler->points[idx], levels);
+	for (j = 0; j < sampler->nbPoints; j++)
+	{
+		if (j == idx || isnan (sampler->timings[j]))
+		{
+			continue;
+		}
+		
+		Sampler_decode (sampler, sampler->points[j], other);
+		distance = 0;
+		for (d = 0; d < nbVectors; d++)
+		{
+			distance += (levels[d] > other[d]) ? levels[d] - other[d] : other[d] - levels[d];
+		}
+		
+		if (n == nbNeighbours && distance >= nearest[n - 1].distance)
+		{
+			continue;
+		}
+		
+		k = (n < nbNeighbours) ? n++ : n - 1;
+		for ( ; k > 0 && nearest[k - 1].distance > distance; k--)
+		{
+			nearest[k] = nearest[k - 1];
+		}
+		nearest[k].distance = distance;
+		nearest[k].timing = sampler->timings[j];
+	}
+	
+	if (n == 0)
+	{
+		return NAN;
+	}
+	
+	for (k = 0; k < n; k++)
+	{
+		timings[k] = nearest[k].timing;
+	}
+	reference = Statistics_median (timings, n);
+	
+	return (reference != 0) ? fabs (sampler->timings[idx] - reference) / fabs (reference) : NAN;
+}
+
+/**
+ * @brief Adaptive mode: adds the unmeasured grid neighbours of the measured configurations deviating the most from their nearest measured ones
+ */
+static void Sampler_refine (SSampler *sampler)
+{
+	unsigned nbVectors = sampler->nbVectors;
+	SSamplerNeighbour *nearest = malloc (2 * nbVectors * sizeof (*nearest));
+	SSamplerCandidate *candidates = malloc (sampler->nbPoints * sizeof (*candidates));
+	unsigned *levels = malloc (2 * nbVectors * sizeof (*levels));
+	double *timings = malloc (2 * nbVectors * sizeof (*timings));
+	unsigned i, d, nbCandidates = 0, before = sampler->nbPoints;
+	uint64_t point, stride;
+	
+	assert (nearest != NULL && candidates != NULL && levels != NULL && timings != NULL);
+	
+	/* Only the configurations measured since the last refinement are scored, the others keep their deviation */
+	for (i = sampler->nbScored; i < sampler->nbPoints; i++)
+	{
+		sampler->deviations[i] = isnan (sampler->timings[i]) ? NAN : Sampler_score (sampler, i, nearest, timings, levels);
+	}
+	sampler->nbScored = sampler->nbPoints;
+	
+	for (i = 0; i < sampler->nbPoints; i++)
+	{
+		if (!sampler->refined[i] && !isnan (sampler->deviations[i]) && sampler->deviations[i] > sampler->threshold)
+		{
+			candidates[nbCandidates].deviation = sampler->deviations[i];
+			candidates[nbCandidates].idx = i;
+			nbCandidates++;
+		}
+	}
+	
+	qsort (candidates, nbCandidates, sizeof (*candidates), Sampler_compareCandidates);
+	
+	/* One alignment step away on each vector, the most deviating configurations first */
+	for (i = 0; i < nbCandidates && sampler->nbPoints < sampler->budget; i++)
+	{
+		sampler->refined[candidates[i].idx] = 1;
+		point = sampler->points[candidates[i].idx];
+		Sampler_decode (sampler, point, levels);
+		
+		stride = 1;
+		for (d = nbVectors; d-- > 0; )
+		{
+			if (levels[d] > 0)
+			{
+				Sampler_append (sampler, point - stride);
+			}
+			if (levels[d] + 1 < sampler->nbLevels[d])
+			{
+				Sampler_append (sampler, point + stride);
+			}
+			stride *= sampler->nbLevels[d];
+		}
+	}
+	
+	/* Nothing deviates (or every neighbour is measured): the budget is spent on the rest of the space */
+	if (sampler->nbPoints == before)
+	{
+		Sampler_drawRandom (sampler, before + 1);
+	}
+	
+	free (nearest), nearest = NULL;
+	free (candidates), candidates = NULL;
+	free (levels), levels = NULL;
+	free (timings), timings = NULL;
+}
+
+unsigned Sampler_getNbLevels (const int *vect)
+{
+	int tmp = vect[VSTOP] - vect[VSTART];
+	
+	if (vect[VSTART] < vect[VSTOP] && vect[VSTEP] != 0)
+	{
+		tmp /= vect[VSTEP];
+	}
+	return tmp + 1;
+}
+
+/**
+ * @brief Gives the number of configurations of the full product
+ */
+static uint64_t Sampler_getNbConfigurations (SDescription *desc)
+{
+	int nbVectors = Description_getNbVectors (desc);
+	uint64_t res = 1;
+	unsigned nbLevels;
+	int *vect;
+	int i;
+	
+	for (i = 0; i < nbVectors; i++)
+	{
+		vect = Description_getVector (desc, i);
+		if (vect != NULL)
+		{
+			nbLevels = Sampler_getNbLevels (vect);
+			res = (nbLevels != 0 && res > UINT64_MAX / nbLevels) ? UINT64_MAX : res * nbLevels;
+		}
+	}
+	return res;
+}
+
+uint64_t Sampler_getNbSamples (SDescription *desc)
+{
+	uint64_t nbConfigurations = Sampler_getNbConfigurations (desc);
+	uint64_t nbSamples = Description_getAlignmentSamples (desc);
+	
+	/* By default, a share of the full product */
+	if (Description_getAlignmentSamples (desc) == DEFAULT_ALIGNMENT_SAMPLES)
+	{
+		nbSamples = (nbConfigurations + SAMPLER_DEFAULT_RATIO - 1) / SAMPLER_DEFAULT_RATIO;
+	}
+	
+	if (Description_getAlignmentSampling (desc) == SAMPLER_FULL || nbSamples >= nbConfigurations)
+	{
+		return nbConfigurations;
+	}
+	return nbSamples;
+}
+
+SSampler *Sampler_create (SDescription *desc)
+{
+	SSampler *sampler;
+	unsigned d;
+	int *vect;
+	
+	if (Description_getAlignmentSampling (desc) == SAMPLER_FULL || Description_getNbVectors (desc) <= 0 || Description_getVector (desc, 0) == NULL)
+	{
+		return NULL;
+	}
+	
+	sampler = malloc (sizeof (*sampler));
+	assert (sampler != NULL);
+	memset (sampler, 0, sizeof (*sampler));
+	
+	sampler->mode = Description_getAlignmentSampling (desc);
+	sampler->nbVectors = Description_getNbVectors (desc);
+	sampler->nbLevels = malloc (sampler->nbVectors * sizeof (*sampler->nbLevels));
+	sampler->start = malloc (sampler->nbVectors * sizeof (*sampler->start));
+	sampler->step = malloc (sampler->nbVectors * sizeof (*sampler->step));
+	assert (sampler->nbLevels != NULL && sampler->start != NULL && sampler->step != NULL);
+	
+	for (d = 0; d < sampler->nbVectors; d++)
+	{
+		vect = Description_getVector (desc, d);
+		sampler->nbLevels[d] = Sampler_getNbLevels (vect);
+		sampler->start[d] = vect[VSTART];
+		sampler->step[d] = (vect[VSTEP] != 0) ? vect[VSTEP] : 1;
+	}
+	
+	sampler->nbConfigurations = Sampler_getNbConfigurations (desc);
+	sampler->budget = (unsigned) Sampler_getNbSamples (desc);	/* Bounded by Description_AssertValues */
+	sampler->threshold = Description_getAlignmentThreshold (desc);
+	sampler->seed = Description_getAlignmentSeed (desc);
+	
+	sampler->points = malloc (sampler->budget * sizeof (*sampler->points));
+	sampler->timings = malloc (sampler->budget * sizeof (*sampler->timings));
+	sampler->refined = malloc (sampler->budget * sizeof (*sampler->refined));
+	sampler->deviations = malloc (sampler->budget * sizeof (*sampler->deviations));
+	assert (sampler->points != NULL && sampler->timings != NULL && sampler->refined != NULL && sampler->deviations != NULL);
+	
+	for (sampler->drawnSize = 2; sampler->drawnSize < 2 * sampler->budget; sampler->drawnSize *= 2)
+	{
+	}
+	sampler->drawn = malloc (sampler->drawnSize * sizeof (*sampler->drawn));
+	assert (sampler->drawn != NULL);
+	
+	/* The drawn configurations are the same for every vector size */
+	sampler->rng = sampler->seed;
+	memset (sampler->drawn, 0, sampler->drawnSize * sizeof (*sampler->drawn));
+	if (sampler->budget == sampler->nbConfigurations)
+	{
+		uint64_t point;
+		
+		for (point = 0; point < sampler->nbConfigurations; point++)
+		{
+			Sampler_append (sampler, point);
+		}
+	}
+	else if (sampler->mode == SAMPLER_RANDOM)
+	{
+		Sampler_drawRandom (sampler, sampler->budget);
+	}
+	else if (sampler->mode == SAMPLER_LHS)
+	{
+		Sampler_drawLatinHypercube (sampler, sampler->budget);
+	}
+	else
+	{
+		Sampler_drawLatinHypercube (sampler, (sampler->budget + 1) / 2);
+	}
+	sampler->nbBase = sampler->nbPoints;
+	
+	return sampler;
+}
+
+void Sampler_destroy (SSampler *sampler)
+{
+	if (sampler != NULL)
+	{
+		free (sampler->nbLevels), sampler->nbLevels = NULL;
+		free (sampler->start), sampler->start = NULL;
+		free (sampler->step), sampler->step = NULL;
+		free (sampler->points), sampler->points = NULL;
+		free (sampler->timings), sampler->timings = NULL;
+		free (sampler->refined), sampler->refined = NULL;
+		free (sampler->deviations), sampler->deviations = NULL;
+		free (sampler->drawn), sampler->drawn = NULL;
+		free (sampler), sampler = NULL;
+	}
+}
+
+void Sampler_restart (SSampler *sampler)
+{
+	unsigned i;
+	
+	assert (sampler != NULL);
+	
+	/* The refinements of the previous vector size are forgotten, the generator restarts after the base draws */
+	sampler->nbPoints = sampler->nbBase;
+	sampler->nbScored = 0;
+	sampler->position = 0;
+	sampler->rng = sampler->seed + sampler->nbBase;
+	memset (sampler->drawn, 0, sampler->drawnSize * sizeof (*sampler->drawn));
+	
+	for (i = 0; i < sampler->nbBase; i++)
+	{
+		Sampler_insert (sampler, sampler->points[i]);
+		sampler->timings[i] = NAN;
+		sampler->refined[i] = 0;
+	}
+}
+
+void Sampler_seek (SSampler *sampler, unsigned position)
+{
+	assert (sampler != NULL);
+	
+	if (position > sampler->budget)
+	{
+		position = sampler->budget;
+	}
+	
+	/* The refinements of the interrupted run are not known, their slots are kept to measure the same number of configurations */
+	while (sampler->nbPoints < position)
+	{
+		sampler->points[sampler->nbPoints] = SAMPLER_UNKNOWN;
+		sampler->timings[sampler->nbPoints] = NAN;
+		sampler->refined[sampler->nbPoints] = 1;
+		sampler->nbPoints++;
+	}
+	sampler->position = position;
+}
+
+unsigned Sampler_getPosition (const SSampler *sampler)
+{
+	assert (sampler != NULL);
+	return sampler->position;
+}
+
+void Sampler_getConfiguration (const SSampler *sampler, unsigned idx, int *state)
+{
+	uint64_t point;
+	int d;
+	
+	assert (idx < sampler->nbPoints && sampler->points[idx] != SAMPLER_UNKNOWN);
+	
+	point = sampler->points[idx];
+	for (d = sampler->nbVectors - 1; d >= 0; d--)
+	{
+		state[d] = sampler->start[d] + (int) (point % sampler->nbLevels[d]) * sampler->step[d];
+		point /= sampler->nbLevels[d];
+	}
+}
+
+int Sampler_next (SSampler *sampler, int *state)
+{
+	assert (sampler != NULL);
+	
+	if (sampler->position >= sampler->budget)
+	{
+		return -1;
+	}
+	
+	if (sampler->position >= sampler->nbPoints)
+	{
+		Sampler_refine (sampler);
+	}
+	
+	Sampler_getConfiguration (sampler, sampler->position, state);
+	sampler->position++;
+	return 0;
+}
+
+void Sampler_record (SSampler *sampler, double value)
+{
+	assert (sampler != NULL && sampler->position > 0);
+	sampler->timings[sampler->position - 1] = value;
+}
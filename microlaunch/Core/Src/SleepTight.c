@@ -6,7 +6,7 @@
 #include "Log.h"
 #include "SleepTight.h"
 
-static int should_sleep = 0;
+static volatile sig_atomic_t should_sleep = 0;
 
 
 static void sig_handler (int no)
@@ -51,6 +51,11 @@ void escape_from_scary_killers ()
 }
 
 
+int escape_requested ()
+{
+	return should_sleep == 2;
+}
+
 int sleep_tight ()
 {
 	int res = 0;
@@ -0,0 +1,290 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Statistics.h"
+
+/* 97.5% quantile of the normal law, used for the 95% confidence interval of large samples */
+#define STATISTICS_Z_95 1.96
+
+/* 97.5% quantile of the Student law, indexed by the degrees of freedom minus one (samples minus two) */
+static const double statisticsStudent95[] =
+{
+	12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+	2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+	2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+/* Bootstrap parameters: the seed is fixed so that the summaries can be reproduced */
+#define STATISTICS_BOOTSTRAP_RESAMPLES 1000
+#define STATISTICS_BOOTSTRAP_SEED 0x9E3779B97F4A7C15ULL
+
+static int Statistics_compareDouble (const void *a, const void *b)
+{
+	double da = *(const double *) a;
+	double db = *(const double *) b;
+
+	return (da > db) - (da < db);
+}
+
+/**
+ * @brief Median of an already sorted sample
+ */
+static inline double Statistics_sortedMedian (const double *sorted, unsigned n)
+{
+	if (n % 2 == 1)
+	{
+		return sorted[n / 2];
+	}
+	return (sorted[n / 2 - 1] + sorted[n / 2]) / 2.;
+}
+
+/**
+ * @brief Percentile of an already sorted sample
+ */
+static inline double Statistics_sortedPercentile (const double *sorted, unsigned n, double percent)
+{
+	double rank = percent / 100. * (n - 1);
+	unsigned below = (unsigned) rank;
+	
+	if (below + 1 >= n)
+	{
+		return sorted[n - 1];
+	}
+	return sorted[below] + (rank - below) * (sorted[below + 1] - sorted[below]);
+}
+
+/**
+ * @brief xorshift64* generator, the C library one is left untouched
+ */
+static inline uint64_t Statistics_random (uint64_t *state)
+{
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * 2685821657736338717ULL;
+}
+
+static inline double *Statistics_sortedCopy (const double *values, unsigned n)
+{
+	double *sorted = malloc (n * sizeof (*sorted));
+	
+	assert (sorted != NULL);
+	memcpy (sorted, values, n * sizeof (*sorted));
+	qsort (sorted, n, sizeof (*sorted), Statistics_compareDouble);
+	
+	return sorted;
+}
+
+double Statistics_mean (const double *values, unsigned n)
+{
+	double sum = 0.;
+	unsigned i;
+
+	if (n == 0)
+	{
+		return 0.;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		sum += values[i];
+	}
+
+	return sum / n;
+}
+
+double Statistics_stddev (const double *values, unsigned n)
+{
+	double mean, sum = 0.;
+	unsigned i;
+
+	if (n < 2)
+	{
+		return 0.;
+	}
+
+	mean = Statistics_mean (values, n);
+	for (i = 0; i < n; i++)
+	{
+		sum += (values[i] - mean) * (values[i] - mean);
+	}
+
+	return sqrt (sum / (n - 1));
+}
+
+double Statistics_median (const double *values, unsigned n)
+{
+	double *sorted;
+	double res;
+
+	if (n == 0)
+	{
+		return 0.;
+	}
+
+	sorted = Statistics_sortedCopy (values, n);
+	res = Statistics_sortedMedian (sorted, n);
+
+	free (sorted), sorted = NULL;
+	return res;
+}
+
+double Statistics_percentile (const double *values, unsigned n, double percent)
+{
+	double *sorted;
+	double res;
+
+	if (n == 0)
+	{
+		return 0.;
+	}
+
+	sorted = Statistics_sortedCopy (values, n);
+	res = Statistics_sortedPercentile (sorted, n, percent);
+
+	free (sorted), sorted = NULL;
+	return res;
+}
+
+double Statistics_mad (const double *values, unsigned n)
+{
+	double *deviations;
+	double median, res;
+	unsigned i;
+
+	if (n == 0)
+	{
+		return 0.;
+	}
+
+	median = Statistics_median (values, n);
+
+	deviations = malloc (n * sizeof (*deviations));
+	assert (deviations != NULL);
+	for (i = 0; i < n; i++)
+	{
+		deviations[i] = fabs (values[i] - median);
+	}
+
+	res = Statistics_median (deviations, n);
+
+	free (deviations), deviations = NULL;
+	return res;
+}
+
+double Statistics_relativePrecision (const double *values, unsigned n, EAdaptiveCriterion criterion)
+{
+	double center, quantile;
+
+	if (n < 2)
+	{
+		return -1.;
+	}
+
+	switch (criterion)
+	{
+		case ADAPTIVE_MAD:
+			center = Statistics_median (values, n);
+			if (center == 0.)
+			{
+				return -1.;
+			}
+			return Statistics_mad (values, n) / fabs (center);
+		case ADAPTIVE_CI:
+		default:
+			center = Statistics_mean (values, n);
+			if (center == 0.)
+			{
+				return -1.;
+			}
+			/* The standard deviation is estimated from the sample: the Student law holds for the small ones */
+			quantile = (n - 2 < sizeof (statisticsStudent95) / sizeof (*statisticsStudent95)) ? statisticsStudent95[n - 2] : STATISTICS_Z_95;
+			return quantile * Statistics_stddev (values, n) / sqrt (n) / fabs (center);
+	}
+}
+
+void Statistics_bootstrapMedian (const double *values, unsigned n, double confidence, double *low, double *high)
+{
+	double *medians, *resample;
+	uint64_t state = STATISTICS_BOOTSTRAP_SEED;
+	unsigned b, i;
+
+	assert (low != NULL && high != NULL);
+
+	if (n == 0)
+	{
+		*low = *high = 0.;
+		return;
+	}
+
+	medians = malloc (STATISTICS_BOOTSTRAP_RESAMPLES * sizeof (*medians));
+	resample = malloc (n * sizeof (*resample));
+	assert (medians != NULL && resample != NULL);
+
+	for (b = 0; b < STATISTICS_BOOTSTRAP_RESAMPLES; b++)
+	{
+		for (i = 0; i < n; i++)
+		{
+			resample[i] = values[Statistics_random (&state) % n];
+		}
+		qsort (resample, n, sizeof (*resample), Statistics_compareDouble);
+		medians[b] = Statistics_sortedMedian (resample, n);
+	}
+
+	qsort (medians, STATISTICS_BOOTSTRAP_RESAMPLES, sizeof (*medians), Statistics_compareDouble);
+	*low = Statistics_sortedPercentile (medians, STATISTICS_BOOTSTRAP_RESAMPLES, (1. - confidence) / 2. * 100.);
+	*high = Statistics_sortedPercentile (medians, STATISTICS_BOOTSTRAP_RESAMPLES, (1. + confidence) / 2. * 100.);
+
+	free (resample), resample = NULL;
+	free (medians), medians = NULL;
+}
+
+void Statistics_summarize (const double *values, unsigned n, SStatisticsSummary *summary)
+{
+	double *sorted;
+
+	assert (summary != NULL);
+	memset (summary, 0, sizeof (*summary));
+	summary->n = n;
+
+	if (n == 0)
+	{
+		return;
+	}
+
+	sorted = Statistics_sortedCopy (values, n);
+	summary->min = sorted[0];
+	summary->p5 = Statistics_sortedPercentile (sorted, n, 5.);
+	summary->p25 = Statistics_sortedPercentile (sorted, n, 25.);
+	summary->median = Statistics_sortedMedian (sorted, n);
+	summary->p75 = Statistics_sortedPercentile (sorted, n, 75.);
+	summary->p95 = Statistics_sortedPercentile (sorted, n, 95.);
+	summary->max = sorted[n - 1];
+	free (sorted), sorted = NULL;
+
+	summary->mean = Statistics_mean (values, n);
+	summary->stddev = Statistics_stddev (values, n);
+	summary->mad = Statistics_mad (values, n);
+	Statistics_bootstrapMedian (values, n, 0.95, &summary->medianLow, &summary->medianHigh);
+}
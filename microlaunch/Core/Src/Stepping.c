@@ -0,0 +1,308 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Description.h"
+#include "Stepping.h"
+
+/**
+ * @brief A measured vector size
+ */
+typedef struct sSteppingPoint
+{
+	int size;		/**< @brief The vector size */
+	double measure;	/**< @brief Mean of its measures (NAN if not measured) */
+} SSteppingPoint;
+
+/**
+ * @brief Gives the size following another one in the geometric progression, on the --stepvector grid and at least one step further
+ */
+static int Stepping_following (int size, double ratio, int start, int step)
+{
+	double target = ceil ((size * ratio - start) / step);
+	int next = start + (int) target * step;
+	
+	return (next > size) ? next : size + step;
+}
+
+/**
+ * @brief Gives the number of sizes of the geometric progression
+ */
+static unsigned Stepping_getNbGeometric (struct sDescription *desc)
+{
+	int start = Description_getStartVectorSize (desc);
+	int end = Description_getEndVectorSize (desc);
+	int step = Description_getVectorSizeStep (desc);
+	double ratio = Description_getVectorRatio (desc);
+	unsigned res = 0;
+	int size;
+	
+	for (size = start; size <= end; size = Stepping_following (size, ratio, start, step))
+	{
+		res++;
+	}
+	return res;
+}
+
+unsigned Stepping_getNbSizes (struct sDescription *desc)
+{
+	unsigned nbLinear = ((Description_getEndVectorSize (desc) - Description_getStartVectorSize (desc)) / Description_getVectorSizeStep (desc)) + 1;
+	unsigned nbPoints;
+	
+	switch (Description_getVectorStepping (desc))
+	{
+		case STEPPING_GEOMETRIC:
+			return Stepping_getNbGeometric (desc);
+		case STEPPING_ADAPTIVE:
+			/* By default, the bisections double the progression; there cannot be more sizes than the linear ones */
+			nbPoints = Description_getVectorPoints (desc);
+			if (Description_getVectorPoints (desc) == DEFAULT_VECTOR_POINTS)
+			{
+				nbPoints = 2 * Stepping_getNbGeometric (desc);
+			}
+			if (nbPoints < Stepping_getNbGeometric (desc))
+			{
+				nbPoints = Stepping_getNbGeometric (desc);
+			}
+			return (nbPoints < nbLinear) ? nbPoints : nbLinear;
+		default:
+			return nbLinear;
+	}
+}
+
+int Stepping_getSize (struct sDescription *desc, unsigned idx)
+{
+	int start = Description_getStartVectorSize (desc);
+	int step = Description_getVectorSizeStep (desc);
+	double ratio = Description_getVectorRatio (desc);
+	int size = start;
+	
+	assert (Description_getVectorStepping (desc) != STEPPING_ADAPTIVE);
+	
+	if (Description_getVectorStepping (desc) == STEPPING_LINEAR)
+	{
+		return start + idx * step;
+	}
+	
+	for ( ; idx > 0; idx--)
+	{
+		size = Stepping_following (size, ratio, start, step);
+	}
+	return size;
+}
+
+SStepping *Stepping_create (struct sDescription *desc)
+{
+	SStepping *stepping;
+	double ratio = Description_getVectorRatio (desc);
+	int size;
+	
+	if (Description_getVectorStepping (desc) == STEPPING_LINEAR)
+	{
+		return NULL;
+	}
+	
+	stepping = malloc (sizeof (*stepping));
+	assert (stepping != NULL);
+	memset (stepping, 0, sizeof (*stepping));
+	
+	stepping->mode = Description_getVectorStepping (desc);
+	stepping->start = Description_getStartVectorSize (desc);
+	stepping->end = Description_getEndVectorSize (desc);
+	stepping->step = Description_getVectorSizeStep (desc);
+	stepping->threshold = Description_getVectorThreshold (desc);
+	stepping->budget = Stepping_getNbSizes (desc);
+	
+	stepping->sizes = malloc (stepping->budget * sizeof (*stepping->sizes));
+	stepping->sums = malloc (stepping->budget * sizeof (*stepping->sums));
+	stepping->counts = malloc (stepping->budget * sizeof (*stepping->counts));
+	assert (stepping->sizes != NULL && stepping->sums != NULL && stepping->counts != NULL);
+	
+	for (size = stepping->start; size <= stepping->end && stepping->nbBase < stepping->budget; size = Stepping_following (size, ratio, stepping->start, stepping->step))
+	{
+		stepping->sizes[stepping->nbBase] = size;
+		stepping->nbBase++;
+	}
+	
+	Stepping_restart (stepping);
+	return stepping;
+}
+
+void Stepping_destroy (SStepping *stepping)
+{
+	if (stepping != NULL)
+	{
+		free (stepping->sizes), stepping->sizes = NULL;
+		free (stepping->sums), stepping->sums = NULL;
+		free (stepping->counts), stepping->counts = NULL;
+		free (stepping), stepping = NULL;
+	}
+}
+
+void Stepping_restart (SStepping *stepping)
+{
+	assert (stepping != NULL);
+	
+	stepping->nbPoints = stepping->nbBase;
+	stepping->position = 0;
+	memset (stepping->sums, 0, stepping->budget * sizeof (*stepping->sums));
+	memset (stepping->counts, 0, stepping->budget * sizeof (*stepping->counts));
+}
+
+void Stepping_seek (SStepping *stepping, unsigned position, int size)
+{
+	assert (stepping != NULL);
+	
+	if (position >= stepping->budget)
+	{
+		stepping->position = stepping->budget;
+		return;
+	}
+	
+	/* The bisections of the interrupted run are not known, their slots are kept to measure the same number of sizes */
+	while (stepping->nbPoints < position)
+	{
+		stepping->sizes[stepping->nbPoints] = STEPPING_UNKNOWN;
+		stepping->nbPoints++;
+	}
+	
+	/* The interrupted size is measured again */
+	if (stepping->nbPoints == position)
+	{
+		stepping->sizes[stepping->nbPoints] = size;
+		stepping->nbPoints++;
+	}
+	stepping->position = position;
+}
+
+unsigned Stepping_getPosition (const SStepping *stepping)
+{
+	assert (stepping != NULL);
+	return stepping->position;
+}
+
+static int Stepping_comparePoints (const void *a, const void *b)
+{
+	const SSteppingPoint *pa = a, *pb = b;
+	
+	return (pa->size > pb->size) - (pa->size < pb->size);
+}
+
+/**
+ * @brief Adaptive mode: bisects the interval whose bounds differ the most, or the widest one if no difference is above the threshold
+ */
+static void Stepping_refine (SStepping *stepping)
+{
+	SSteppingPoint *points = malloc (stepping->nbPoints * sizeof (*points));
+	unsigned i, n = 0;
+	double best = -1, difference, width;
+	int a, b, mid, bestLow = -1, bestHigh = -1;
+	int isAboveThreshold = 0;
+	
+	assert (points != NULL);
+	
+	for (i = 0; i < stepping->nbPoints; i++)
+	{
+		if (stepping->sizes[i] != STEPPING_UNKNOWN)
+		{
+			points[n].size = stepping->sizes[i];
+			points[n].measure = (stepping->counts[i] != 0) ? stepping->sums[i] / stepping->counts[i] : NAN;
+			n++;
+		}
+	}
+	qsort (points, n, sizeof (*points), Stepping_comparePoints);
+	
+	for (i = 0; i + 1 < n; i++)
+	{
+		a = points[i].size;
+		b = points[i + 1].size;
+		
+		/* Consecutive sizes of the --stepvector grid cannot be bisected */
+		if (b - a <= stepping->step)
+		{
+			continue;
+		}
+		
+		difference = fabs (points[i + 1].measure - points[i].measure) / fmin (fabs (points[i].measure), fabs (points[i + 1].measure));
+		width = (double) b / (a > 0 ? a : 1);
+		
+		if (!isnan (difference) && difference > stepping->threshold)
+		{
+			if (!isAboveThreshold || difference > best)
+			{
+				best = difference, bestLow = a, bestHigh = b;
+			}
+			isAboveThreshold = 1;
+		}
+		else if (!isAboveThreshold && width > best)
+		{
+			best = width, bestLow = a, bestHigh = b;
+		}
+	}
+	free (points), points = NULL;
+	
+	/* Only when the sizes lost with an interruption took the rest of the budget: the last size is measured again */
+	if (bestLow == -1)
+	{
+		stepping->sizes[stepping->nbPoints] = stepping->sizes[stepping->nbPoints - 1];
+		stepping->nbPoints++;
+		return;
+	}
+	
+	/* The geometric middle, on the --stepvector grid */
+	mid = stepping->start + (int) round ((sqrt ((double) bestLow * bestHigh) - stepping->start) / stepping->step) * stepping->step;
+	if (mid <= bestLow)
+	{
+		mid = bestLow + stepping->step;
+	}
+	if (mid >= bestHigh)
+	{
+		mid = bestHigh - stepping->step;
+	}
+	
+	stepping->sizes[stepping->nbPoints] = mid;
+	stepping->nbPoints++;
+}
+
+int Stepping_next (SStepping *stepping)
+{
+	assert (stepping != NULL);
+	
+	if (stepping->position >= stepping->budget)
+	{
+		return -1;
+	}
+	
+	if (stepping->position >= stepping->nbPoints)
+	{
+		Stepping_refine (stepping);
+	}
+	
+	return stepping->sizes[stepping->position++];
+}
+
+void Stepping_record (SStepping *stepping, double value)
+{
+	assert (stepping != NULL && stepping->position > 0);
+	stepping->sums[stepping->position - 1] += value;
+	stepping->counts[stepping->position - 1]++;
+}
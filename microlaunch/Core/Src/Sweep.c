@@ -0,0 +1,241 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#define _GNU_SOURCE
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "Description.h"
+#include "Sampler.h"
+#include "Stepping.h"
+#include "Sweep.h"
+#include "Topology.h"
+
+#define SWEEP_RANGE(head, tail) (((uint64_t) (tail) << 32) | (uint32_t) (head))
+#define SWEEP_HEAD(range) ((uint32_t) ((range) & 0xffffffff))
+#define SWEEP_TAIL(range) ((uint32_t) ((range) >> 32))
+
+static inline size_t Sweep_size (unsigned nbWorkers)
+{
+	return sizeof (SSweep) + nbWorkers * sizeof (SSweepDeque);
+}
+
+SSweep *Sweep_create (unsigned nbWorkers, unsigned nbPoints)
+{
+	SSweep *sweep;
+	
+	assert (nbWorkers > 0);
+	
+	sweep = mmap (NULL, Sweep_size (nbWorkers), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (sweep == MAP_FAILED)
+	{
+		perror ("Error: sweep queue mapping");
+		exit (EXIT_FAILURE);
+	}
+	
+	memset (sweep, 0, Sweep_size (nbWorkers));
+	sweep->nbWorkers = nbWorkers;
+	Sweep_reset (sweep, nbPoints);
+	
+	return sweep;
+}
+
+void Sweep_destroy (SSweep *sweep)
+{
+	if (sweep != NULL)
+	{
+		munmap (sweep, Sweep_size (sweep->nbWorkers));
+	}
+}
+
+void Sweep_reset (SSweep *sweep, unsigned nbPoints)
+{
+	unsigned i, head, tail;
+	
+	assert (sweep != NULL);
+	
+	sweep->nbPoints = nbPoints;
+	
+	/* Neighbouring points share their vector size: contiguous chunks keep a worker on one size as long as possible */
+	for (i = 0; i < sweep->nbWorkers; i++)
+	{
+		head = (unsigned) (((uint64_t) nbPoints * i) / sweep->nbWorkers);
+		tail = (unsigned) (((uint64_t) nbPoints * (i + 1)) / sweep->nbWorkers);
+		sweep->deques[i].range = SWEEP_RANGE (head, tail);
+	}
+	__sync_synchronize ();
+}
+
+/**
+ * @brief Steals the second half of the points left to the most loaded worker
+ * @return the first stolen point, the others are put in the deque of the thief, -1 if no point is left
+ */
+static int Sweep_steal (SSweep *sweep, unsigned worker)
+{
+	uint64_t range, bestRange, own;
+	uint32_t head, tail, left, bestLeft, taken;
+	unsigned victim, best;
+	
+	while (1)
+	{
+		best = sweep->nbWorkers;
+		bestLeft = 0;
+		bestRange = 0;
+		
+		for (victim = 0; victim < sweep->nbWorkers; victim++)
+		{
+			range = sweep->deques[victim].range;
+			head = SWEEP_HEAD (range);
+			tail = SWEEP_TAIL (range);
+			left = (tail > head) ? tail - head : 0;
+			
+			if (victim != worker && left > bestLeft)
+			{
+				best = victim;
+				bestLeft = left;
+				bestRange = range;
+			}
+		}
+		
+		if (best == sweep->nbWorkers)
+		{
+			return -1;
+		}
+		
+		/* The whole state of a deque is its range word: a successful exchange always takes points that are still there */
+		head = SWEEP_HEAD (bestRange);
+		tail = SWEEP_TAIL (bestRange);
+		taken = (bestLeft + 1) / 2;
+		
+		if (__sync_bool_compare_and_swap (&sweep->deques[best].range, bestRange, SWEEP_RANGE (head, tail - taken)))
+		{
+			/* The deque of the thief is empty, thieves leave it alone: only its owner writes it */
+			do
+			{
+				own = sweep->deques[worker].range;
+			}
+			while (!__sync_bool_compare_and_swap (&sweep->deques[worker].range, own, SWEEP_RANGE (tail - taken + 1, tail)));
+			
+			return tail - taken;
+		}
+	}
+}
+
+int Sweep_take (SSweep *sweep, unsigned worker)
+{
+	uint64_t range;
+	uint32_t head, tail;
+	
+	assert (sweep != NULL && worker < sweep->nbWorkers);
+	
+	/* The owner takes from the head, the thieves from the tail */
+	while (1)
+	{
+		range = sweep->deques[worker].range;
+		head = SWEEP_HEAD (range);
+		tail = SWEEP_TAIL (range);
+		
+		if (head >= tail)
+		{
+			return Sweep_steal (sweep, worker);
+		}
+		
+		if (__sync_bool_compare_and_swap (&sweep->deques[worker].range, range, SWEEP_RANGE (head + 1, tail)))
+		{
+			return head;
+		}
+	}
+}
+
+unsigned Sweep_getNbPoints (SDescription *desc)
+{
+	/* Every alignment configuration, or the sampled ones, for each vector size */
+	return (unsigned) (Stepping_getNbSizes (desc) * Sampler_getNbSamples (desc));
+}
+
+int Sweep_decode (SDescription *desc, unsigned point, int *state)
+{
+	int nbVectors = Description_getNbVectors (desc);
+	SSampler *sampler = Description_getSampler (desc);
+	unsigned nbAlignments;
+	int *vect;
+	int i;
+	
+	/* Sampled alignments: the same drawn configurations for each vector size */
+	if (sampler != NULL)
+	{
+		Sampler_getConfiguration (sampler, point % sampler->budget, state);
+		return Stepping_getSize (desc, point / sampler->budget);
+	}
+	
+	/* The last vector varies fastest, then the vector size is the slowest */
+	for (i = nbVectors - 1; i >= 0; i--)
+	{
+		vect = Description_getVector (desc, i);
+		if (vect == NULL)
+		{
+			continue;
+		}
+		
+		nbAlignments = Sampler_getNbLevels (vect);
+		state[i] = vect[VSTART] + (point % nbAlignments) * (vect[VSTEP] != 0 ? vect[VSTEP] : 1);
+		point /= nbAlignments;
+	}
+	
+	return Stepping_getSize (desc, point);
+}
+
+int Sweep_getCpus (int isolation, int *cpus, int max)
+{
+	cpu_set_t used, shared;
+	int nb, i, kept;
+	
+	if (isolation == SWEEP_ISOLATION_CPU)
+	{
+		return Topology_orderCpus (TOPOLOGY_PIN_LINEAR, -1, cpus, max);
+	}
+	
+	nb = Topology_orderCpus (TOPOLOGY_PIN_PHYSICAL, -1, cpus, max);
+	if (isolation != SWEEP_ISOLATION_L2)
+	{
+		return nb;
+	}
+	
+	/* Keeps the first core of each L2, an unknown L2 is considered private */
+	CPU_ZERO (&used);
+	for (i = 0, kept = 0; i < nb; i++)
+	{
+		if (CPU_ISSET (cpus[i], &used))
+		{
+			continue;
+		}
+		
+		if (Topology_getCacheSharing (cpus[i], 2, &shared) == 0)
+		{
+			CPU_OR (&used, &used, &shared);
+		}
+		CPU_SET (cpus[i], &used);
+		cpus[kept++] = cpus[i];
+	}
+	
+	return kept;
+}
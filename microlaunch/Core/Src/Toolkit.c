@@ -15,6 +15,7 @@ You should have received a copy of the GNU General Public License
 along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
+#define _GNU_SOURCE
 #include <assert.h>
 #include <unistd.h>
 #include <sys/types.h>
@@ -24,50 +25,28 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <limits.h>
 #include <errno.h>
 
+#include "Barrier.h"
+#include "CompileCache.h"
 #include "Defines.h"
 #include "Description.h"
+#include "Driver.h"
 #include "Log.h"
 #include "SleepTight.h"
 #include "Toolkit.h"
+#include "Topology.h"
 
 int 
 getCacheSize (void)
 {
-    int res;
-    char buf[] = "grep 'cache size' /proc/cpuinfo | awk -F : '{print $2}' |awk -F \" \" '{print $1}'";
-    char *ptr, *end;
-    int status;
-    char buffer[STRBUF_MAXLEN];
-    
-    FILE *output = popen(buf, "r");
-    if(output == NULL)
-    {
-		Log_output (-1, "%s\n", buf);
-    	perror ("Error: Opening cache size system call :");
-        exit (EXIT_FAILURE);
-    }
-    
-	ptr = fgets (buffer, sizeof (buffer), output);
+    size_t size = Topology_getCacheSize (0);
     
-    assert (ptr != NULL);
-    status = pclose(output);
-    
-    if (status == -1)
+    if (size == 0)
     {
-		Log_output (-1, "%s\n", buf);
-    	perror ("Error: Closing cache size system call :");
+    	Log_output (-1, "Error: In getCacheSize function the last level cache size is unknown.\n");
     	exit (EXIT_FAILURE);
     }
     
-    res = strtol (buffer, &end, 10);
-    
-    if (buffer == end)
-    {
-    	Log_output (-1, "Error: In getCacheSize function strtol call failed.\n");
-    	exit (EXIT_FAILURE);
-    }
-    
-    return res;
+    return size / 1024;
 }
 
 /**@todo Check triplet_splitter and parse_vect_surveyor */
@@ -329,11 +308,17 @@ int getMemorySpaceToAllocated(SDescription *desc)
 	return memorySpace;
 }
 
-/**
- * @todo find the purpose of the argument "desc"...
-**/
-void barrierS (int pipeSF[2], int pipeFS[2])
+void barrierS (SDescription *desc)
 {
+	int *pipeSF = Description_getTubeSF (desc);
+	int *pipeFS = Description_getTubeFS (desc);
+	
+	if (Description_getBarrier (desc) != NULL)
+	{
+		Barrier_child (Description_getBarrier (desc), Description_getProcessId (desc));
+		return;
+	}
+	
 	/* Tell the father I'm ready to go */
 	Pipe_childWrite (pipeSF, getpid ());
 	
@@ -341,10 +326,16 @@ void barrierS (int pipeSF[2], int pipeFS[2])
 	Pipe_childRead (pipeFS, NULL);
 }
 
-void barrierF (SPipe *pipes, unsigned nbprocess)
+void barrierF (SDescription *desc, SPipe *pipes, unsigned nbprocess)
 {
 	unsigned i;
 	
+	if (Description_getBarrier (desc) != NULL)
+	{
+		Barrier_father (Description_getBarrier (desc));
+		return;
+	}
+	
 	/* Read nbprocess times from the child processes */
 	for (i = 0; i < nbprocess ; i++)
 	{
@@ -365,42 +356,95 @@ void barrierF (SPipe *pipes, unsigned nbprocess)
 
 int getNbProcessorsAvailable ( void )
 {
-	FILE *output;
-	long nbProcessorsAvailable;
-	char buf[3]; /* Max processors = 999 */
-	char cmd[] = "grep \"CPU\" /proc/cpuinfo | wc -l";
-	int status;
-	char *ptr, *end;
+	return Topology_getNbAvailableCpus ();
+}
+
+void exportThreadPinning (SDescription *desc)
+{
+	static const char *policyNames[] = {"linear", "compact", "scatter", "physical", "socket", "list"};
+	int policy = Description_getPinPolicy (desc);
+	int isOpenMP = Description_getOmpPath (desc) != NULL;
+	const STopology *topo = Topology_get ();
+	int *cpus = malloc (TOPOLOGY_MAX_CPUS * sizeof (*cpus));
+	char *list, *places, *gomp, *map;
+	size_t size;
+	int nb, i;
+	
+	assert (cpus != NULL);
+	
+	/* The linear policy is the default placement of the thread pinning library */
+	if (policy == TOPOLOGY_PIN_LINEAR)
+	{
+		free (cpus), cpus = NULL;
+		return;
+	}
 	
-	output = popen (cmd, "r");
+	if (policy == TOPOLOGY_PIN_LIST)
+	{
+		if (Description_getPinList (desc) == NULL)
+		{
+			Log_output (-1, "Error: The list pinning policy has no processor list\n");
+			exit (EXIT_FAILURE);
+		}
+		nb = Topology_parseCpuOrder (Description_getPinList (desc), cpus, TOPOLOGY_MAX_CPUS);
+	}
+	else
+	{
+		nb = Topology_orderCpus (policy, Description_getCPUDest (desc), cpus, TOPOLOGY_MAX_CPUS);
+	}
 	
-	if (output == NULL)
+	if (nb <= 0)
 	{
-		Log_output (-1, "%s\n", cmd);
-		perror ("Error: Getting processors number : ");
+		Log_output (-1, "Error: No processor available for the %s pinning policy\n", policyNames[policy]);
 		exit (EXIT_FAILURE);
 	}
 	
-    ptr = fgets (buf, sizeof (buf), output);
-    assert(ptr != NULL);
-    
-    status = pclose(output);
-    
-    if (status == -1)
-    {
-		Log_output (-1, "%s\n", buf);
-    	perror ("Error: Closing processors number system call :");
-    	exit (EXIT_FAILURE);
-    }
-    
-    nbProcessorsAvailable = strtol (buf, &end, 10);
-    if (buf == end)
-    {
-    	Log_output (-1, "Error: in getNbProcessorsAvailable strtol call failed.\n");
-    	exit (EXIT_FAILURE);
-    }
-    
-    return nbProcessorsAvailable;
+	/* At most 4 digits and 6 separator characters per processor */
+	size = nb * 16 + 1;
+	list = malloc (size);
+	places = malloc (size);
+	gomp = malloc (size);
+	map = malloc (size);
+	assert (list != NULL && places != NULL && gomp != NULL && map != NULL);
+	list[0] = places[0] = gomp[0] = map[0] = '\0';
+	
+	for (i = 0; i < nb; i++)
+	{
+		if (cpus[i] >= TOPOLOGY_MAX_CPUS || !CPU_ISSET (cpus[i], &topo->available))
+		{
+			Log_output (-1, "Warning: Processor %d of the pinning policy is not available\n", cpus[i]);
+		}
+		
+		snprintf (list + strlen (list), size - strlen (list), "%s%d", (i == 0) ? "" : ",", cpus[i]);
+		snprintf (places + strlen (places), size - strlen (places), "%s{%d}", (i == 0) ? "" : ",", cpus[i]);
+		snprintf (gomp + strlen (gomp), size - strlen (gomp), "%s%d", (i == 0) ? "" : " ", cpus[i]);
+		snprintf (map + strlen (map), size - strlen (map), "%s%d->%d", (i == 0) ? "" : ", ", i, cpus[i]);
+	}
+	
+	if (setenv (TOPOLOGY_ENV_PIN_CPUS, list, 1) == -1)
+	{
+		perror ("Error while setting the " TOPOLOGY_ENV_PIN_CPUS " environment variable");
+		exit (EXIT_FAILURE);
+	}
+	
+	/* The OpenMP runtime binds its threads itself, the first place being the master thread */
+	if (isOpenMP)
+	{
+		if (setenv ("OMP_PLACES", places, 1) == -1 || setenv ("OMP_PROC_BIND", "true", 1) == -1 || setenv ("GOMP_CPU_AFFINITY", gomp, 1) == -1)
+		{
+			perror ("Error while setting the OpenMP affinity environment variables");
+			exit (EXIT_FAILURE);
+		}
+		Log_output (5, "Info: OMP_PLACES=%s OMP_PROC_BIND=true GOMP_CPU_AFFINITY=\"%s\"\n", places, gomp);
+	}
+	
+	Log_output (5, "Info: Thread pinning policy %s, thread -> processor (round-robin beyond): %s\n", policyNames[policy], map);
+	
+	free (map), map = NULL;
+	free (gomp), gomp = NULL;
+	free (places), places = NULL;
+	free (list), list = NULL;
+	free (cpus), cpus = NULL;
 }
 
 int isUserRoot()
@@ -734,16 +778,180 @@ void freeArgs ( unsigned argc, char **argv )
 	free (argv), argv = NULL;
 }
 
+/**
+ * @brief Runs a compilation command and exits if it fails
+ * @param command the command
+ * @param fileName the compiled file, for the error messages
+ * @param output the file produced by the command, removed if it fails
+ * @param generated a generated source compiled by the command, always removed (can be NULL)
+ */
+static void runCompilation (const char *command, const char *fileName, const char *output, const char *generated)
+{
+	char buf[STRBUF_MAXLEN];
+	unsigned w_size;
+	int res;
+	
+	/* GCC compilation system call */
+	res = system (command);
+	
+	if (generated != NULL)
+	{
+		remove (generated);
+	}
+	
+	/* Checking compilation errors */
+	if (res != EXIT_SUCCESS)
+	{
+		remove (output);
+		
+		if (WIFSIGNALED (res))
+		{
+			w_size = snprintf (buf, sizeof (buf), "Benchmark \"%s\" compilation error :", fileName);
+			assert (w_size < sizeof (buf));
+			psignal (WTERMSIG (res), buf);
+		}
+		
+		if (WEXITSTATUS (res) == EXIT_FAILURE)
+		{
+			Log_output (-1, "Error: \"%s\" compilation failed.\n", fileName);
+		}
+		exit (EXIT_FAILURE);
+	}
+}
+
+/**
+ * @brief Compiles a kernel or an executable source, through the compilation cache when it is enabled
+ * @param desc the program description
+ * @param fileName the source
+ * @param isKernel whether the source is compiled as a kernel shared library or as an executable
+ * @param name filled with the compiled file name
+ * @param size the size of name
+ * @return 1 if the compiled file belongs to the cache (it must not be deleted), 0 otherwise
+ */
+static int compileFile (SDescription *desc, const char *fileName, int isKernel, char *name, size_t size)
+{
+	char flags[STRBUF_MAXLEN], key[STRBUF_MAXLEN], target[STRBUF_MAXLEN], buf[STRBUF_MAXLEN];
+	char driver[] = "/tmp/microdriverXXXXXX.c";
+	char tag[STRBUF_MAXLEN] = "";
+	char *ompPath = Description_getOmpPath (desc);
+	int isFused = 0;
+	int cached = -1;
+	unsigned w_size;
+	int res;
+	
+	w_size = snprintf (flags, sizeof (flags), "%s-O3 -Wall -Wextra%s",
+						(ompPath != NULL) ? "-fopenmp " : "", isKernel ? " -fPIC -shared" : "");
+	assert (w_size < sizeof (flags));
+	
+	/* The driver holding the repetition loop is linked in the kernel library, the call to the kernel is bound locally */
+	if (isKernel && Description_isFusedDriverEnabled (desc))
+	{
+		res = mkstemps (driver, 2);
+		if (res != -1)
+		{
+			close (res); /* Because mkstemps opens the file and we don't need it */
+			isFused = (Driver_generate (desc, driver, tag, sizeof (tag)) == 0);
+			if (!isFused)
+			{
+				remove (driver);
+			}
+		}
+		
+		if (isFused)
+		{
+			w_size = snprintf (buf, sizeof (buf), "%s -I%s/Core/Include -Wl,-Bsymbolic", flags, MLDIR);
+			assert (w_size < sizeof (buf));
+			strcpy (flags, buf);
+		}
+	}
+	
+	w_size = snprintf (key, sizeof (key), "%s%s%s", flags, isFused ? " " : "", tag);
+	assert (w_size < sizeof (key));
+	
+	if (Description_isCompileCacheEnabled (desc))
+	{
+		cached = CompileCache_lookup (fileName, key, ompPath, isKernel ? ".so" : ".bin", name, size);
+		
+		if (cached == 1)
+		{
+			if (isFused)
+			{
+				remove (driver);
+			}
+			Log_output (-1, "Reusing the cached compilation of \"%s\" :\n%s\n", fileName, name);
+			return 1;
+		}
+		
+		if (cached == 0 && CompileCache_createTemporary (name, target, sizeof (target)) != 0)
+		{
+			cached = -1;
+		}
+	}
+	
+	if (cached != 0)
+	{
+		// Ok I hate doing this but here we must
+		w_size = snprintf (target, sizeof (target), "/tmp/microXXXXXX");
+		assert (w_size < sizeof (target));
+		res = mkstemp (target);
+		if (res == -1)
+		{
+			perror ("Error: Cannot create temporary file for compilation ");
+			exit (EXIT_FAILURE);
+		}
+		close (res); /* Because mkstemp opens the file and we don't need it */
+		
+		w_size = snprintf (name, size, "%s", target);
+		assert (w_size < size);
+	}
+	
+	if (isKernel)
+	{
+		if (ompPath != NULL)
+		{
+			w_size = snprintf (buf, sizeof (buf), "%s %s -Wl,-soname,%s -o %s %s %s %s/libgomp.so.1",
+								COMPILECACHE_COMPILER, flags, name, target, fileName, isFused ? driver : "", ompPath);
+		}
+		else
+		{
+			w_size = snprintf (buf, sizeof (buf), "%s %s -Wl,-soname,%s -o %s %s %s",
+								COMPILECACHE_COMPILER, flags, name, target, fileName, isFused ? driver : "");
+		}
+	}
+	else
+	{
+		w_size = snprintf (buf, sizeof (buf), "%s %s -o %s %s",
+							COMPILECACHE_COMPILER, fileName, target, flags);
+	}
+	assert (w_size < sizeof (buf));
+	
+	Log_output (-1, "Compiling in %s mode :\n%s\n", (ompPath != NULL) ? "OpenMP" : "Normal", buf);
+	
+	runCompilation (buf, fileName, target, isFused ? driver : NULL);
+	
+	if (cached == 0)
+	{
+		if (CompileCache_commit (target, name) == 0)
+		{
+			return 1;
+		}
+		
+		/* The entry could not be published, compile again out of the cache */
+		Description_compileCacheDisable (desc);
+		return compileFile (desc, fileName, isKernel, name, size);
+	}
+	
+	return 0;
+}
+
 void compileInputFile (SDescription *desc)
 {
 	assert (desc != NULL);
 	const Source_type sc = Description_getSourceType (desc);
     char *kernelName = Description_getKernelFileName (desc);
     char *execName = Description_getExecFileName (desc);
-    unsigned w_size;
-	char buf[STRBUF_MAXLEN];
-    char name[] = "/tmp/microXXXXXX";
-    int res;
+    char name[STRBUF_MAXLEN];
+    int cached;
     
     /* EXECUTION MODE */
     if (execName != NULL && sc == EXECUTABLE_FILE)
@@ -751,49 +959,9 @@ void compileInputFile (SDescription *desc)
     	/* If it is a executable source, then let's compile it */
     	if (strstr (execName, ".c"))
     	{
-        	res = mkstemp (name);
-		    if (res == -1)
-		    {
-		    	perror ("Error: Cannot create temporary file for compilation ");
-		    	exit (EXIT_FAILURE);
-		    }
-        	close (res); /* Because mkstemp opens the file and we don't need it */
-        	
-        	if (desc->ompPath != NULL) /* OMP Mode */
-		    {
-		    	w_size = snprintf (buf, sizeof (buf), "gcc %s -o %s -fopenmp -O3 -Wall -Wextra",
-								execName, name);
-		   		Log_output (-1, "Compiling in OpenMP mode :\n%s\n", buf);
-		    }
-		    else /* NORMAL Mode */
-		    {
-		    	w_size = snprintf (buf, sizeof (buf), "gcc %s -o %s -O3 -Wall -Wextra",
-								execName, name);
-		   		Log_output (-1, "Compiling in Normal mode :\n%s\n", buf);
-		    }
-		    assert (w_size < sizeof (buf));
-
-			/* GCC compilation system call */
-		    res = system (buf);
+    		compileFile (desc, execName, 0, name, sizeof (name));
 		    
-        	/* Checking compilation errors */
-		    if (res != EXIT_SUCCESS)
-		    {
-		    	if (WIFSIGNALED (res))
-		    	{
-		    		w_size = snprintf (buf, sizeof (buf), "Benchmark \"%s\" compilation error :", execName);
-		   			assert (w_size < sizeof (buf));
-		    		psignal (WTERMSIG (res), buf);
-		    	}
-		    	
-		    	if (WEXITSTATUS (res) == EXIT_FAILURE)
-		    	{
-		    		Log_output (-1, "Error: \"%s\" compilation failed.\n", execName);
-		    	}
-		    	exit (EXIT_FAILURE);
-		    }
-		    
-		    /* Replace the existing .c file by the tmp executable filename */
+		    /* Replace the existing .c file by the executable filename */
 			Description_setExecFileName (desc, name);
     	}
     	return;
@@ -802,50 +970,10 @@ void compileInputFile (SDescription *desc)
 	/* KERNEL MODE */
 	if (kernelName != NULL && (sc == SOURCE_FILE || sc == ASSEMBLY_FILE || sc == OBJECT_FILE))
     {
-        // Ok I hate doing this but here we must
-        res = mkstemp (name);
-        if (res == -1)
-        {
-        	perror ("Error: Cannot create temporary file for compilation ");
-        	exit (EXIT_FAILURE);
-        }
-        close (res); /* Because mkstemp opens the file and we don't need it */
-		
-        if (desc->ompPath != NULL) /* OMP Mode */
-        {
-        	w_size = snprintf (buf, sizeof (buf), "gcc -fopenmp -fPIC -O3 -Wall -Wextra -shared -Wl,-soname,%s -o %s %s %s/libgomp.so.1",
-                                    name, name, kernelName, desc->ompPath);
-       		Log_output (-1, "Compiling in OpenMP mode :\n%s\n", buf);
-        }
-        else /* NORMAL Mode */
-        {
-        	w_size = snprintf (buf, sizeof (buf), "gcc -fPIC -O3 -Wall -Wextra -shared -Wl,-soname,%s -o %s %s",
-                                    name, name, kernelName);
-       		Log_output (-1, "Compiling in Normal mode :\n%s\n", buf);
-        }
-        assert (w_size < sizeof (buf));
-
-		/* GCC compilation system call */
-        res = system (buf);
-        
-        /* Checking compilation errors */
-        if (res != EXIT_SUCCESS)
-        {
-        	if (WIFSIGNALED (res))
-        	{
-        		w_size = snprintf (buf, sizeof (buf), "Benchmark \"%s\" compilation error :", kernelName);
-        		assert (w_size < sizeof (buf));
-        		psignal (WTERMSIG (res), buf);
-        	}
-        	
-        	if (WEXITSTATUS (res) == EXIT_FAILURE)
-        	{
-        		Log_output (-1, "Error: \"%s\" compilation failed.\n", kernelName);
-        	}
-        	exit (EXIT_FAILURE);
-        }
-
-        Description_setDynamicLibraryName (desc, name, 1);
+    	cached = compileFile (desc, kernelName, 1, name, sizeof (name));
+    	
+    	/* The cache entries are kept for the next launches */
+        Description_setDynamicLibraryName (desc, name, !cached);
     }
 }
 
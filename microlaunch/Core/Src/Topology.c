@@ -0,0 +1,635 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/*
+ * This file only depends on the C library: it is also linked in the thread pinning library.
+ */
+
+#define _GNU_SOURCE
+#include <cpuid.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Topology.h"
+
+#define TOPOLOGY_SYSFS_CPU "/sys/devices/system/cpu"
+#define TOPOLOGY_SYSFS_NODE "/sys/devices/system/node"
+#define TOPOLOGY_BUF_LEN 4096
+
+static STopology topology;
+static pthread_once_t topologyOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Reads the first line of a file
+ * @return 0 on success, -1 if the file cannot be read
+ */
+static int Topology_readLine (const char *path, char *buf, size_t size)
+{
+	FILE *f = fopen (path, "r");
+	char *end;
+	
+	if (f == NULL)
+	{
+		return -1;
+	}
+	
+	if (fgets (buf, size, f) == NULL)
+	{
+		fclose (f);
+		return -1;
+	}
+	fclose (f);
+	
+	if ((end = strchr (buf, '\n')) != NULL)
+	{
+		*end = '\0';
+	}
+	return 0;
+}
+
+static int Topology_readInt (const char *path, int defaultValue)
+{
+	char buf[64];
+	
+	if (Topology_readLine (path, buf, sizeof (buf)) == -1)
+	{
+		return defaultValue;
+	}
+	return atoi (buf);
+}
+
+int Topology_parseCpuList (const char *list, cpu_set_t *set)
+{
+	char *end;
+	long first, last, cpu;
+	
+	CPU_ZERO (set);
+	
+	while (*list != '\0' && *list != '\n')
+	{
+		first = strtol (list, &end, 10);
+		if (end == list || first < 0)
+		{
+			return -1;
+		}
+		last = first;
+		list = end;
+		
+		if (*list == '-')
+		{
+			last = strtol (list + 1, &end, 10);
+			if (end == list + 1)
+			{
+				return -1;
+			}
+			list = end;
+		}
+		
+		for (cpu = first; cpu <= last && cpu < TOPOLOGY_MAX_CPUS; cpu++)
+		{
+			CPU_SET (cpu, set);
+		}
+		
+		if (*list == ',')
+		{
+			list++;
+		}
+	}
+	
+	return CPU_COUNT (set);
+}
+
+int Topology_parseCpuOrder (const char *list, int *cpus, int max)
+{
+	char *end;
+	long first, last, cpu;
+	int nb = 0;
+	
+	while (*list != '\0' && *list != '\n')
+	{
+		first = strtol (list, &end, 10);
+		if (end == list || first < 0 || first >= TOPOLOGY_MAX_CPUS)
+		{
+			return -1;
+		}
+		last = first;
+		list = end;
+		
+		if (*list == '-')
+		{
+			last = strtol (list + 1, &end, 10);
+			if (end == list + 1 || last >= TOPOLOGY_MAX_CPUS)
+			{
+				return -1;
+			}
+			list = end;
+		}
+		
+		for (cpu = first; cpu <= last && nb < max; cpu++)
+		{
+			cpus[nb++] = cpu;
+		}
+		
+		if (*list == ',')
+		{
+			list++;
+		}
+		else if (*list != '\0' && *list != '\n')
+		{
+			return -1;
+		}
+	}
+	
+	return nb;
+}
+
+/**
+ * @brief Reads the processors allowed by the cpuset cgroup of the process (v2, then v1)
+ * @return 0 if they were found, -1 otherwise
+ */
+static int Topology_readCpuset (cpu_set_t *set)
+{
+	char line[TOPOLOGY_BUF_LEN], path[TOPOLOGY_BUF_LEN], buf[TOPOLOGY_BUF_LEN];
+	char *controllers, *cgroup;
+	FILE *f = fopen ("/proc/self/cgroup", "r");
+	int res = -1;
+	
+	if (f == NULL)
+	{
+		return -1;
+	}
+	
+	/* Lines are "hierarchy:controllers:path" */
+	while (res == -1 && fgets (line, sizeof (line), f) != NULL)
+	{
+		line[strcspn (line, "\n")] = '\0';
+		
+		controllers = strchr (line, ':');
+		if (controllers == NULL || (cgroup = strchr (controllers + 1, ':')) == NULL)
+		{
+			continue;
+		}
+		*cgroup++ = '\0';
+		controllers++;
+		
+		if (*controllers == '\0')
+		{
+			snprintf (path, sizeof (path), "/sys/fs/cgroup%s/cpuset.cpus.effective", cgroup);
+		}
+		else if (strstr (controllers, "cpuset") != NULL)
+		{
+			snprintf (path, sizeof (path), "/sys/fs/cgroup/cpuset%s/cpuset.effective_cpus", cgroup);
+			if (Topology_readLine (path, buf, sizeof (buf)) == -1)
+			{
+				snprintf (path, sizeof (path), "/sys/fs/cgroup/cpuset%s/cpuset.cpus", cgroup);
+			}
+		}
+		else
+		{
+			continue;
+		}
+		
+		if (Topology_readLine (path, buf, sizeof (buf)) == 0 && Topology_parseCpuList (buf, set) > 0)
+		{
+			res = 0;
+		}
+	}
+	
+	fclose (f);
+	return res;
+}
+
+/**
+ * @brief Reads the caches of a processor from sysfs
+ */
+static void Topology_readCaches (int cpu)
+{
+	char path[TOPOLOGY_BUF_LEN], buf[TOPOLOGY_BUF_LEN];
+	STopologyCache *cache;
+	char *end;
+	int index;
+	
+	for (index = 0; topology.nbCaches < TOPOLOGY_MAX_CACHES; index++)
+	{
+		cache = &topology.caches[topology.nbCaches];
+		memset (cache, 0, sizeof (*cache));
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/cache/index%d/level", cpu, index);
+		if ((cache->level = Topology_readInt (path, -1)) == -1)
+		{
+			break;
+		}
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/cache/index%d/type", cpu, index);
+		if (Topology_readLine (path, buf, sizeof (buf)) == -1)
+		{
+			buf[0] = '\0';
+		}
+		
+		if (strcmp (buf, "Data") == 0)
+		{
+			cache->type = TOPOLOGY_CACHE_DATA;
+		}
+		else if (strcmp (buf, "Instruction") == 0)
+		{
+			cache->type = TOPOLOGY_CACHE_INSTRUCTION;
+		}
+		else
+		{
+			cache->type = TOPOLOGY_CACHE_UNIFIED;
+		}
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/cache/index%d/size", cpu, index);
+		if (Topology_readLine (path, buf, sizeof (buf)) == 0)
+		{
+			cache->size = strtoul (buf, &end, 10);
+			if (*end == 'K')
+			{
+				cache->size *= 1024;
+			}
+			else if (*end == 'M')
+			{
+				cache->size *= 1024 * 1024;
+			}
+		}
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/cache/index%d/coherency_line_size", cpu, index);
+		cache->lineSize = Topology_readInt (path, 0);
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/cache/index%d/ways_of_associativity", cpu, index);
+		cache->ways = Topology_readInt (path, 0);
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+		if (Topology_readLine (path, buf, sizeof (buf)) == -1 || Topology_parseCpuList (buf, &cache->sharedWith) == -1)
+		{
+			CPU_ZERO (&cache->sharedWith);
+		}
+		
+		topology.nbCaches++;
+	}
+}
+
+/**
+ * @brief Reads the caches from cpuid leaf 4 when sysfs does not describe them
+ */
+static void Topology_readCachesCpuid (void)
+{
+	unsigned eax, ebx, ecx, edx, index, type;
+	STopologyCache *cache;
+	
+	for (index = 0; topology.nbCaches < TOPOLOGY_MAX_CACHES; index++)
+	{
+		if (!__get_cpuid_count (4, index, &eax, &ebx, &ecx, &edx) || (type = eax & 0x1f) == 0)
+		{
+			break;
+		}
+		
+		cache = &topology.caches[topology.nbCaches];
+		memset (cache, 0, sizeof (*cache));
+		cache->level = (eax >> 5) & 0x7;
+		cache->type = (type == 1) ? TOPOLOGY_CACHE_DATA : (type == 2) ? TOPOLOGY_CACHE_INSTRUCTION : TOPOLOGY_CACHE_UNIFIED;
+		cache->lineSize = (ebx & 0xfff) + 1;
+		cache->ways = ((ebx >> 22) & 0x3ff) + 1;
+		cache->size = (size_t) cache->ways * (((ebx >> 12) & 0x3ff) + 1) * cache->lineSize * (ecx + 1);
+		
+		topology.nbCaches++;
+	}
+}
+
+static void Topology_read (void)
+{
+	char path[TOPOLOGY_BUF_LEN], buf[TOPOLOGY_BUF_LEN];
+	cpu_set_t online, cpuset, nodes, nodeCpus;
+	unsigned eax, ebx, ecx, edx;
+	int cpu, node;
+	
+	memset (&topology, 0, sizeof (topology));
+	
+	/* Without sysfs, every processor the process can run on is online */
+	if (Topology_readLine (TOPOLOGY_SYSFS_CPU "/online", buf, sizeof (buf)) == -1 || Topology_parseCpuList (buf, &online) <= 0)
+	{
+		if (sched_getaffinity (0, sizeof (online), &online) == -1)
+		{
+			CPU_ZERO (&online);
+			CPU_SET (0, &online);
+		}
+	}
+	
+	if (sched_getaffinity (0, sizeof (topology.affinity), &topology.affinity) == -1)
+	{
+		topology.affinity = online;
+	}
+	
+	topology.available = online;
+	if (Topology_readCpuset (&cpuset) == 0)
+	{
+		CPU_AND (&topology.available, &online, &cpuset);
+	}
+	topology.nbAvailable = CPU_COUNT (&topology.available);
+	topology.nbOnline = CPU_COUNT (&online);
+	
+	for (cpu = 0; cpu < TOPOLOGY_MAX_CPUS; cpu++)
+	{
+		STopologyCpu *desc = &topology.cpus[cpu];
+		
+		desc->node = -1;
+		if (!CPU_ISSET (cpu, &online))
+		{
+			continue;
+		}
+		
+		desc->online = 1;
+		topology.nbCpus = cpu + 1;
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/topology/core_id", cpu);
+		desc->core = Topology_readInt (path, cpu);
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/topology/physical_package_id", cpu);
+		desc->package = Topology_readInt (path, 0);
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/topology/thread_siblings_list", cpu);
+		if (Topology_readLine (path, buf, sizeof (buf)) == -1 || Topology_parseCpuList (buf, &desc->siblings) <= 0)
+		{
+			CPU_ZERO (&desc->siblings);
+			CPU_SET (cpu, &desc->siblings);
+		}
+	}
+	
+	/* NUMA nodes (the node list has the same syntax as the processor one): a single one without NUMA support */
+	if (Topology_readLine (TOPOLOGY_SYSFS_NODE "/online", buf, sizeof (buf)) == -1 || Topology_parseCpuList (buf, &nodes) <= 0)
+	{
+		CPU_ZERO (&nodes);
+	}
+	
+	for (node = 0; node < TOPOLOGY_MAX_CPUS; node++)
+	{
+		if (!CPU_ISSET (node, &nodes))
+		{
+			continue;
+		}
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_NODE "/node%d/cpulist", node);
+		if (Topology_readLine (path, buf, sizeof (buf)) == -1 || Topology_parseCpuList (buf, &nodeCpus) == -1)
+		{
+			continue;
+		}
+		
+		topology.nbNodes++;
+		for (cpu = 0; cpu < topology.nbCpus; cpu++)
+		{
+			if (CPU_ISSET (cpu, &nodeCpus))
+			{
+				topology.cpus[cpu].node = node;
+			}
+		}
+	}
+	if (topology.nbNodes == 0)
+	{
+		topology.nbNodes = 1;
+		for (cpu = 0; cpu < topology.nbCpus; cpu++)
+		{
+			topology.cpus[cpu].node = 0;
+		}
+	}
+	
+	/* The caches of the first processor the benchmarks can use */
+	for (cpu = 0; cpu < topology.nbCpus && !CPU_ISSET (cpu, &topology.available); cpu++)
+	{
+	}
+	Topology_readCaches ((cpu < topology.nbCpus) ? cpu : 0);
+	if (topology.nbCaches == 0)
+	{
+		Topology_readCachesCpuid ();
+	}
+	
+	/* CPUID.1:EBX[15:8] is the clflush line size, in 8 octet chunks */
+	if (__get_cpuid (1, &eax, &ebx, &ecx, &edx) && ((ebx >> 8) & 0xff) != 0)
+	{
+		topology.lineSize = ((ebx >> 8) & 0xff) * 8;
+	}
+	else
+	{
+		topology.lineSize = (topology.nbCaches != 0 && topology.caches[0].lineSize != 0) ? topology.caches[0].lineSize : 64;
+	}
+}
+
+/**
+ * @brief Sort key of a processor, the smallest keys are used first
+ */
+typedef struct sTopologyPinKey
+{
+	int keys[3];
+	int cpu;
+} STopologyPinKey;
+
+static int Topology_comparePinKeys (const void *a, const void *b)
+{
+	const STopologyPinKey *ka = a, *kb = b;
+	int i;
+	
+	for (i = 0; i < 3; i++)
+	{
+		if (ka->keys[i] != kb->keys[i])
+		{
+			return (ka->keys[i] > kb->keys[i]) - (ka->keys[i] < kb->keys[i]);
+		}
+	}
+	return (ka->cpu > kb->cpu) - (ka->cpu < kb->cpu);
+}
+
+int Topology_orderCpus (ETopologyPinPolicy policy, int anchor, int *cpus, int max)
+{
+	const STopology *topo = Topology_get ();
+	STopologyPinKey *keys = malloc (TOPOLOGY_MAX_CPUS * sizeof (*keys));
+	int cpu, sibling, nb = 0, i;
+	
+	if (keys == NULL)
+	{
+		return 0;
+	}
+	
+	for (cpu = 0; cpu < topo->nbCpus; cpu++)
+	{
+		const STopologyCpu *desc = &topo->cpus[cpu];
+		int siblingRank = 0;
+		
+		if (!CPU_ISSET (cpu, &topo->available))
+		{
+			continue;
+		}
+		
+		/* Rank among the available SMT siblings of the core */
+		for (sibling = 0; sibling < cpu; sibling++)
+		{
+			if (CPU_ISSET (sibling, &desc->siblings) && CPU_ISSET (sibling, &topo->available))
+			{
+				siblingRank++;
+			}
+		}
+		
+		keys[nb].cpu = cpu;
+		keys[nb].keys[0] = keys[nb].keys[1] = keys[nb].keys[2] = 0;
+		
+		switch (policy)
+		{
+			case TOPOLOGY_PIN_SCATTER:
+				keys[nb].keys[0] = siblingRank;
+				keys[nb].keys[1] = desc->core;
+				keys[nb].keys[2] = desc->package;
+				break;
+			case TOPOLOGY_PIN_PHYSICAL:
+				if (siblingRank != 0)
+				{
+					continue;
+				}
+				keys[nb].keys[0] = desc->package;
+				keys[nb].keys[1] = desc->core;
+				break;
+			case TOPOLOGY_PIN_SOCKET:
+				if (anchor >= 0 && anchor < topo->nbCpus && desc->package != topo->cpus[anchor].package)
+				{
+					continue;
+				}
+				/* Falls through - compact order inside the package */
+			case TOPOLOGY_PIN_COMPACT:
+				keys[nb].keys[0] = desc->package;
+				keys[nb].keys[1] = desc->core;
+				keys[nb].keys[2] = siblingRank;
+				break;
+			case TOPOLOGY_PIN_LINEAR:
+			case TOPOLOGY_PIN_LIST:
+			default:
+				break;
+		}
+		nb++;
+	}
+	
+	qsort (keys, nb, sizeof (*keys), Topology_comparePinKeys);
+	
+	for (i = 0; i < nb && i < max; i++)
+	{
+		cpus[i] = keys[i].cpu;
+	}
+	
+	free (keys), keys = NULL;
+	return i;
+}
+
+const STopology *Topology_get (void)
+{
+	pthread_once (&topologyOnce, Topology_read);
+	return &topology;
+}
+
+int Topology_getNbAvailableCpus (void)
+{
+	return Topology_get ()->nbAvailable;
+}
+
+int Topology_getAvailableCpu (int idx)
+{
+	const STopology *topo = Topology_get ();
+	int cpu;
+	
+	if (topo->nbAvailable == 0)
+	{
+		return 0;
+	}
+	
+	idx %= topo->nbAvailable;
+	for (cpu = 0; cpu < topo->nbCpus; cpu++)
+	{
+		if (CPU_ISSET (cpu, &topo->available) && idx-- == 0)
+		{
+			return cpu;
+		}
+	}
+	
+	return 0;
+}
+
+const STopologyCache *Topology_getCache (int level)
+{
+	const STopology *topo = Topology_get ();
+	const STopologyCache *res = NULL;
+	int i;
+	
+	for (i = 0; i < topo->nbCaches; i++)
+	{
+		const STopologyCache *cache = &topo->caches[i];
+		
+		if (cache->type == TOPOLOGY_CACHE_INSTRUCTION)
+		{
+			continue;
+		}
+		
+		if (cache->level == level || (level == 0 && (res == NULL || cache->level > res->level)))
+		{
+			res = cache;
+			if (level != 0)
+			{
+				break;
+			}
+		}
+	}
+	
+	return res;
+}
+
+size_t Topology_getCacheSize (int level)
+{
+	const STopologyCache *cache = Topology_getCache (level);
+	
+	return (cache != NULL) ? cache->size : 0;
+}
+
+int Topology_getCacheSharing (int cpu, int level, cpu_set_t *set)
+{
+	char path[TOPOLOGY_BUF_LEN], buf[TOPOLOGY_BUF_LEN];
+	int index, cacheLevel;
+	
+	for (index = 0; ; index++)
+	{
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/cache/index%d/level", cpu, index);
+		if ((cacheLevel = Topology_readInt (path, -1)) == -1)
+		{
+			break;
+		}
+		
+		if (cacheLevel != level)
+		{
+			continue;
+		}
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/cache/index%d/type", cpu, index);
+		if (Topology_readLine (path, buf, sizeof (buf)) == 0 && strcmp (buf, "Instruction") == 0)
+		{
+			continue;
+		}
+		
+		snprintf (path, sizeof (path), TOPOLOGY_SYSFS_CPU "/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+		if (Topology_readLine (path, buf, sizeof (buf)) == 0 && Topology_parseCpuList (buf, set) > 0)
+		{
+			return 0;
+		}
+		break;
+	}
+	
+	CPU_ZERO (set);
+	return -1;
+}
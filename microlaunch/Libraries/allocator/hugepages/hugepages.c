@@ -0,0 +1,253 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "hugepages.h"
+
+#ifndef MAP_HUGE_SHIFT
+	#define MAP_HUGE_SHIFT 26
+#endif
+
+#ifndef MADV_HUGEPAGE
+	#define MADV_HUGEPAGE 14
+#endif
+
+/**
+ * @brief A mapping handed out by allocationMalloc
+ */
+typedef struct sHugeMapping
+{
+	char *base;			/**< @brief Start of the mapping */
+	size_t length;		/**< @brief Length of the mapping */
+	char *vector;		/**< @brief Pointer given to microlaunch (base + alignment) */
+} SHugeMapping;
+
+static size_t hugePageSize = HUGEPAGES_2M;
+static int transparentOnly = 0;
+
+static SHugeMapping *mappings = NULL;
+static unsigned nbMappings = 0, maxMappings = 0;
+
+/* Page size obtained by each vector the last time it was allocated (0 if never) */
+static size_t reportedPageSize[HUGEPAGES_MAX_VECTORS];
+
+static inline size_t hugepages_roundUp (size_t value, size_t unit)
+{
+	return (value + unit - 1) / unit * unit;
+}
+
+static inline int hugepages_log2 (size_t value)
+{
+	int res = 0;
+	
+	while (value > 1)
+	{
+		value >>= 1;
+		res++;
+	}
+	return res;
+}
+
+/**
+ * @brief Size of the pages backing a transparent huge page mapping, read from /proc/self/smaps once it is touched
+ */
+static size_t hugepages_transparentPageSize (char *base, size_t length)
+{
+	FILE *smaps = fopen ("/proc/self/smaps", "r");
+	char line[256];
+	unsigned long start, end, kb;
+	int inMapping = 0;
+	size_t res = getpagesize ();
+	
+	if (smaps == NULL)
+	{
+		return res;
+	}
+	
+	while (fgets (line, sizeof (line), smaps) != NULL)
+	{
+		if (sscanf (line, "%lx-%lx ", &start, &end) == 2)
+		{
+			inMapping = (start <= (unsigned long) base && (unsigned long) base < end);
+		}
+		else if (inMapping && sscanf (line, "AnonHugePages: %lu kB", &kb) == 1)
+		{
+			/* Only reported as huge if the whole vector is */
+			if (kb * 1024 >= length)
+			{
+				res = HUGEPAGES_2M;
+			}
+			break;
+		}
+	}
+	
+	fclose (smaps);
+	return res;
+}
+
+static void hugepages_report (int no, size_t size, size_t pageSize, int transparent)
+{
+	if (no < 0 || no >= HUGEPAGES_MAX_VECTORS || reportedPageSize[no] == pageSize)
+	{
+		return;
+	}
+	
+	reportedPageSize[no] = pageSize;
+	fprintf (stderr, "hugepages: vector #%d (%lu bytes) backed by %lu kB %s\n", no, (unsigned long) size,
+			(unsigned long) pageSize / 1024, transparent ? "pages (transparent huge pages)" : "pages (hugetlbfs)");
+}
+
+static void hugepages_record (char *base, size_t length, char *vector)
+{
+	if (nbMappings == maxMappings)
+	{
+		maxMappings = (maxMappings == 0) ? 16 : maxMappings * 2;
+		mappings = realloc (mappings, maxMappings * sizeof (*mappings));
+		assert (mappings != NULL);
+	}
+	
+	mappings[nbMappings].base = base;
+	mappings[nbMappings].length = length;
+	mappings[nbMappings].vector = vector;
+	nbMappings++;
+}
+
+int allocationInit (void *ptr)
+{
+	char *env = getenv (HUGEPAGES_ENV);
+	
+	(void) ptr;
+	
+	hugePageSize = HUGEPAGES_2M;
+	transparentOnly = 0;
+	memset (reportedPageSize, 0, sizeof (reportedPageSize));
+	
+	if (env == NULL || strcmp (env, "2M") == 0)
+	{
+		return 0;
+	}
+	
+	if (strcmp (env, "1G") == 0)
+	{
+		hugePageSize = HUGEPAGES_1G;
+	}
+	else if (strcmp (env, "thp") == 0)
+	{
+		transparentOnly = 1;
+	}
+	else
+	{
+		fprintf (stderr, "hugepages: unknown page size \"%s\" in %s (expected 2M, 1G or thp)\n", env, HUGEPAGES_ENV);
+		return -1;
+	}
+	
+	return 0;
+}
+
+void *allocationMalloc (size_t size, int no, int requested_alignment)
+{
+	char *base = MAP_FAILED, *mapping;
+	size_t length, pageSize, offset;
+	int transparent = 0;
+	
+	if (size == 0 || requested_alignment < 0)
+	{
+		return NULL;
+	}
+	
+	/* hugetlbfs pages: the mapping is naturally aligned on the page size */
+	if (!transparentOnly)
+	{
+		length = hugepages_roundUp (size + requested_alignment, hugePageSize);
+		base = mmap (NULL, length, PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (hugepages_log2 (hugePageSize) << MAP_HUGE_SHIFT), -1, 0);
+		pageSize = hugePageSize;
+	}
+	
+	/* Transparent huge pages: over-allocate to align the vector on a 2M boundary ourselves */
+	if (base == MAP_FAILED)
+	{
+		transparent = 1;
+		length = hugepages_roundUp (size + requested_alignment, HUGEPAGES_2M);
+		mapping = mmap (NULL, length + HUGEPAGES_2M, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapping == MAP_FAILED)
+		{
+			perror ("hugepages: mmap");
+			return NULL;
+		}
+		
+		/* Give the unaligned head and tail back */
+		offset = hugepages_roundUp ((size_t) mapping, HUGEPAGES_2M) - (size_t) mapping;
+		base = mapping + offset;
+		if (offset > 0)
+		{
+			munmap (mapping, offset);
+		}
+		munmap (base + length, HUGEPAGES_2M - offset);
+		
+		madvise (base, length, MADV_HUGEPAGE);
+		
+		/* First touch, so that the kernel decides now */
+		for (offset = 0; offset < length; offset += getpagesize ())
+		{
+			base[offset] = 0;
+		}
+		pageSize = hugepages_transparentPageSize (base, length);
+	}
+	
+	hugepages_record (base, length, base + requested_alignment);
+	hugepages_report (no, size, pageSize, transparent);
+	
+	return base + requested_alignment;
+}
+
+void allocationFree (void *ptr)
+{
+	unsigned i;
+	
+	for (i = 0; i < nbMappings; i++)
+	{
+		if (mappings[i].vector == ptr)
+		{
+			munmap (mappings[i].base, mappings[i].length);
+			mappings[i] = mappings[nbMappings - 1];
+			nbMappings--;
+			return;
+		}
+	}
+}
+
+void allocationClose ()
+{
+	unsigned i;
+	
+	for (i = 0; i < nbMappings; i++)
+	{
+		munmap (mappings[i].base, mappings[i].length);
+	}
+	
+	free (mappings), mappings = NULL;
+	nbMappings = maxMappings = 0;
+}
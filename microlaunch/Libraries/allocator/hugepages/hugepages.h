@@ -0,0 +1,50 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef H_HUGEPAGES
+#define H_HUGEPAGES
+
+#include <stddef.h>
+
+/*
+ * Huge page allocation library: every vector gets its own mapping backed by huge pages,
+ * the requested alignment being the offset of the vector from the start of the mapping.
+ *
+ * The page size is read from the ML_HUGEPAGE_SIZE environment variable:
+ *	- "2M" (default) or "1G": hugetlbfs pages (MAP_HUGETLB), which have to be reserved
+ *	  beforehand (/proc/sys/vm/nr_hugepages or the hugepages kernel parameter);
+ *	  if none is left, the library falls back to transparent huge pages
+ *	- "thp": transparent huge pages only (madvise (MADV_HUGEPAGE) on a 2M aligned mapping)
+ *
+ * The page size actually obtained is printed on stderr for the first allocation of each
+ * vector and every time it changes.
+ */
+#define HUGEPAGES_ENV "ML_HUGEPAGE_SIZE"
+
+#define HUGEPAGES_2M (2UL << 20)
+#define HUGEPAGES_1G (1UL << 30)
+
+/* Number of vectors whose page size is followed for the report */
+#define HUGEPAGES_MAX_VECTORS 64
+
+int allocationInit (void *ptr);
+void *allocationMalloc (size_t size, int no, int requested_alignment);
+void allocationFree (void *ptr);
+void allocationClose ();
+
+#endif
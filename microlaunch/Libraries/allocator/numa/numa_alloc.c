@@ -0,0 +1,376 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <linux/mempolicy.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "numa_alloc.h"
+
+#define NUMA_ALLOC_MASK_WORDS (NUMA_ALLOC_MAX_NODES / (8 * sizeof (unsigned long)))
+
+/**
+ * @brief Placement asked for a vector
+ */
+typedef struct sNumaPolicy
+{
+	int mode;										/**< @brief MPOL_BIND, MPOL_INTERLEAVE or MPOL_DEFAULT */
+	unsigned long nodes[NUMA_ALLOC_MASK_WORDS];		/**< @brief Allowed nodes */
+} SNumaPolicy;
+
+/**
+ * @brief A mapping handed out by allocationMalloc
+ */
+typedef struct sNumaMapping
+{
+	char *base;			/**< @brief Start of the mapping */
+	size_t length;		/**< @brief Length of the mapping */
+	char *vector;		/**< @brief Pointer given to microlaunch (base + alignment) */
+} SNumaMapping;
+
+static SNumaPolicy policies[NUMA_ALLOC_MAX_VECTORS];
+static unsigned nbPolicies = 0;
+
+static SNumaMapping *mappings = NULL;
+static unsigned nbMappings = 0, maxMappings = 0;
+
+/* Last placement printed for each vector */
+static char reportedPlacement[NUMA_ALLOC_MAX_VECTORS][256];
+
+static inline void numa_setNode (unsigned long *mask, unsigned node)
+{
+	mask[node / (8 * sizeof (*mask))] |= 1UL << (node % (8 * sizeof (*mask)));
+}
+
+static inline int numa_isNodeSet (const unsigned long *mask, unsigned node)
+{
+	return (mask[node / (8 * sizeof (*mask))] >> (node % (8 * sizeof (*mask)))) & 1;
+}
+
+/**
+ * @brief Parses a node list ("0", "1,3", "0-3")
+ * @return 0 on success, -1 if the list is malformed or empty
+ */
+static int numa_parseNodes (const char *list, unsigned long *mask)
+{
+	char *end;
+	unsigned long first, last, node;
+	int found = 0;
+	
+	memset (mask, 0, NUMA_ALLOC_MASK_WORDS * sizeof (*mask));
+	
+	while (*list != '\0' && *list != '\n')
+	{
+		first = strtoul (list, &end, 10);
+		if (end == list)
+		{
+			return -1;
+		}
+		last = first;
+		list = end;
+		
+		if (*list == '-')
+		{
+			last = strtoul (list + 1, &end, 10);
+			if (end == list + 1)
+			{
+				return -1;
+			}
+			list = end;
+		}
+		
+		for (node = first; node <= last && node < NUMA_ALLOC_MAX_NODES; node++)
+		{
+			numa_setNode (mask, node);
+			found = 1;
+		}
+		
+		if (*list == ',')
+		{
+			list++;
+		}
+	}
+	
+	return found ? 0 : -1;
+}
+
+static int numa_onlineNodes (unsigned long *mask)
+{
+	char buf[256];
+	FILE *online = fopen ("/sys/devices/system/node/online", "r");
+	int res = -1;
+	
+	if (online != NULL)
+	{
+		if (fgets (buf, sizeof (buf), online) != NULL)
+		{
+			res = numa_parseNodes (buf, mask);
+		}
+		fclose (online);
+	}
+	
+	/* No NUMA support in the kernel: a single node */
+	if (res == -1)
+	{
+		memset (mask, 0, NUMA_ALLOC_MASK_WORDS * sizeof (*mask));
+		numa_setNode (mask, 0);
+	}
+	return 0;
+}
+
+static int numa_parsePolicy (const char *spec, SNumaPolicy *policy)
+{
+	memset (policy, 0, sizeof (*policy));
+	
+	if (strcmp (spec, "local") == 0)
+	{
+		policy->mode = MPOL_DEFAULT;
+		return 0;
+	}
+	
+	if (strcmp (spec, "interleave") == 0)
+	{
+		policy->mode = MPOL_INTERLEAVE;
+		return numa_onlineNodes (policy->nodes);
+	}
+	
+	if (strncmp (spec, "interleave:", strlen ("interleave:")) == 0)
+	{
+		policy->mode = MPOL_INTERLEAVE;
+		return numa_parseNodes (spec + strlen ("interleave:"), policy->nodes);
+	}
+	
+	if (strncmp (spec, "bind:", strlen ("bind:")) == 0)
+	{
+		spec += strlen ("bind:");
+	}
+	policy->mode = MPOL_BIND;
+	return numa_parseNodes (spec, policy->nodes);
+}
+
+/**
+ * @brief Checks where the pages of a vector are and prints it if it changed
+ */
+static void numa_verify (int no, char *base, size_t length, const SNumaPolicy *policy)
+{
+	size_t pageSize = getpagesize ();
+	size_t nbPages = length / pageSize;
+	size_t step = (nbPages + NUMA_ALLOC_VERIFIED_PAGES - 1) / NUMA_ALLOC_VERIFIED_PAGES;
+	void *pages[NUMA_ALLOC_VERIFIED_PAGES];
+	int status[NUMA_ALLOC_VERIFIED_PAGES];
+	unsigned perNode[NUMA_ALLOC_MAX_NODES];
+	char placement[sizeof (*reportedPlacement)];
+	unsigned long count = 0, misplaced = 0, i;
+	unsigned node, size;
+	
+	if (no < 0 || no >= NUMA_ALLOC_MAX_VECTORS)
+	{
+		return;
+	}
+	
+	for (i = 0; i < nbPages && count < NUMA_ALLOC_VERIFIED_PAGES; i += step)
+	{
+		pages[count++] = base + i * pageSize;
+	}
+	
+	/* move_pages without target nodes only reports the node of each page */
+	if (syscall (SYS_move_pages, 0, count, pages, NULL, status, 0) == -1)
+	{
+		perror ("numa: move_pages");
+		return;
+	}
+	
+	memset (perNode, 0, sizeof (perNode));
+	for (i = 0; i < count; i++)
+	{
+		if (status[i] < 0 || status[i] >= NUMA_ALLOC_MAX_NODES)
+		{
+			misplaced++;
+			continue;
+		}
+		perNode[status[i]]++;
+		if (policy->mode != MPOL_DEFAULT && !numa_isNodeSet (policy->nodes, status[i]))
+		{
+			misplaced++;
+		}
+	}
+	
+	size = 0;
+	for (node = 0; node < NUMA_ALLOC_MAX_NODES && size < sizeof (placement); node++)
+	{
+		if (perNode[node] != 0)
+		{
+			size += snprintf (placement + size, sizeof (placement) - size, "%snode %u: %lu%%", (size == 0) ? "" : ", ",
+								node, perNode[node] * 100UL / count);
+		}
+	}
+	if (misplaced != 0 && size < sizeof (placement))
+	{
+		snprintf (placement + size, sizeof (placement) - size, " (WARNING: %lu%% of the pages are not where they were asked)", misplaced * 100UL / count);
+	}
+	
+	if (strcmp (placement, reportedPlacement[no]) != 0)
+	{
+		strcpy (reportedPlacement[no], placement);
+		fprintf (stderr, "numa: vector #%d (%lu bytes): %s\n", no, (unsigned long) length, placement);
+	}
+}
+
+static void numa_record (char *base, size_t length, char *vector)
+{
+	if (nbMappings == maxMappings)
+	{
+		maxMappings = (maxMappings == 0) ? 16 : maxMappings * 2;
+		mappings = realloc (mappings, maxMappings * sizeof (*mappings));
+		assert (mappings != NULL);
+	}
+	
+	mappings[nbMappings].base = base;
+	mappings[nbMappings].length = length;
+	mappings[nbMappings].vector = vector;
+	nbMappings++;
+}
+
+int allocationInit (void *ptr)
+{
+	char *env = getenv (NUMA_ALLOC_ENV);
+	char *list, *spec, *save;
+	unsigned long online[NUMA_ALLOC_MASK_WORDS];
+	unsigned node;
+	
+	(void) ptr;
+	
+	memset (reportedPlacement, 0, sizeof (reportedPlacement));
+	nbPolicies = 0;
+	
+	if (env == NULL)
+	{
+		return 0;
+	}
+	
+	list = strdup (env);
+	assert (list != NULL);
+	numa_onlineNodes (online);
+	
+	for (spec = strtok_r (list, ";", &save); spec != NULL && nbPolicies < NUMA_ALLOC_MAX_VECTORS; spec = strtok_r (NULL, ";", &save))
+	{
+		if (numa_parsePolicy (spec, &policies[nbPolicies]) == -1)
+		{
+			fprintf (stderr, "numa: cannot parse the policy \"%s\" in %s\n", spec, NUMA_ALLOC_ENV);
+			free (list), list = NULL;
+			return -1;
+		}
+		
+		for (node = 0; node < NUMA_ALLOC_MAX_NODES; node++)
+		{
+			if (numa_isNodeSet (policies[nbPolicies].nodes, node) && !numa_isNodeSet (online, node))
+			{
+				fprintf (stderr, "numa: node %u asked by \"%s\" is not online\n", node, spec);
+				free (list), list = NULL;
+				return -1;
+			}
+		}
+		nbPolicies++;
+	}
+	
+	free (list), list = NULL;
+	return 0;
+}
+
+void *allocationMalloc (size_t size, int no, int requested_alignment)
+{
+	SNumaPolicy local = {MPOL_DEFAULT, {0}};
+	const SNumaPolicy *policy = &local;
+	size_t pageSize = getpagesize ();
+	size_t length, offset;
+	char *base;
+	
+	if (size == 0 || requested_alignment < 0)
+	{
+		return NULL;
+	}
+	
+	if (nbPolicies != 0)
+	{
+		policy = &policies[((unsigned) no < nbPolicies) ? (unsigned) no : nbPolicies - 1];
+	}
+	
+	length = (size + requested_alignment + pageSize - 1) / pageSize * pageSize;
+	base = mmap (NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED)
+	{
+		perror ("numa: mmap");
+		return NULL;
+	}
+	
+	/* Nothing is touched yet: the policy applies to every page */
+	if (policy->mode != MPOL_DEFAULT
+		&& syscall (SYS_mbind, base, length, policy->mode, policy->nodes, NUMA_ALLOC_MAX_NODES + 1, MPOL_MF_STRICT) == -1)
+	{
+		perror ("numa: mbind");
+		munmap (base, length);
+		return NULL;
+	}
+	
+	/* First touch from the benchmark process, which is pinned by now */
+	for (offset = 0; offset < length; offset += pageSize)
+	{
+		base[offset] = 0;
+	}
+	
+	numa_verify (no, base, length, policy);
+	numa_record (base, length, base + requested_alignment);
+	
+	return base + requested_alignment;
+}
+
+void allocationFree (void *ptr)
+{
+	unsigned i;
+	
+	for (i = 0; i < nbMappings; i++)
+	{
+		if (mappings[i].vector == ptr)
+		{
+			munmap (mappings[i].base, mappings[i].length);
+			mappings[i] = mappings[nbMappings - 1];
+			nbMappings--;
+			return;
+		}
+	}
+}
+
+void allocationClose ()
+{
+	unsigned i;
+	
+	for (i = 0; i < nbMappings; i++)
+	{
+		munmap (mappings[i].base, mappings[i].length);
+	}
+	
+	free (mappings), mappings = NULL;
+	nbMappings = maxMappings = 0;
+}
@@ -0,0 +1,54 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef H_NUMA_ALLOC
+#define H_NUMA_ALLOC
+
+#include <stddef.h>
+
+/*
+ * NUMA placement allocation library: every vector gets its own mapping, bound with mbind
+ * to the nodes asked for it, then touched by the benchmark process itself (which is already
+ * pinned when it allocates) and checked page by page with move_pages.
+ *
+ * The policies are read from the ML_NUMA_POLICY environment variable, one per vector,
+ * separated by ';' (the last one is used for the remaining vectors):
+ *	- "<nodes>" or "bind:<nodes>": the pages have to be on these nodes
+ *	- "interleave:<nodes>": the pages are spread over these nodes, round-robin
+ *	- "interleave": the pages are spread over every online node
+ *	- "local": no policy, the first touch decides (default)
+ * <nodes> is a list of node numbers and ranges, such as "0", "1,3" or "0-3".
+ * For instance, "0;1" puts the first vector on node 0 and the other ones on node 1.
+ *
+ * The placement found is printed on stderr for the first allocation of each vector and
+ * every time it changes.
+ */
+#define NUMA_ALLOC_ENV "ML_NUMA_POLICY"
+
+#define NUMA_ALLOC_MAX_NODES 1024
+#define NUMA_ALLOC_MAX_VECTORS 64
+
+/* Number of pages checked with move_pages per vector, evenly spread */
+#define NUMA_ALLOC_VERIFIED_PAGES 1024
+
+int allocationInit (void *ptr);
+void *allocationMalloc (size_t size, int no, int requested_alignment);
+void allocationFree (void *ptr);
+void allocationClose ();
+
+#endif
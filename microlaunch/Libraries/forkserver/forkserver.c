@@ -0,0 +1,145 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/*
+ * Fork server stub: preloaded in the target, it stops it right before main
+ * (once ld.so relocations and constructors are done) and forks a fresh copy
+ * of it each time microlaunch asks for one.
+ */
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ForkServer.h"
+
+typedef int (*main_fct) (int, char **, char **);
+typedef int (*libc_start_main_fct) (main_fct, int, char **, void (*) (void), void (*) (void), void (*) (void), void *);
+
+static main_fct real_main = NULL;
+
+static int forkserver_read (int fd, int *value)
+{
+	ssize_t size;
+	
+	do
+	{
+		size = read (fd, value, sizeof (*value));
+	} while (size == -1 && errno == EINTR);
+	
+	return size == sizeof (*value);
+}
+
+static int forkserver_write (int fd, int value)
+{
+	ssize_t size;
+	
+	do
+	{
+		size = write (fd, &value, sizeof (value));
+	} while (size == -1 && errno == EINTR);
+	
+	return size == sizeof (value);
+}
+
+static int forkserver_main (int argc, char **argv, char **envp)
+{
+	char *ctlEnv = getenv (FORKSERVER_ENV_CTL);
+	char *statusEnv = getenv (FORKSERVER_ENV_STATUS);
+	int ctl, status, command, childStatus;
+	struct rusage usage;
+	pid_t pid;
+	
+	/* Not launched by microlaunch (or a program launched by the target): nothing to do */
+	if (ctlEnv == NULL || statusEnv == NULL)
+	{
+		return real_main (argc, argv, envp);
+	}
+	
+	ctl = atoi (ctlEnv);
+	status = atoi (statusEnv);
+	
+	/* The target's own children mustn't become fork servers */
+	unsetenv (FORKSERVER_ENV_CTL);
+	unsetenv (FORKSERVER_ENV_STATUS);
+	
+	/* Tell microlaunch we are ready */
+	if (!forkserver_write (status, getpid ()))
+	{
+		_exit (EXIT_FAILURE);
+	}
+	
+	while (forkserver_read (ctl, &command) && command == FORKSERVER_RUN)
+	{
+		pid = fork ();
+		
+		if (pid == -1)
+		{
+			perror ("forkserver: fork");
+			_exit (EXIT_FAILURE);
+		}
+		
+		/* The copy runs the target as if nothing happened */
+		if (pid == 0)
+		{
+			close (ctl);
+			close (status);
+			return real_main (argc, argv, envp);
+		}
+		
+		if (!forkserver_write (status, pid))
+		{
+			_exit (EXIT_FAILURE);
+		}
+		
+		if (wait4 (pid, &childStatus, 0, &usage) == -1)
+		{
+			perror ("forkserver: wait4");
+			_exit (EXIT_FAILURE);
+		}
+		
+		/* The resource usage follows the exit status */
+		if (!forkserver_write (status, childStatus) || write (status, &usage, sizeof (usage)) != sizeof (usage))
+		{
+			_exit (EXIT_FAILURE);
+		}
+	}
+	
+	/* The target's atexit handlers belong to the copies */
+	_exit (EXIT_SUCCESS);
+}
+
+int __libc_start_main (main_fct main, int argc, char **argv, void (*init) (void), void (*fini) (void), void (*rtld_fini) (void), void *stack_end)
+{
+	libc_start_main_fct real_libc_start_main = dlsym (RTLD_NEXT, "__libc_start_main");
+	
+	if (real_libc_start_main == NULL)
+	{
+		fprintf (stderr, "forkserver: cannot find __libc_start_main\n");
+		_exit (EXIT_FAILURE);
+	}
+	
+	real_main = main;
+	return real_libc_start_main (forkserver_main, argc, argv, init, fini, rtld_fini, stack_end);
+}
@@ -0,0 +1,265 @@
+/*
+   Copyright (C) 2012 Exascale Research Center
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include "PerfEvents.h"
+#include "perfcounters.h"
+
+/* Layout of a PERF_FORMAT_GROUP read with both times enabled */
+#define READ_NB 0
+#define READ_ENABLED 1
+#define READ_RUNNING 2
+#define READ_VALUES 3
+
+/**
+ * @brief Tells the core to measure the overhead of this library
+ */
+unsigned int IS_OVERHEAD_RELEVANT = 1;
+
+/**
+ * @brief Data of the library, returned by evaluationInit
+ */
+typedef struct sPerfCounters
+{
+	char *spec;				/**< @brief Copy of the event list, the names point inside it */
+	unsigned nbCounters;	/**< @brief Number of counters */
+	unsigned nbGroups;		/**< @brief Number of counter groups */
+	char **names;			/**< @brief Name of each counter */
+	int *leaders;			/**< @brief File descriptor of each group leader */
+	unsigned *groupSizes;	/**< @brief Number of counters in each group */
+	uint64_t *buffer;		/**< @brief Group read buffer */
+	uint64_t *startValues;	/**< @brief Raw counter values at start */
+	uint64_t *startEnabled;	/**< @brief Time enabled of each group at start */
+	uint64_t *startRunning;	/**< @brief Time running of each group at start */
+	double *values;			/**< @brief Scaled counter deltas of the last start/stop window */
+}SPerfCounters;
+
+static inline void perfcounters_readGroup (SPerfCounters *pc, unsigned group)
+{
+	size_t size = (READ_VALUES + pc->groupSizes[group]) * sizeof (*pc->buffer);
+	
+	if (read (pc->leaders[group], pc->buffer, size) != (ssize_t) size)
+	{
+		perror ("perfcounters: error while reading counter group");
+		abort ();
+	}
+}
+
+void *evaluationInit (void)
+{
+	SPerfCounters *pc;
+	char *env = getenv (PERFCOUNTERS_ENV);
+	char **groups;
+	unsigned g, e, maxGroupSize = 0, idX = 0;
+	
+	pc = malloc (sizeof (*pc));
+	assert (pc != NULL);
+	memset (pc, 0, sizeof (*pc));
+	
+	pc->spec = strdup ((env != NULL) ? env : PERFCOUNTERS_DEFAULT_EVENTS);
+	assert (pc->spec != NULL);
+	
+	/* A name cannot be shorter than one character plus its separator */
+	groups = malloc ((strlen (pc->spec) / 2 + 1) * sizeof (*groups));
+	pc->names = malloc ((strlen (pc->spec) / 2 + 1) * sizeof (*pc->names));
+	assert (groups != NULL && pc->names != NULL);
+	
+	pc->nbGroups = PerfEvents_splitList (pc->spec, ';', groups, strlen (pc->spec) / 2 + 1);
+	if (pc->nbGroups == 0)
+	{
+		fprintf (stderr, "perfcounters: no event defined in %s\n", PERFCOUNTERS_ENV);
+		exit (EXIT_FAILURE);
+	}
+	
+	pc->leaders = malloc (pc->nbGroups * sizeof (*pc->leaders));
+	pc->groupSizes = malloc (pc->nbGroups * sizeof (*pc->groupSizes));
+	pc->startEnabled = malloc (pc->nbGroups * sizeof (*pc->startEnabled));
+	pc->startRunning = malloc (pc->nbGroups * sizeof (*pc->startRunning));
+	assert (pc->leaders != NULL && pc->groupSizes != NULL);
+	assert (pc->startEnabled != NULL && pc->startRunning != NULL);
+	
+	/* Split each group into its events */
+	for (g = 0; g < pc->nbGroups; g++)
+	{
+		pc->groupSizes[g] = PerfEvents_splitList (groups[g], ',', pc->names + pc->nbCounters, strlen (groups[g]) / 2 + 1);
+		pc->nbCounters += pc->groupSizes[g];
+		
+		if (pc->groupSizes[g] > maxGroupSize)
+		{
+			maxGroupSize = pc->groupSizes[g];
+		}
+	}
+	free (groups), groups = NULL;
+	
+	pc->buffer = malloc ((READ_VALUES + maxGroupSize) * sizeof (*pc->buffer));
+	pc->startValues = malloc (pc->nbCounters * sizeof (*pc->startValues));
+	pc->values = malloc (pc->nbCounters * sizeof (*pc->values));
+	assert (pc->buffer != NULL && pc->startValues != NULL && pc->values != NULL);
+	memset (pc->values, 0, pc->nbCounters * sizeof (*pc->values));
+	
+	/* Open the counters: the first event of each group is its leader */
+	for (g = 0; g < pc->nbGroups; g++)
+	{
+		pc->leaders[g] = -1;
+		
+		for (e = 0; e < pc->groupSizes[g]; e++, idX++)
+		{
+			struct perf_event_attr attr;
+			int fd;
+			
+			if (PerfEvents_parseEvent (pc->names[idX], &attr) == -1)
+			{
+				fprintf (stderr, "perfcounters: unknown event \"%s\"\n", pc->names[idX]);
+				exit (EXIT_FAILURE);
+			}
+			
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			attr.disabled = (e == 0);
+			
+			fd = PerfEvents_open (&attr, 0, -1, pc->leaders[g], 0);
+			if (fd == -1)
+			{
+				fprintf (stderr, "perfcounters: cannot open event \"%s\" : ", pc->names[idX]);
+				perror ("");
+				exit (EXIT_FAILURE);
+			}
+			
+			if (e == 0)
+			{
+				pc->leaders[g] = fd;
+			}
+		}
+		
+		ioctl (pc->leaders[g], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl (pc->leaders[g], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+	
+	return pc;
+}
+
+int evaluationClose (void *data)
+{
+	SPerfCounters *pc = data;
+	unsigned g;
+	
+	if (pc == NULL)
+	{
+		return EXIT_SUCCESS;
+	}
+	
+	/* Closing the leader releases the whole group */
+	for (g = 0; g < pc->nbGroups; g++)
+	{
+		ioctl (pc->leaders[g], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		close (pc->leaders[g]);
+	}
+	
+	free (pc->values), pc->values = NULL;
+	free (pc->startValues), pc->startValues = NULL;
+	free (pc->buffer), pc->buffer = NULL;
+	free (pc->startRunning), pc->startRunning = NULL;
+	free (pc->startEnabled), pc->startEnabled = NULL;
+	free (pc->groupSizes), pc->groupSizes = NULL;
+	free (pc->leaders), pc->leaders = NULL;
+	free (pc->names), pc->names = NULL;
+	free (pc->spec), pc->spec = NULL;
+	free (pc), pc = NULL;
+	
+	return EXIT_SUCCESS;
+}
+
+double evaluationStart (void *data)
+{
+	SPerfCounters *pc = data;
+	unsigned g, e, idX = 0;
+	
+	for (g = 0; g < pc->nbGroups; g++)
+	{
+		perfcounters_readGroup (pc, g);
+		
+		pc->startEnabled[g] = pc->buffer[READ_ENABLED];
+		pc->startRunning[g] = pc->buffer[READ_RUNNING];
+		for (e = 0; e < pc->groupSizes[g]; e++, idX++)
+		{
+			pc->startValues[idX] = pc->buffer[READ_VALUES + e];
+		}
+	}
+	
+	return 0.;
+}
+
+double evaluationStop (void *data)
+{
+	SPerfCounters *pc = data;
+	unsigned g, e, idX = pc->nbCounters;
+	
+	/* Groups are read in the reverse order to keep the windows nested */
+	for (g = pc->nbGroups; g-- > 0; )
+	{
+		double scale = 1.;
+		uint64_t enabled, running;
+		
+		perfcounters_readGroup (pc, g);
+		
+		/* The group was multiplexed with other ones: extrapolate its values */
+		enabled = pc->buffer[READ_ENABLED] - pc->startEnabled[g];
+		running = pc->buffer[READ_RUNNING] - pc->startRunning[g];
+		if (running != 0 && running != enabled)
+		{
+			scale = (double) enabled / running;
+		}
+		
+		idX -= pc->groupSizes[g];
+		for (e = 0; e < pc->groupSizes[g]; e++)
+		{
+			pc->values[idX + e] = (pc->buffer[READ_VALUES + e] - pc->startValues[idX + e]) * scale;
+		}
+	}
+	
+	return pc->values[0];
+}
+
+unsigned evaluationGetNbCounters (void *data)
+{
+	SPerfCounters *pc = data;
+	
+	return (pc == NULL) ? 0 : pc->nbCounters;
+}
+
+const char *evaluationGetCounterName (void *data, unsigned idX)
+{
+	SPerfCounters *pc = data;
+	
+	assert (pc != NULL && idX < pc->nbCounters);
+	return pc->names[idX];
+}
+
+double evaluationGetCounterValue (void *data, unsigned idX)
+{
+	SPerfCounters *pc = data;
+	
+	assert (pc != NULL && idX < pc->nbCounters);
+	return pc->values[idX];
+}
@@ -0,0 +1,44 @@
+/*
+   Copyright (C) 2012 Exascale Research Center
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef H_PERFCOUNTERS
+#define H_PERFCOUNTERS
+
+/*
+ * Hardware counter evaluation library based on perf_event_open.
+ *
+ * The counters are read from the ML_PERF_EVENTS environment variable: groups are
+ * separated by ';' and the events of a group by ',', for instance
+ * "cycles,instructions;LLC-loads,LLC-load-misses". Each group is scheduled on the
+ * PMU as a whole and read with a single read () call, each counter being reported
+ * in its own CSV column. The value returned by the start/stop pair is the first counter.
+ */
+#define PERFCOUNTERS_ENV "ML_PERF_EVENTS"
+#define PERFCOUNTERS_DEFAULT_EVENTS "cycles,instructions;LLC-loads,LLC-load-misses"
+
+extern void *evaluationInit (void);
+extern int evaluationClose (void *data);
+
+extern double evaluationStart (void *data);
+extern double evaluationStop (void *data);
+
+extern unsigned evaluationGetNbCounters (void *data);
+extern const char *evaluationGetCounterName (void *data, unsigned idX);
+extern double evaluationGetCounterValue (void *data, unsigned idX);
+
+#endif
@@ -0,0 +1,314 @@
+/*
+   Copyright (C) 2012 Exascale Research Center
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+
+#include "PerfEvents.h"
+#include "rdpmc.h"
+
+#define barrier() asm volatile ("" ::: "memory")
+
+/**
+ * @brief The calibrated read cost replaces the overhead run
+ */
+unsigned int IS_OVERHEAD_RELEVANT = 0;
+
+/**
+ * @brief Data of the library, returned by evaluationInit
+ */
+typedef struct sRdpmc
+{
+	char *spec;				/**< @brief Copy of the event list, the names point inside it */
+	unsigned nbCounters;	/**< @brief Number of counters */
+	char **names;			/**< @brief Name of each counter */
+	int *fds;				/**< @brief File descriptor of each counter */
+	struct perf_event_mmap_page **pages;	/**< @brief Control page of each counter */
+	int useRdpmc;			/**< @brief Whether every counter can be read with rdpmc */
+	uint64_t *startValues;	/**< @brief Counter values at start */
+	double *values;			/**< @brief Counter deltas of the last start/stop window */
+	double *readCosts;		/**< @brief Calibrated cost of an empty start/stop window */
+}SRdpmc;
+
+static inline uint64_t rdpmc_instruction (uint32_t counter)
+{
+	uint32_t low, high;
+	
+	asm volatile ("rdpmc" : "=a" (low), "=d" (high) : "c" (counter));
+	return ((uint64_t) high << 32) | low;
+}
+
+/**
+ * @brief Reads a counter from user space, following the seqlock protocol of the perf control page
+ */
+static inline uint64_t rdpmc_readCounter (struct perf_event_mmap_page *pc)
+{
+	uint32_t seq, idx;
+	uint64_t count;
+	
+	do
+	{
+		seq = pc->lock;
+		barrier ();
+		
+		idx = pc->index;
+		count = pc->offset;
+		
+		/* index is 0 when the counter is not currently on the PMU, offset then holds the count */
+		if (idx != 0)
+		{
+			int64_t pmc = rdpmc_instruction (idx - 1);
+			
+			/* Sign extend the value to 64 bits */
+			pmc <<= 64 - pc->pmc_width;
+			pmc >>= 64 - pc->pmc_width;
+			count += pmc;
+		}
+		
+		barrier ();
+	} while (pc->lock != seq);
+	
+	return count;
+}
+
+static inline uint64_t rdpmc_read (SRdpmc *rd, unsigned idX)
+{
+	uint64_t count;
+	
+	if (rd->useRdpmc)
+	{
+		return rdpmc_readCounter (rd->pages[idX]);
+	}
+	
+	if (read (rd->fds[idX], &count, sizeof (count)) != sizeof (count))
+	{
+		perror ("rdpmc: error while reading counter");
+		abort ();
+	}
+	return count;
+}
+
+static int rdpmc_compareDouble (const void *a, const void *b)
+{
+	double x = *(const double *) a, y = *(const double *) b;
+	
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Measures the median value of an empty start/stop window for each counter
+ */
+static void rdpmc_calibrate (SRdpmc *rd)
+{
+	double *samples;
+	unsigned c, i;
+	
+	samples = malloc (rd->nbCounters * RDPMC_CALIBRATION_RUNS * sizeof (*samples));
+	assert (samples != NULL);
+	
+	for (i = 0; i < RDPMC_CALIBRATION_RUNS; i++)
+	{
+		evaluationStart (rd);
+		evaluationStop (rd);
+		
+		for (c = 0; c < rd->nbCounters; c++)
+		{
+			samples[c * RDPMC_CALIBRATION_RUNS + i] = rd->values[c];
+		}
+	}
+	
+	for (c = 0; c < rd->nbCounters; c++)
+	{
+		qsort (samples + c * RDPMC_CALIBRATION_RUNS, RDPMC_CALIBRATION_RUNS, sizeof (*samples), rdpmc_compareDouble);
+		rd->readCosts[c] = samples[c * RDPMC_CALIBRATION_RUNS + RDPMC_CALIBRATION_RUNS / 2];
+	}
+	
+	free (samples), samples = NULL;
+}
+
+void *evaluationInit (void)
+{
+	SRdpmc *rd;
+	char *env = getenv (RDPMC_ENV);
+	long pageSize = sysconf (_SC_PAGESIZE);
+	unsigned c;
+	
+	rd = malloc (sizeof (*rd));
+	assert (rd != NULL);
+	memset (rd, 0, sizeof (*rd));
+	
+	rd->spec = strdup ((env != NULL) ? env : RDPMC_DEFAULT_EVENTS);
+	assert (rd->spec != NULL);
+	
+	/* A name cannot be shorter than one character plus its separator */
+	rd->names = malloc ((strlen (rd->spec) / 2 + 1) * sizeof (*rd->names));
+	assert (rd->names != NULL);
+	
+	rd->nbCounters = PerfEvents_splitList (rd->spec, ',', rd->names, strlen (rd->spec) / 2 + 1);
+	if (rd->nbCounters == 0)
+	{
+		fprintf (stderr, "rdpmc: no event defined in %s\n", RDPMC_ENV);
+		exit (EXIT_FAILURE);
+	}
+	
+	rd->fds = malloc (rd->nbCounters * sizeof (*rd->fds));
+	rd->pages = malloc (rd->nbCounters * sizeof (*rd->pages));
+	rd->startValues = malloc (rd->nbCounters * sizeof (*rd->startValues));
+	rd->values = malloc (rd->nbCounters * sizeof (*rd->values));
+	rd->readCosts = malloc (rd->nbCounters * sizeof (*rd->readCosts));
+	assert (rd->fds != NULL && rd->pages != NULL && rd->startValues != NULL);
+	assert (rd->values != NULL && rd->readCosts != NULL);
+	memset (rd->values, 0, rd->nbCounters * sizeof (*rd->values));
+	
+	rd->useRdpmc = 1;
+	for (c = 0; c < rd->nbCounters; c++)
+	{
+		struct perf_event_attr attr;
+		
+		if (PerfEvents_parseEvent (rd->names[c], &attr) == -1)
+		{
+			fprintf (stderr, "rdpmc: unknown event \"%s\"\n", rd->names[c]);
+			exit (EXIT_FAILURE);
+		}
+		
+		/* Counters have to stay on the PMU to be read with rdpmc */
+		attr.pinned = 1;
+		
+		rd->fds[c] = PerfEvents_open (&attr, 0, -1, -1, 0);
+		if (rd->fds[c] == -1)
+		{
+			fprintf (stderr, "rdpmc: cannot open event \"%s\" : ", rd->names[c]);
+			perror ("");
+			exit (EXIT_FAILURE);
+		}
+		
+		rd->pages[c] = mmap (NULL, pageSize, PROT_READ, MAP_SHARED, rd->fds[c], 0);
+		if (rd->pages[c] == MAP_FAILED)
+		{
+			perror ("rdpmc: cannot map the counter control page");
+			exit (EXIT_FAILURE);
+		}
+		
+		if (!rd->pages[c]->cap_user_rdpmc)
+		{
+			rd->useRdpmc = 0;
+		}
+	}
+	
+	if (!rd->useRdpmc)
+	{
+		fprintf (stderr, "rdpmc: user space rdpmc is not available for every counter, falling back to read ()\n");
+	}
+	
+	rdpmc_calibrate (rd);
+	
+	return rd;
+}
+
+int evaluationClose (void *data)
+{
+	SRdpmc *rd = data;
+	long pageSize = sysconf (_SC_PAGESIZE);
+	unsigned c;
+	
+	if (rd == NULL)
+	{
+		return EXIT_SUCCESS;
+	}
+	
+	for (c = 0; c < rd->nbCounters; c++)
+	{
+		munmap (rd->pages[c], pageSize);
+		close (rd->fds[c]);
+	}
+	
+	free (rd->readCosts), rd->readCosts = NULL;
+	free (rd->values), rd->values = NULL;
+	free (rd->startValues), rd->startValues = NULL;
+	free (rd->pages), rd->pages = NULL;
+	free (rd->fds), rd->fds = NULL;
+	free (rd->names), rd->names = NULL;
+	free (rd->spec), rd->spec = NULL;
+	free (rd), rd = NULL;
+	
+	return EXIT_SUCCESS;
+}
+
+double evaluationStart (void *data)
+{
+	SRdpmc *rd = data;
+	unsigned c;
+	
+	for (c = 0; c < rd->nbCounters; c++)
+	{
+		rd->startValues[c] = rdpmc_read (rd, c);
+	}
+	
+	return 0.;
+}
+
+double evaluationStop (void *data)
+{
+	SRdpmc *rd = data;
+	unsigned c;
+	
+	/* Counters are read in the reverse order to keep the windows nested */
+	for (c = rd->nbCounters; c-- > 0; )
+	{
+		rd->values[c] = (double) (rdpmc_read (rd, c) - rd->startValues[c]);
+	}
+	
+	return rd->values[0];
+}
+
+unsigned evaluationGetNbCounters (void *data)
+{
+	SRdpmc *rd = data;
+	
+	return (rd == NULL) ? 0 : rd->nbCounters;
+}
+
+const char *evaluationGetCounterName (void *data, unsigned idX)
+{
+	SRdpmc *rd = data;
+	
+	assert (rd != NULL && idX < rd->nbCounters);
+	return rd->names[idX];
+}
+
+double evaluationGetCounterValue (void *data, unsigned idX)
+{
+	SRdpmc *rd = data;
+	
+	assert (rd != NULL && idX < rd->nbCounters);
+	return rd->values[idX];
+}
+
+double evaluationGetReadCost (void *data, unsigned idX)
+{
+	SRdpmc *rd = data;
+	
+	assert (rd != NULL && idX < rd->nbCounters);
+	return rd->readCosts[idX];
+}
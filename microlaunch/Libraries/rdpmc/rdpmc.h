@@ -0,0 +1,49 @@
+/*
+   Copyright (C) 2012 Exascale Research Center
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef H_RDPMC
+#define H_RDPMC
+
+/*
+ * Self-monitoring evaluation library: the counters listed in ML_RDPMC_EVENTS
+ * (separated by ',') are opened with perf_event_open, their control page is
+ * mmapped and they are read from user space with rdpmc, following the perf
+ * seqlock protocol. No system call is made by evaluationStart/evaluationStop.
+ *
+ * The cost of an empty start/stop window is calibrated at init for each counter
+ * and exported through evaluationGetReadCost: Microlaunch subtracts it instead
+ * of the overhead run average.
+ *
+ * When the kernel does not allow user space rdpmc, the library falls back to read ().
+ */
+#define RDPMC_ENV "ML_RDPMC_EVENTS"
+#define RDPMC_DEFAULT_EVENTS "cycles,instructions"
+#define RDPMC_CALIBRATION_RUNS 1024
+
+extern void *evaluationInit (void);
+extern int evaluationClose (void *data);
+
+extern double evaluationStart (void *data);
+extern double evaluationStop (void *data);
+
+extern unsigned evaluationGetNbCounters (void *data);
+extern const char *evaluationGetCounterName (void *data, unsigned idX);
+extern double evaluationGetCounterValue (void *data, unsigned idX);
+extern double evaluationGetReadCost (void *data, unsigned idX);
+
+#endif
@@ -0,0 +1,211 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/*
+ * Region of interest library: preloaded in the target, it loads the evaluation
+ * libraries given by microlaunch and drives them around the ml_roi_begin/ml_roi_end
+ * calls of the target. The values go back to microlaunch through a shared channel.
+ */
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "Roi.h"
+
+typedef void *(*evaluationInitFct) (void);
+typedef double (*evaluationFct) (void *);
+typedef unsigned (*evaluationCounterNbFct) (void *);
+typedef double (*evaluationCounterValueFct) (void *, unsigned);
+
+/**
+ * @brief An evaluation library loaded in the target
+ */
+typedef struct sRoiEvalLib
+{
+	void *data;								/**< @brief Result of evaluationInit */
+	evaluationFct start;					/**< @brief evaluationStart */
+	evaluationFct stop;						/**< @brief evaluationStop */
+	evaluationCounterValueFct counterValue;	/**< @brief evaluationGetCounterValue (can be NULL) */
+	unsigned nbCounters;					/**< @brief Number of counters */
+	double initialValue;					/**< @brief Result of the start call */
+} SRoiEvalLib;
+
+static SRoiChannel *roi_channel = NULL;
+static SRoiEvalLib roi_libs[ROI_MAX_EVALLIBS];
+static unsigned roi_nbLibs = 0;
+static unsigned roi_depth = 0;
+/* The initialization belongs to the process measuring: a fork server or a forking target inherits it */
+static pid_t roi_owner = 0;
+
+static void roi_loadLibrary (const char *name)
+{
+	SRoiEvalLib *lib = &roi_libs[roi_nbLibs];
+	evaluationInitFct init;
+	evaluationCounterNbFct nbCounters;
+	void *dl = dlopen (name, RTLD_NOW);
+	
+	if (dl == NULL)
+	{
+		fprintf (stderr, "roi: %s\n", dlerror ());
+		_exit (EXIT_FAILURE);
+	}
+	
+	memset (lib, 0, sizeof (*lib));
+	init = (evaluationInitFct) dlsym (dl, "evaluationInit");
+	lib->start = (evaluationFct) dlsym (dl, "evaluationStart");
+	lib->stop = (evaluationFct) dlsym (dl, "evaluationStop");
+	nbCounters = (evaluationCounterNbFct) dlsym (dl, "evaluationGetNbCounters");
+	lib->counterValue = (evaluationCounterValueFct) dlsym (dl, "evaluationGetCounterValue");
+	
+	if (init != NULL)
+	{
+		lib->data = init ();
+	}
+	
+	if (nbCounters != NULL && lib->counterValue != NULL)
+	{
+		lib->nbCounters = nbCounters (lib->data);
+		if (lib->nbCounters > ROI_MAX_COUNTERS)
+		{
+			lib->nbCounters = ROI_MAX_COUNTERS;
+		}
+	}
+	
+	roi_channel->nbCounters[roi_nbLibs] = lib->nbCounters;
+	roi_nbLibs++;
+}
+
+/**
+ * @brief Maps the channel and loads the evaluation libraries, outside of any region
+ * @return whether or not the target is launched by microlaunch in ROI mode
+ */
+static int roi_init (void)
+{
+	char *fdEnv, *libsEnv, *libs, *name, *save;
+	void *map;
+	
+	if (roi_owner == getpid ())
+	{
+		return roi_channel != NULL;
+	}
+	roi_owner = getpid ();
+	roi_channel = NULL;
+	roi_nbLibs = 0;
+	roi_depth = 0;
+	
+	fdEnv = getenv (ROI_ENV_FD);
+	libsEnv = getenv (ROI_ENV_EVALLIBS);
+	if (fdEnv == NULL || libsEnv == NULL)
+	{
+		return 0;
+	}
+	
+	map = mmap (NULL, sizeof (*roi_channel), PROT_READ | PROT_WRITE, MAP_SHARED, atoi (fdEnv), 0);
+	if (map == MAP_FAILED)
+	{
+		perror ("roi: channel mapping");
+		return 0;
+	}
+	roi_channel = map;
+	
+	libs = strdup (libsEnv);
+	if (libs == NULL)
+	{
+		_exit (EXIT_FAILURE);
+	}
+	
+	for (name = strtok_r (libs, ":", &save); name != NULL && roi_nbLibs < ROI_MAX_EVALLIBS; name = strtok_r (NULL, ":", &save))
+	{
+		roi_loadLibrary (name);
+	}
+	roi_channel->nbEvalLibs = roi_nbLibs;
+	
+	free (libs), libs = NULL;
+	return 1;
+}
+
+void ml_roi_begin (void)
+{
+	unsigned i;
+	
+	if (!roi_init () || roi_depth++ > 0)
+	{
+		return;
+	}
+	
+	for (i = 0; i < roi_nbLibs; i++)
+	{
+		if (roi_libs[i].start != NULL)
+		{
+			roi_libs[i].initialValue = roi_libs[i].start (roi_libs[i].data);
+		}
+	}
+}
+
+void ml_roi_end (void)
+{
+	double finalValues[ROI_MAX_EVALLIBS];
+	unsigned i, c;
+	int idx;
+	
+	if (roi_channel == NULL || roi_owner != getpid () || roi_depth == 0 || --roi_depth > 0)
+	{
+		return;
+	}
+	
+	/* Same order as microlaunch: the first library started is the last stopped */
+	for (idx = roi_nbLibs - 1; idx >= 0; idx--)
+	{
+		finalValues[idx] = (roi_libs[idx].stop != NULL) ? roi_libs[idx].stop (roi_libs[idx].data) : 0.;
+	}
+	
+	for (i = 0; i < roi_nbLibs; i++)
+	{
+		roi_channel->values[i] += finalValues[i] - roi_libs[i].initialValue;
+		
+		for (c = 0; c < roi_libs[i].nbCounters; c++)
+		{
+			roi_channel->counters[i][c] += roi_libs[i].counterValue (roi_libs[i].data, c);
+		}
+	}
+	roi_channel->nbRegions++;
+}
+
+static void roi_emptyRegion (void)
+{
+	ml_roi_begin ();
+	ml_roi_end ();
+}
+
+/**
+ * @brief Overhead computation: microlaunch runs an empty program, which measures one empty region when it ends
+ * (at exit rather than here, so that the copies of a fork server measure it too)
+ */
+static void __attribute__ ((constructor)) roi_registerEmptyRegion (void)
+{
+	if (getenv (ROI_ENV_EMPTY) != NULL)
+	{
+		atexit (roi_emptyRegion);
+	}
+}
@@ -0,0 +1,37 @@
+/*
+   Copyright (C) 2012 Exascale Research Center
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/*
+ * Region of interest markers: a program measured with "microlaunch --execname <program> --roi"
+ * only gets the region between ml_roi_begin and ml_roi_end measured. The functions are provided
+ * by the roi.so library that microlaunch preloads; the weak declarations let the program run
+ * unchanged without microlaunch (use the ML_ROI_BEGIN/ML_ROI_END macros).
+ *
+ * The regions can be nested (only the outermost one is measured) and repeated (the values are added).
+ */
+
+#ifndef H_ML_ROI
+#define H_ML_ROI
+
+extern void ml_roi_begin (void) __attribute__ ((weak));
+extern void ml_roi_end (void) __attribute__ ((weak));
+
+#define ML_ROI_BEGIN() do { if (ml_roi_begin != 0) { ml_roi_begin (); } } while (0)
+#define ML_ROI_END() do { if (ml_roi_end != 0) { ml_roi_end (); } } while (0)
+
+#endif
@@ -23,46 +23,81 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <assert.h>
 #include <dlfcn.h>
 
+#include "Topology.h"
+
+/* Processors the threads are pinned on, in order */
+static int cpus[TOPOLOGY_MAX_CPUS];
+static int nbCpus = 0;
+static pthread_once_t cpusOnce = PTHREAD_ONCE_INIT;
+
+/* Next slot of the cpus table */
 static int core = 0;
 
-int getNbProcessorsAvailable ( void )
+static void pinthread_readCpus (void)
 {
-	FILE *output;
-	long nbProcessorsAvailable;
-	char buf[3]; /* Max processors = 999 */
-	char cmd[] = "grep \"CPU\" /proc/cpuinfo | wc -l";
-	int status;
-	char *ptr, *end;
+	char *env = getenv (TOPOLOGY_ENV_PIN_CPUS);
+	
+	if (env != NULL)
+	{
+		nbCpus = Topology_parseCpuOrder (env, cpus, TOPOLOGY_MAX_CPUS);
+		if (nbCpus <= 0)
+		{
+			fprintf (stderr, "pinthread: cannot parse %s=\"%s\"\n", TOPOLOGY_ENV_PIN_CPUS, env);
+		}
+	}
 	
-	output = popen (cmd, "r");
+	/* Without a policy, the processors allowed by the cpuset cgroup in identifier order */
+	if (nbCpus <= 0)
+	{
+		nbCpus = Topology_orderCpus (TOPOLOGY_PIN_LINEAR, 0, cpus, TOPOLOGY_MAX_CPUS);
+	}
 	
-	if (output == NULL)
+	if (nbCpus <= 0)
 	{
-		fprintf (stderr, "%s\n", cmd);
-		perror ("Error: Getting processors number : ");
-		exit (EXIT_FAILURE);
+		cpus[0] = 0;
+		nbCpus = 1;
+	}
+}
+
+/**
+ * @brief With a pinning policy, the main thread gets the first processor, like an OpenMP master thread.
+ * A main thread already pinned on one processor by Microlaunch (--cpupin, --nbprocess) stays there, and
+ * the other threads follow its place in the order, so that each benchmark process gets its own processors
+ */
+static void __attribute__ ((constructor)) pinthread_pinMainThread (void)
+{
+	cpu_set_t cpuset;
+	int i;
+	
+	if (getenv (TOPOLOGY_ENV_PIN_CPUS) == NULL)
+	{
+		return;
+	}
+	
+	pthread_once (&cpusOnce, pinthread_readCpus);
+	
+	if (sched_getaffinity (0, sizeof (cpuset), &cpuset) == 0 && CPU_COUNT (&cpuset) == 1)
+	{
+		for (i = 0; i < nbCpus; i++)
+		{
+			if (CPU_ISSET (cpus[i], &cpuset))
+			{
+				core = (i + 1) % nbCpus;
+				break;
+			}
+		}
+		return;
+	}
+	
+	CPU_ZERO(&cpuset);
+	CPU_SET(cpus[0], &cpuset);
+	if (sched_setaffinity (0, sizeof (cpuset), &cpuset) != 0)
+	{
+		fprintf (stderr, "Error: Cannot pin the main thread on core %d\n", cpus[0]);
+		perror ("");
 	}
 	
-    ptr = fgets (buf, sizeof (buf), output);
-    assert(ptr != NULL);
-    
-    status = pclose(output);
-    
-    if (status == -1)
-    {
-		fprintf (stderr, "%s\n", buf);
-    	perror ("Error: Closing processors number system call :");
-    	exit (EXIT_FAILURE);
-    }
-    
-    nbProcessorsAvailable = strtol (buf, &end, 10);
-    if (buf == end)
-    {
-    	fprintf (stderr, "Error: in getNbProcessorsAvailable strtol call failed.\n");
-    	exit (EXIT_FAILURE);
-    }
-    
-    return nbProcessorsAvailable;
+	core = 1 % nbCpus;
 }
 
 int pthread_create ( pthread_t *thread, const pthread_attr_t *attr, void *(*start_routine) (void *), void *arg ) {
@@ -70,23 +105,25 @@ int pthread_create ( pthread_t *thread, const pthread_attr_t *attr, void *(*star
 	int (*real_pthread_setaffinity_np) (pthread_t thread, size_t cpusetsize, const cpu_set_t *cpuset) = dlsym (RTLD_NEXT, "pthread_setaffinity_np");
 	int res;
 	cpu_set_t cpuset;
-	int nbProcessors = getNbProcessorsAvailable ();
+	int cpu;
 	
 	assert (real_pthread_create != NULL);
 	assert (real_pthread_setaffinity_np != NULL);
 	res = real_pthread_create (thread, attr, start_routine, arg);
 	
-	/* Pinning stuff */
+	/* Pinning stuff: round-robin over the processors of the policy (the topology is only read once) */
+	pthread_once (&cpusOnce, pinthread_readCpus);
+	cpu = cpus[core];
 	CPU_ZERO(&cpuset);
-	CPU_SET(core, &cpuset);
+	CPU_SET(cpu, &cpuset);
 	
 	if (real_pthread_setaffinity_np (*thread, sizeof (cpu_set_t), &cpuset) != 0) {
-		fprintf (stderr, "Error: Cannot pin thread %p on core %d\n", thread, core);
+		fprintf (stderr, "Error: Cannot pin thread %p on core %d\n", thread, cpu);
 		perror ("");
 	}
 	
 	core++;
-	core %= nbProcessors;
+	core %= nbCpus;
 	
 	return res;
 }
@@ -0,0 +1,164 @@
+/*
+   Copyright (C) 2012 Exascale Research Center
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <assert.h>
+#include <cpuid.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Rdtsc.h"
+#include "tsc.h"
+
+/**
+ * @brief Data of the library, returned by evaluationInit
+ */
+typedef struct sTsc
+{
+	double ticksPerNs;			/**< @brief Calibrated TSC frequency (in GHz) */
+	unsigned long start;		/**< @brief TSC value at start */
+	double values[2];			/**< @brief Cycles and nanoseconds of the last start/stop window */
+}STsc;
+
+static const char *tscCounterNames[] = {"cycles", "ns"};
+
+static inline unsigned long long tsc_getNs (void)
+{
+	struct timespec ts;
+	
+	clock_gettime (CLOCK_MONOTONIC_RAW, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Checks the invariant TSC bit (CPUID.80000007H:EDX[8])
+ */
+static int tsc_isInvariant (void)
+{
+	unsigned int eax, ebx, ecx, edx;
+	
+	if (__get_cpuid (0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007)
+	{
+		return 0;
+	}
+	
+	__get_cpuid (0x80000007, &eax, &ebx, &ecx, &edx);
+	return (edx & (1 << 8)) != 0;
+}
+
+static int tsc_compareDouble (const void *a, const void *b)
+{
+	double x = *(const double *) a, y = *(const double *) b;
+	
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Calibrates the TSC frequency against CLOCK_MONOTONIC_RAW, keeping the median of several rounds
+ */
+static double tsc_calibrate (void)
+{
+	double rounds[TSC_CALIBRATION_ROUNDS];
+	unsigned long startTicks, endTicks;
+	unsigned long long startNs, endNs;
+	unsigned i;
+	
+	for (i = 0; i < TSC_CALIBRATION_ROUNDS; i++)
+	{
+		startNs = tsc_getNs ();
+		rdtscll_start (startTicks);
+		
+		do
+		{
+			endNs = tsc_getNs ();
+		} while (endNs - startNs < TSC_CALIBRATION_NS);
+		rdtscpll_stop (endTicks);
+		
+		rounds[i] = (double) (endTicks - startTicks) / (endNs - startNs);
+	}
+	
+	qsort (rounds, TSC_CALIBRATION_ROUNDS, sizeof (*rounds), tsc_compareDouble);
+	return rounds[TSC_CALIBRATION_ROUNDS / 2];
+}
+
+void *evaluationInit (void)
+{
+	STsc *tsc;
+	
+	tsc = malloc (sizeof (*tsc));
+	assert (tsc != NULL);
+	memset (tsc, 0, sizeof (*tsc));
+	
+	if (!tsc_isInvariant ())
+	{
+		fprintf (stderr, "tsc: Warning: this processor has no invariant TSC, the nanoseconds may not be reliable\n");
+	}
+	
+	tsc->ticksPerNs = tsc_calibrate ();
+	fprintf (stderr, "tsc: TSC frequency calibrated at %.6f GHz\n", tsc->ticksPerNs);
+	
+	return tsc;
+}
+
+int evaluationClose (void *data)
+{
+	free (data);
+	return EXIT_SUCCESS;
+}
+
+double evaluationStart (void *data)
+{
+	STsc *tsc = data;
+	
+	rdtscll_start (tsc->start);
+	return 0.;
+}
+
+double evaluationStop (void *data)
+{
+	STsc *tsc = data;
+	unsigned long stop;
+	
+	rdtscpll_stop (stop);
+	
+	tsc->values[0] = stop - tsc->start;
+	tsc->values[1] = tsc->values[0] / tsc->ticksPerNs;
+	return tsc->values[0];
+}
+
+unsigned evaluationGetNbCounters (void *data)
+{
+	(void) data;
+	return sizeof (tscCounterNames) / sizeof (*tscCounterNames);
+}
+
+const char *evaluationGetCounterName (void *data, unsigned idX)
+{
+	(void) data;
+	assert (idX < sizeof (tscCounterNames) / sizeof (*tscCounterNames));
+	return tscCounterNames[idX];
+}
+
+double evaluationGetCounterValue (void *data, unsigned idX)
+{
+	STsc *tsc = data;
+	
+	assert (tsc != NULL && idX < sizeof (tscCounterNames) / sizeof (*tscCounterNames));
+	return tsc->values[idX];
+}
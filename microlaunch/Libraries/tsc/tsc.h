@@ -0,0 +1,41 @@
+/*
+   Copyright (C) 2012 Exascale Research Center
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef H_TSC
+#define H_TSC
+
+/*
+ * Serialized TSC timer: lfence+rdtsc at start, rdtscp+lfence at stop.
+ * The TSC frequency is calibrated at init against CLOCK_MONOTONIC_RAW, so both
+ * the cycles and the nanoseconds are reported (one CSV column each).
+ * The nanoseconds are only meaningful on processors with an invariant TSC.
+ */
+#define TSC_CALIBRATION_ROUNDS 5
+#define TSC_CALIBRATION_NS 20000000
+
+extern void *evaluationInit (void);
+extern int evaluationClose (void *data);
+
+extern double evaluationStart (void *data);
+extern double evaluationStop (void *data);
+
+extern unsigned evaluationGetNbCounters (void *data);
+extern const char *evaluationGetCounterName (void *data, unsigned idX);
+extern double evaluationGetCounterValue (void *data, unsigned idX);
+
+#endif
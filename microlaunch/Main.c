@@ -37,9 +37,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <sys/types.h>
 #include <sys/wait.h>
 
+#include "Barrier.h"
 #include "BenchDescriptor.h"
 #include "Benchmark.h"
 #include "BenchmarkExec.h"
+#include "CompilePipeline.h"
 #include "Config.h"
 #include "Defines.h"
 #include "Description.h"
@@ -50,8 +52,71 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "Resume.h"
 #include "Signal.h"
 #include "SleepTight.h"
+#include "Sweep.h"
 #include "Toolkit.h"
 
+/**
+ * @brief Compiles every kernel of the list for the batch mode
+ * @param desc the program description
+ * @param pipeline the ahead-of-time compilation pipeline (can be NULL)
+ * @param nbKernels the number of kernels
+ * @param shouldDelete filled with whether or not each library is a temporary file
+ * @return the library of each kernel
+ */
+static char **compileKernels (SDescription *desc, SCompilePipeline *pipeline, unsigned nbKernels, int **shouldDelete)
+{
+	char **libraries = malloc (nbKernels * sizeof (*libraries));
+	unsigned kernelId;
+	
+	*shouldDelete = malloc (nbKernels * sizeof (**shouldDelete));
+	assert (libraries != NULL && *shouldDelete != NULL);
+	
+	for (kernelId = 0; kernelId < nbKernels; kernelId++)
+	{
+		Description_setKernelCurrentFileId (desc, kernelId);
+		
+		if (Description_getSourceType (desc) == LIBRARY_FILE)
+		{
+			libraries[kernelId] = strDuplicate (Description_getKernelFileName (desc), STRBUF_MAXLEN);
+			(*shouldDelete)[kernelId] = 0;
+			continue;
+		}
+		
+		CompilePipeline_wait (pipeline, kernelId);
+		compileInputFile (desc);
+		libraries[kernelId] = strDuplicate (Description_getDynamicLibraryName (desc), STRBUF_MAXLEN);
+		(*shouldDelete)[kernelId] = desc->dynlibDelete;
+	}
+	
+	/* The libraries are now owned by the batch */
+	Description_setDynamicLibraryName (desc, NULL, 0);
+	desc->dynlibDelete = 0;
+	
+	return libraries;
+}
+
+/**
+ * @brief Releases the libraries of the batch mode
+ * @param libraries the library of each kernel
+ * @param shouldDelete whether or not each library is a temporary file
+ * @param nbKernels the number of kernels
+ */
+static void releaseKernels (char **libraries, int *shouldDelete, unsigned nbKernels)
+{
+	unsigned kernelId;
+	
+	for (kernelId = 0; kernelId < nbKernels; kernelId++)
+	{
+		if (shouldDelete[kernelId] != 0)
+		{
+			remove (libraries[kernelId]);
+		}
+		free (libraries[kernelId]), libraries[kernelId] = NULL;
+	}
+	free (libraries), libraries = NULL;
+	free (shouldDelete), shouldDelete = NULL;
+}
+
 /**
  * @brief Main function
  * @param argc Number of arguments
@@ -67,11 +132,16 @@ main (int argc, char ** argv)
 	pid_t pid;
 	unsigned nbprocess;
 	SPipe *pipes;
+	pid_t *children;
+	SCompilePipeline *compilePipeline;
 	int res;
 	int isOpenMP = 0;
 	int iterationsDoneAlready = 0;
 	unsigned currentExecRepet;
 	unsigned execRepets, kernelId, nbKernels;
+	char **batchLibraries = NULL;
+	int *batchDelete = NULL;
+	unsigned nbBatchKernels = 0;
 	
 	printf("*************************************************************************************************\n");
 	printf("* |\\   /|   '    ____  ____   ____          ____                    ____           ____  ____\t*\n");
@@ -137,6 +207,20 @@ main (int argc, char ** argv)
 	pipes = malloc (sizeof (*pipes) * nbprocess);
 	assert (pipes != NULL);
 	memset (pipes, 0, sizeof (*pipes) * nbprocess);
+	children = malloc (sizeof (*children) * nbprocess);
+	assert (children != NULL);
+	
+	/* The shared barrier is inherited by every benchmark process (none in pipe mode) */
+	Description_setBarrier (desc, Barrier_create (Description_getBarrierMode (desc), nbprocess));
+	
+	/* In sweep mode, the benchmark processes share the queue of the points instead of synchronising */
+	if (Description_isSweepEnabled (desc))
+	{
+		Description_setSweep (desc, Sweep_create (nbprocess, Sweep_getNbPoints (desc)));
+	}
+	
+	/* The thread placement is inherited by the benchmark processes and the executable */
+	exportThreadPinning (desc);
 	
 	/* Allocate process pinning table only if we're not in OpenMP mode as this mode doesn't pin CPUs */
 	isOpenMP = Description_getOmpPath (desc) != NULL;
@@ -153,6 +237,9 @@ main (int argc, char ** argv)
 		}
 	}
 	
+	/* The next kernels are compiled outside the benchmark processors while the current one is measured */
+	compilePipeline = CompilePipeline_create (desc);
+	
 	/* Get the father aware of the number of experiments to be done by its children */
 	Description_setExperimentNumber (desc, getExperimentNumber (desc));
 	
@@ -166,14 +253,25 @@ main (int argc, char ** argv)
 		nbKernels = Description_getKernelFileNamesTabSize (desc);
 	}
 	
+	/* In batch mode, the kernels are compiled first and the benchmark processes are launched once for the whole list */
+	if (Description_isBatchEnabled (desc) && Description_getExecFileName (desc) == NULL)
+	{
+		nbBatchKernels = nbKernels;
+		batchLibraries = compileKernels (desc, compilePipeline, nbBatchKernels, &batchDelete);
+		nbKernels = 1;
+	}
+	
 	/* Multiple kernels handling */
 	for (kernelId = 0; kernelId < nbKernels; kernelId++)
 	{
-		if (Description_getExecFileName (desc) == NULL)
+		if (Description_getExecFileName (desc) == NULL && batchLibraries == NULL)
 		{
 			/* Setting the current kernel name to the current id we're running */
 			Description_setKernelCurrentFileId (desc, kernelId);
 			Log_output (-1, "Current Kernel Execution : %s\n", Description_getKernelFileName (desc));
+			
+			/* Wait for the kernel to be in the compilation cache, if it is compiled ahead */
+			CompilePipeline_wait (compilePipeline, kernelId);
 		}
 		
 		/* Re-init to last known currentExecRepet value if we're resuming */
@@ -201,7 +299,16 @@ main (int argc, char ** argv)
 			}
 		
 			/* Input file compilation */
-			compileInputFile (desc);
+			if (batchLibraries == NULL)
+			{
+				compileInputFile (desc);
+			}
+			
+			/* Every point is dealt again to the workers */
+			if (Description_getSweep (desc) != NULL)
+			{
+				Sweep_reset (Description_getSweep (desc), Sweep_getNbPoints (desc));
+			}
 		
 			/* Processes launch */
             fprintf (stderr, "ML: %d -> Creating %d\n", getpid (), nbprocess);
@@ -242,8 +349,8 @@ main (int argc, char ** argv)
 						Description_processEvalHandlerEnable (desc);
 					}
 
-					/* If we have allprocess-output argument, then every process compute its counters */
-					if (Description_isAllProcessOutputEnabled (desc))
+					/* If we have allprocess-output argument, then every process compute its counters, as every sweep worker does */
+					if (Description_isAllProcessOutputEnabled (desc) || Description_isSweepEnabled (desc))
 					{
 						Description_processEvalHandlerEnable (desc);
 					}
@@ -290,7 +397,14 @@ main (int argc, char ** argv)
 						case ASSEMBLY_FILE:
 						case OBJECT_FILE: /* KERNEL MODE */
 						{
-							status = Benchmark_Wrapper (desc, currentExecRepet);
+							if (batchLibraries != NULL)
+							{
+								status = Benchmark_Batch (desc, currentExecRepet, batchLibraries, nbBatchKernels);
+							}
+							else
+							{
+								status = Benchmark_Wrapper (desc, currentExecRepet);
+							}
 							if (status != EXIT_SUCCESS)
 							{
 								abort ();
@@ -314,6 +428,7 @@ main (int argc, char ** argv)
 						free(process_pinning), process_pinning = NULL;
 					}
 					free(pipes), pipes = NULL;
+					free(children), children = NULL;
 
 					int isPrintingProcess = Description_isPrintingProcess (desc);
 					//Destroy description
@@ -337,6 +452,8 @@ main (int argc, char ** argv)
 				{
 					/* Close non-used side of each pipe */
 					Pipe_closeFatherUnusedSide ( &pipes[i] );
+					children[i] = pid;
+					Barrier_setProcess (Description_getBarrier (desc), i, pid);
 				}
 			}
 	
@@ -351,9 +468,20 @@ main (int argc, char ** argv)
 
 			/* Setting up the father Barrier */
 			unsigned max = benchmarkIterationsNumber (desc, iterationsDoneAlready);
+			if (batchLibraries != NULL)
+			{
+				/* Only the first kernel of the batch can be resumed */
+				max += (nbBatchKernels - 1) * benchmarkIterationsNumber (desc, 0);
+			}
+			
+			/* The sweep workers never wait for each other */
+			if (Description_isSweepEnabled (desc))
+			{
+				max = 0;
+			}
 			for (i = 0 ; i < max ; i++)
 			{
-				barrierF (pipes, nbprocess);
+				barrierF (desc, pipes, nbprocess);
 			}
 
 			/* Close the rest of the pipes */
@@ -365,7 +493,8 @@ main (int argc, char ** argv)
 			/* Child processes wait */
 			for (i = 0 ; i < nbprocess ; i++)
 			{
-				waitpid (-1, &status, 0);
+				/* Only the benchmark processes: the compiler processes are children too */
+				waitpid (children[i], &status, 0);
 				res = WEXITSTATUS(status);
 				if(res != EXIT_SUCCESS)
 				{
@@ -379,6 +508,15 @@ main (int argc, char ** argv)
 					psignal (WTERMSIG (status), buf);
 				}
 			}
+			
+			/* The parts written by the sweep workers are merged in one output file */
+			if (Description_isSweepEnabled (desc) && Description_getPromptOutputCsv (desc))
+			{
+				if (Benchmark_mergeSweep (desc, currentExecRepet) == -1)
+				{
+					Log_output (-1, "Error: The sweep parts could not be merged, they are kept in %s\n", Description_getOutputPath (desc));
+				}
+			}
 			desc->temp_values.current_execute_repet++;
 			/*	Disabling resume in the innermost loop of the father process
 				because resuming has to be done just for the first iteration of each process loops */
@@ -386,11 +524,22 @@ main (int argc, char ** argv)
 		}
 	}
 	
+	CompilePipeline_destroy (compilePipeline), compilePipeline = NULL;
+	if (batchLibraries != NULL)
+	{
+		releaseKernels (batchLibraries, batchDelete, nbBatchKernels), batchLibraries = NULL, batchDelete = NULL;
+	}
+	
 	/* Job is done, let's create a file to tell the user so */
 	resumeSignalJobDone (desc);
 	
 	/* Free data */
 	free (pipes), pipes = NULL;
+	free (children), children = NULL;
+	Barrier_destroy (Description_getBarrier (desc));
+	Description_setBarrier (desc, NULL);
+	Sweep_destroy (Description_getSweep (desc));
+	Description_setSweep (desc, NULL);
 	if (!isOpenMP)
 	{
 		free (process_pinning), process_pinning = NULL;
@@ -0,0 +1,61 @@
+/*
+Copyright (C) 2011 Exascale Research Center
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/* Converts the binary result files written with --binary-output into the CSV microlaunch would have written */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Log.h"
+#include "ResultSink.h"
+
+int main (int argc, char **argv)
+{
+	FILE *csv;
+	int res;
+	
+	Log_setOutput (stderr);
+	
+	if (argc < 2 || argc > 3 || strcmp (argv[1], "--help") == 0)
+	{
+		fprintf (stderr, "Usage: %s <result file (%s)> [<CSV file>]\n\tThe CSV is written on the standard output if no file is given\n", argv[0], RESULTSINK_BINARY_EXTENSION);
+		return EXIT_FAILURE;
+	}
+	
+	csv = stdout;
+	if (argc == 3)
+	{
+		csv = fopen (argv[2], "w");
+		if (csv == NULL)
+		{
+			Log_output (-1, "Error: Cannot open file %s\n", argv[2]);
+			perror ("");
+			return EXIT_FAILURE;
+		}
+	}
+	
+	res = ResultSink_convert (argv[1], csv);
+	
+	if (fclose (csv) != 0)
+	{
+		res = -1;
+	}
+	
+	return (res == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}